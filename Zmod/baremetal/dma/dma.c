@@ -5,7 +5,7 @@
  * @date 15 Nov 2019
  * @brief File containing implementations of platform-specific methods for DMA devices.
  */
-#ifndef LINUX_APP
+#if !defined(LINUX_APP) && !defined(FAKE_APP)
 
 #include "xparameters.h"
 #include "xil_printf.h"
@@ -14,6 +14,9 @@
 #include "xstatus.h"
 
 #include "../../dma.h"
+#include "../../timer.h"
+#include "../../perf.h"
+#include "../../trace.h"
 #include "../intc/intc.h"
 
 extern XScuGic sIntc;
@@ -38,6 +41,8 @@ typedef struct _dmaEnv {
 	XAxiDma *xAxiDma; ///< a pointer to the XAxiDma driver instance data
 	uint32_t base_addr; ///< the physical address of the DMA device
 	uint8_t complete_flag; ///< whether the current DMA transfer is complete or not
+	uint64_t complete_time; ///< time the current DMA transfer completed (see fnGetTimeNs), 0 while running
+	uint32_t error_count; ///< number of DMA error interrupts, each followed by a reset of the DMA
 } DMAEnv;
 
 /**
@@ -132,6 +137,7 @@ void fnDMAInterruptHandler(void *Callback) {
 	// hardware to recover from the error, and return with no further
 	// processing.
 	if (IrqStatus & XAXIDMA_IRQ_ERROR_MASK) {
+		__atomic_fetch_add(&dmaEnv->error_count, 1, __ATOMIC_RELAXED);
 		XAxiDma_Reset(AxiDmaInst);
 		TimeOut = 100;
 		while (TimeOut) {
@@ -148,7 +154,10 @@ void fnDMAInterruptHandler(void *Callback) {
     Xil_DCacheFlush();
 
 	if ((IrqStatus & XAXIDMA_IRQ_IOC_MASK)) {
-		dmaEnv->complete_flag = 1;
+		// the time is published by the flag, a 64-bit store is not atomic on 32-bit ARM
+		__atomic_store_n(&dmaEnv->complete_time, fnGetTimeNs(), __ATOMIC_RELAXED);
+		__atomic_store_n(&dmaEnv->complete_flag, 1, __ATOMIC_RELEASE);
+		ZMOD_TRACE2(dma_complete, dmaEnv->base_addr, dmaEnv->direction);
 	}
 }
 
@@ -245,6 +254,9 @@ uint32_t fnInitDMA(uintptr_t dmaBaseAddr, enum dma_direction direction,
 	fnEnableInterrupts(&sIntc, &ivt[0], sizeof(ivt)/sizeof(ivt[0]));
 
 	dmaEnv->direction = direction;
+	dmaEnv->complete_flag = 0;
+	dmaEnv->complete_time = 0;
+	dmaEnv->error_count = 0;
 	if (dmaEnv->direction == DMA_DIRECTION_RX) {
 		// enable AXIDMA S2MM IOC interrupt
 		writeDMARegFld(dmaEnv->base_addr, AXIDMA_REGFLD_S2MM_DMACR_IOC_IRQ, 1);
@@ -290,7 +302,9 @@ int fnOneWayDMATransfer(uintptr_t addr, uint32_t *buf, size_t transfer_size){
 	if (!dmaEnv)
 		return -1;
 
-	dmaEnv->complete_flag = 0;
+	__atomic_store_n(&dmaEnv->complete_flag, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&dmaEnv->complete_time, 0, __ATOMIC_RELAXED);
+	ZMOD_PERF_BEGIN(perfStart);
 
 	// DMA Setup
 	if (dmaEnv->direction == DMA_DIRECTION_RX) {
@@ -317,6 +331,8 @@ int fnOneWayDMATransfer(uintptr_t addr, uint32_t *buf, size_t transfer_size){
 		writeDMAReg(dmaEnv->base_addr, AXIDMA_REG_ADDR_MM2S_SA_LENGTH, transfer_size);
 	}
 
+	ZMOD_PERF_END(ZMOD_PERF_DMA_START, perfStart);
+
 	return 0;
 }
 
@@ -332,7 +348,38 @@ uint8_t fnIsDMATransferComplete(uintptr_t addr) {
 	if (!dmaEnv)
 		return 0;
 
-	return dmaEnv->complete_flag;
+	return __atomic_load_n(&dmaEnv->complete_flag, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Get the time the DMA transfer previously started has completed, as captured
+ * by the DMA interrupt handler.
+ *
+ * @param addr the address of the DMAEnv instance returned by fnInitDMA
+ *
+ * @return the completion time in nanoseconds (see fnGetTimeNs), 0 if the transfer is still running
+ */
+uint64_t fnGetDMATransferCompleteTime(uintptr_t addr) {
+	DMAEnv *dmaEnv = (DMAEnv *)addr;
+	if (!dmaEnv)
+		return 0;
+
+	return __atomic_load_n(&dmaEnv->complete_time, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get the number of DMA errors since the DMA device was initialized.
+ *
+ * @param addr the address of the DMAEnv instance returned by fnInitDMA
+ *
+ * @return the number of error interrupts (the DMA is reset on each of them)
+ */
+uint32_t fnGetDMAErrorCount(uintptr_t addr) {
+	DMAEnv *dmaEnv = (DMAEnv *)addr;
+	if (!dmaEnv)
+		return 0;
+
+	return __atomic_load_n(&dmaEnv->error_count, __ATOMIC_RELAXED);
 }
 
 /**
@@ -377,4 +424,4 @@ void fnFreeBuffer(uintptr_t addr, void *buf, size_t size) {
 		free(buf);
 	}
 }
-#endif // LINUX_APP
+#endif // !LINUX_APP && !FAKE_APP
@@ -5,7 +5,7 @@
  * @brief Function declarations used for Flash transfer.
  */
 
-#ifndef LINUX_APP
+#if !defined(LINUX_APP) && !defined(FAKE_APP)
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -16,6 +16,9 @@
 #include "sleep.h"
 #include "xstatus.h"
 
+#include "../../perf.h"
+#include "../../trace.h"
+
 #define IIC_SCLK_RATE 		400000 ///< I2C clock rates
 #define FLASH_MAX_LENGTH	256 ///< Maximum flash transfer length
 
@@ -142,6 +145,7 @@ int fnReadFlash(uintptr_t addr, uint16_t data_addr, uint8_t *read_vals, size_t l
 	FlashEnv *flash_env = (FlashEnv *)addr;
 	if (!flash_env)
 		return XST_FAILURE;
+	ZMOD_PERF_BEGIN(perfStart);
 
 	fnFormatAddr(u8TxData, data_addr);
 
@@ -152,6 +156,8 @@ int fnReadFlash(uintptr_t addr, uint16_t data_addr, uint8_t *read_vals, size_t l
 	// Receive function form the flash
 	u8BytesSent = XIicPs_MasterRecvPolled(&XIicPS, (uint8_t *)read_vals, length, flash_env->slave_addr);
 	while (XIicPs_BusIsBusy(&XIicPS)) {}
+	ZMOD_PERF_END(ZMOD_PERF_FLASH_READ, perfStart);
+	ZMOD_TRACE4(flash_read, flash_env->slave_addr, data_addr, length, u8BytesSent);
 
 	if (u8BytesSent < 0)
 		return XST_FAILURE;
@@ -178,6 +184,7 @@ int fnWriteFlash(uintptr_t addr, uint16_t data_addr, uint8_t *write_vals, size_t
 	FlashEnv *flash_env = (FlashEnv *)addr;
 	if (!flash_env)
 		return XST_FAILURE;
+	ZMOD_PERF_BEGIN(perfStart);
 
 	fnFormatAddr(u8TxData, data_addr);
 
@@ -187,10 +194,12 @@ int fnWriteFlash(uintptr_t addr, uint16_t data_addr, uint8_t *write_vals, size_t
 	// Send the data to the flash
 	u8BytesSent = XIicPs_MasterSendPolled(&XIicPS, u8TxData, length + 2, flash_env->slave_addr);
 	while (XIicPs_BusIsBusy(&XIicPS)) {}
+	ZMOD_PERF_END(ZMOD_PERF_FLASH_WRITE, perfStart);
+	ZMOD_TRACE4(flash_write, flash_env->slave_addr, data_addr, length, u8BytesSent);
 
 	return (int)u8BytesSent;
 }
 
-#endif // LINUX_APP
+#endif // !LINUX_APP && !FAKE_APP
 
 
@@ -5,7 +5,7 @@
  * @brief File containing function for initialization of the interrupt system.
  */
 
-#ifndef LINUX_APP
+#if !defined(LINUX_APP) && !defined(FAKE_APP)
 #include "intc.h"
 #include "xparameters.h"
 
@@ -75,4 +75,4 @@ void fnEnableInterrupts(XScuGic *psIntc, const ivt_t *prgsIvt, unsigned int csIV
 		XScuGic_Enable(psIntc, prgsIvt[isIVector].id);
 	}
 }
-#endif // LINUX_APP
+#endif // !LINUX_APP && !FAKE_APP
@@ -0,0 +1,37 @@
+/**
+ * @file baremetal/mem/mem.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for the allocation of large processing buffers.
+ */
+
+#if !defined(LINUX_APP) && !defined(FAKE_APP)
+
+#include <stdlib.h>
+
+#include "../../mem.h"
+
+/**
+ * Allocate a large buffer, not used for DMA transfers. The MMU of the baremetal
+ * platform maps the DDR with 1MB sections, so the heap is used directly.
+ *
+ * @param size the size of the buffer, in bytes
+ *
+ * @return the pointer to the allocated buffer, NULL on failure
+ */
+void* fnAllocLargeBuffer(size_t size)
+{
+	return malloc(size);
+}
+
+/**
+ * Free a buffer allocated by fnAllocLargeBuffer.
+ *
+ * @param buf the address of the buffer
+ * @param size the size of the buffer, in bytes
+ */
+void fnFreeLargeBuffer(void *buf, size_t size)
+{
+	free(buf);
+}
+
+#endif // !LINUX_APP && !FAKE_APP
@@ -6,7 +6,7 @@
  * @brief File containing implementations of the register writing functions.
  */
 
-#ifndef LINUX_APP
+#if !defined(LINUX_APP) && !defined(FAKE_APP)
 
 #include <xil_io.h>
 #include "../../reg.h"
@@ -84,4 +84,4 @@ uint32_t fnReadReg(uintptr_t base_addr, uint8_t reg_addr)
 	return Xil_In32(base_addr + reg_addr);
 }
 
-#endif // LINUX_APP
+#endif // !LINUX_APP && !FAKE_APP
@@ -0,0 +1,29 @@
+/**
+ * @file baremetal/timer/timer.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for time stamping.
+ */
+
+#if !defined(LINUX_APP) && !defined(FAKE_APP)
+
+#include "xtime_l.h"
+
+#include "../../timer.h"
+
+/**
+ * Read the global timer of the processor.
+ *
+ * @return the value of the global timer, in nanoseconds
+ */
+uint64_t fnGetTimeNs()
+{
+	XTime t;
+
+	XTime_GetTime(&t);
+
+	// split the conversion to avoid the overflow of t * 10^9
+	return (t / COUNTS_PER_SECOND) * 1000000000ULL +
+			((t % COUNTS_PER_SECOND) * 1000000000ULL) / COUNTS_PER_SECOND;
+}
+
+#endif // !LINUX_APP && !FAKE_APP
@@ -24,6 +24,8 @@ uint32_t fnInitDMA(uintptr_t addr, enum dma_direction direction, int dmaInterrup
 void fnDestroyDMA(uintptr_t addr);
 int fnOneWayDMATransfer(uintptr_t addr, uint32_t *buf, size_t length);
 uint8_t fnIsDMATransferComplete(uintptr_t addr);
+uint64_t fnGetDMATransferCompleteTime(uintptr_t addr);
+uint32_t fnGetDMAErrorCount(uintptr_t addr);
 void* fnAllocBuffer(uintptr_t addr, size_t size);
 void fnFreeBuffer(uintptr_t addr, void *buf, size_t size);
 
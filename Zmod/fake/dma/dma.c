@@ -0,0 +1,200 @@
+/**
+ * @file fake/dma/dma.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for DMA devices of the fake platform.
+ */
+
+#ifdef FAKE_APP
+
+#include <stdlib.h>
+
+#include "../../dma.h"
+#include "../../timer.h"
+#include "../fake.h"
+
+/**
+ * Struct containing data specific to a fake DMA device.
+ */
+typedef struct _fake_dma_env {
+	bool used; ///< whether the entry is allocated
+	uintptr_t addr; ///< the address of the DMA device
+	enum dma_direction direction; ///< the direction of the DMA transfer
+	uint8_t complete_flag; ///< whether the current DMA transfer is complete or not
+	uint64_t complete_time; ///< time the current DMA transfer completes
+	uint32_t error_count; ///< number of DMA transfers that failed to start
+} FakeDMAEnv;
+
+static FakeDMAEnv fakeDMAs[FAKE_MAX_DEVICES]; ///< fake DMA devices, indexed by handle - 1
+static uint32_t fakeBytesPerUs = 0; ///< simulated DMA bandwidth, 0 to complete the transfers immediately
+
+/**
+ * Set the simulated bandwidth of the fake DMA devices.
+ *
+ * @param bytesPerUs the bandwidth in bytes per microsecond (MB/s), 0 to complete the transfers immediately
+ */
+void fnFakeSetDMABandwidth(uint32_t bytesPerUs)
+{
+	fakeBytesPerUs = bytesPerUs;
+}
+
+/**
+ * Get the fake DMA device of a handle.
+ *
+ * @param addr the handle returned by fnInitDMA
+ *
+ * @return the device, NULL for an invalid handle
+ */
+static FakeDMAEnv *fnGetFakeDMA(uintptr_t addr)
+{
+	if(addr < 1 || addr > FAKE_MAX_DEVICES || !fakeDMAs[addr - 1].used)
+	{
+		return NULL;
+	}
+	return &fakeDMAs[addr - 1];
+}
+
+/**
+ * Initialize a fake DMA device.
+ *
+ * @param addr the address of the DMA device
+ * @param direction the direction of the DMA transfer
+ * @param dmaInterrupt the interrupt number of the DMA device, unused
+ *
+ * @return the handle of the device, 0 on failure
+ */
+uint32_t fnInitDMA(uintptr_t addr, enum dma_direction direction, int)
+{
+	for(uint32_t i = 0; i < FAKE_MAX_DEVICES; i++)
+	{
+		if(!fakeDMAs[i].used)
+		{
+			fakeDMAs[i].used = true;
+			fakeDMAs[i].addr = addr;
+			fakeDMAs[i].direction = direction;
+			fakeDMAs[i].complete_flag = 0;
+			fakeDMAs[i].complete_time = 0;
+			fakeDMAs[i].error_count = 0;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Destroy a fake DMA device.
+ *
+ * @param addr the handle returned by fnInitDMA
+ */
+void fnDestroyDMA(uintptr_t addr)
+{
+	FakeDMAEnv *env = fnGetFakeDMA(addr);
+	if(env)
+	{
+		env->used = false;
+	}
+}
+
+/**
+ * Start a one-way DMA transfer, which completes after the time given by the simulated
+ * bandwidth (see fnFakeSetDMABandwidth); the buffer is left unchanged.
+ *
+ * @param addr the handle returned by fnInitDMA
+ * @param buf the buffer of the transfer
+ * @param transfer_size the size of the transfer in bytes
+ *
+ * @return 0 on success, any other number on failure
+ */
+int fnOneWayDMATransfer(uintptr_t addr, uint32_t *buf, size_t transfer_size)
+{
+	FakeDMAEnv *env = fnGetFakeDMA(addr);
+	if(!env)
+	{
+		return -1;
+	}
+	if(!buf)
+	{
+		env->error_count++;
+		return -1;
+	}
+	env->complete_time = fnGetTimeNs();
+	if(fakeBytesPerUs)
+	{
+		env->complete_time += (uint64_t)transfer_size * 1000 / fakeBytesPerUs;
+	}
+	env->complete_flag = 0;
+	return 0;
+}
+
+/**
+ * Check if the DMA transfer previously started has completed.
+ *
+ * @param addr the handle returned by fnInitDMA
+ *
+ * @return 1 if the DMA transfer completed, 0 if it is still running
+ */
+uint8_t fnIsDMATransferComplete(uintptr_t addr)
+{
+	FakeDMAEnv *env = fnGetFakeDMA(addr);
+	if(!env)
+	{
+		return 0;
+	}
+	if(!env->complete_flag && fnGetTimeNs() >= env->complete_time)
+	{
+		env->complete_flag = 1;
+	}
+	return env->complete_flag;
+}
+
+/**
+ * Get the time the DMA transfer previously started has completed.
+ *
+ * @param addr the handle returned by fnInitDMA
+ *
+ * @return the completion time in nanoseconds (see fnGetTimeNs), 0 if the transfer is still running
+ */
+uint64_t fnGetDMATransferCompleteTime(uintptr_t addr)
+{
+	FakeDMAEnv *env = fnGetFakeDMA(addr);
+	return (env && env->complete_flag) ? env->complete_time : 0;
+}
+
+/**
+ * Get the number of DMA errors since the DMA device was initialized.
+ *
+ * @param addr the handle returned by fnInitDMA
+ *
+ * @return the number of transfers that failed to start
+ */
+uint32_t fnGetDMAErrorCount(uintptr_t addr)
+{
+	FakeDMAEnv *env = fnGetFakeDMA(addr);
+	return env ? env->error_count : 0;
+}
+
+/**
+ * Allocate a DMA buffer, from the heap.
+ *
+ * @param addr the handle returned by fnInitDMA, unused
+ * @param size the size of the DMA buffer
+ *
+ * @return the address of the newly allocated DMA buffer
+ */
+void* fnAllocBuffer(uintptr_t, size_t size)
+{
+	return malloc(size);
+}
+
+/**
+ * Free a DMA buffer.
+ *
+ * @param addr the handle returned by fnInitDMA, unused
+ * @param buf the address of the DMA buffer
+ * @param size the size of the DMA buffer, unused
+ */
+void fnFreeBuffer(uintptr_t, void *buf, size_t)
+{
+	free(buf);
+}
+
+#endif // FAKE_APP
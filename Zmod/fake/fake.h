@@ -0,0 +1,30 @@
+/**
+ * @file fake/fake.h
+ * @date 16 Oct 2026
+ * @brief Declarations of the fake (in-memory) platform, used to run the library without hardware.
+ *
+ * The fake platform is selected by defining FAKE_APP instead of LINUX_APP, and compiling
+ * the files of the Zmod/fake directory instead of the linux or baremetal ones.
+ * The registers of each ZMOD device are an in-memory register file, DMA transfers complete
+ * immediately and the flash is an in-memory array, erased (0xFF) at initialization.
+ * The time to fill the acquisition buffer and the DMA bandwidth can be simulated, see
+ * fnFakeSetSamplePeriod and fnFakeSetDMABandwidth.
+ * The handles returned by the fnInit* functions are indexes in static tables, so the
+ * platform also runs on 64 bits hosts.
+ */
+
+#ifndef FAKE_H_
+#define FAKE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FAKE_MAX_DEVICES	8	///< maximum number of devices of each kind
+#define FAKE_REG_COUNT		64	///< number of 32 bits registers of a fake ZMOD device
+#define FAKE_FLASH_SIZE		0x10000	///< size of a fake flash, in bytes
+
+uint32_t *fnFakeGetRegs(uintptr_t addr);
+void fnFakeSetSamplePeriod(uint32_t samplePeriodNs);
+void fnFakeSetDMABandwidth(uint32_t bytesPerUs);
+
+#endif /* FAKE_H_ */
@@ -0,0 +1,122 @@
+/**
+ * @file fake/flash/flash.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for the flash of the fake platform.
+ */
+
+#ifdef FAKE_APP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "../../flash.h"
+#include "../fake.h"
+
+/**
+ * Struct containing data specific to a fake flash.
+ */
+typedef struct _fake_flash_env {
+	bool used; ///< whether the entry is allocated
+	uint16_t slave_addr; ///< address of the Iic slave
+	uint8_t data[FAKE_FLASH_SIZE]; ///< flash content
+} FakeFlashEnv;
+
+static FakeFlashEnv fakeFlashes[FAKE_MAX_DEVICES]; ///< fake flashes, indexed by handle - 1
+
+/**
+ * Get the fake flash of a handle.
+ *
+ * @param addr the handle returned by fnInitFlash
+ *
+ * @return the flash, NULL for an invalid handle
+ */
+static FakeFlashEnv *fnGetFakeFlash(uintptr_t addr)
+{
+	if(addr < 1 || addr > FAKE_MAX_DEVICES || !fakeFlashes[addr - 1].used)
+	{
+		return NULL;
+	}
+	return &fakeFlashes[addr - 1];
+}
+
+/**
+ * Initialize a fake flash, erased.
+ *
+ * @param addr the address of the Iic device, unused
+ * @param slave_addr the Iic slave address of the flash
+ *
+ * @return the handle of the flash, 0 on failure
+ */
+uint32_t fnInitFlash(uintptr_t, uint16_t slave_addr)
+{
+	for(uint32_t i = 0; i < FAKE_MAX_DEVICES; i++)
+	{
+		if(!fakeFlashes[i].used)
+		{
+			fakeFlashes[i].used = true;
+			fakeFlashes[i].slave_addr = slave_addr;
+			memset(fakeFlashes[i].data, 0xFF, FAKE_FLASH_SIZE);
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Destroy a fake flash.
+ *
+ * @param addr the handle returned by fnInitFlash
+ */
+void fnDestroyFlash(uintptr_t addr)
+{
+	FakeFlashEnv *env = fnGetFakeFlash(addr);
+	if(env)
+	{
+		env->used = false;
+	}
+}
+
+/**
+ * Read from the fake flash.
+ *
+ * @param addr the handle returned by fnInitFlash
+ * @param data_addr address within the flash
+ * @param read_vals pointer receiving the values
+ * @param length of the transfer in bytes
+ *
+ * @return 0 on success, -1 on failure
+ */
+int fnReadFlash(uintptr_t addr, uint16_t data_addr, uint8_t *read_vals, size_t length)
+{
+	FakeFlashEnv *env = fnGetFakeFlash(addr);
+	if(!env || data_addr + length > FAKE_FLASH_SIZE)
+	{
+		return -1;
+	}
+	memcpy(read_vals, env->data + data_addr, length);
+	return 0;
+}
+
+/**
+ * Write to the fake flash.
+ *
+ * @param addr the handle returned by fnInitFlash
+ * @param data_addr address within the flash
+ * @param write_vals pointer to the values to write
+ * @param length of the transfer in bytes
+ *
+ * @return 0 on success, -1 on failure
+ */
+int fnWriteFlash(uintptr_t addr, uint16_t data_addr, uint8_t *write_vals, size_t length)
+{
+	FakeFlashEnv *env = fnGetFakeFlash(addr);
+	if(!env || data_addr + length > FAKE_FLASH_SIZE)
+	{
+		return -1;
+	}
+	memcpy(env->data + data_addr, write_vals, length);
+	return 0;
+}
+
+#endif // FAKE_APP
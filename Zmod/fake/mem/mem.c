@@ -0,0 +1,36 @@
+/**
+ * @file fake/mem/mem.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for the allocation of large processing buffers on the fake platform.
+ */
+
+#ifdef FAKE_APP
+
+#include <stdlib.h>
+
+#include "../../mem.h"
+
+/**
+ * Allocate a large buffer, from the heap.
+ *
+ * @param size the size of the buffer, in bytes
+ *
+ * @return the pointer to the allocated buffer, NULL on failure
+ */
+void* fnAllocLargeBuffer(size_t size)
+{
+	return malloc(size);
+}
+
+/**
+ * Free a buffer allocated by fnAllocLargeBuffer.
+ *
+ * @param buf the address of the buffer
+ * @param size the size of the buffer, in bytes, unused
+ */
+void fnFreeLargeBuffer(void *buf, size_t)
+{
+	free(buf);
+}
+
+#endif // FAKE_APP
@@ -0,0 +1,181 @@
+/**
+ * @file fake/reg/reg.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the register writing functions of the fake platform.
+ */
+
+#ifdef FAKE_APP
+
+#include <string.h>
+
+#include "../../reg.h"
+#include "../../timer.h"
+#include "../../zmod.h"
+#include "../fake.h"
+
+#define FAKE_SR_CMD_TX_DONE	(1u << 0)	///< CMD_TX_DONE bit of the SR register
+#define FAKE_SR_BUF_FULL	(1u << 21)	///< BUF_FULL bit of the SR register
+#define FAKE_CR_RUNSTOP		(1u << 4)	///< acquisition RUNSTOP bit of the CR register
+
+/**
+ * Struct containing data specific to a fake ZMOD device.
+ */
+typedef struct _fake_zmod_env {
+	bool used; ///< whether the entry is allocated
+	uintptr_t addr; ///< the address of the ZMOD device
+	uint32_t regs[FAKE_REG_COUNT]; ///< the register file
+	bool filling; ///< whether the acquisition buffer is being filled
+	uint64_t fullTime; ///< time the acquisition buffer is full
+} FakeZmodEnv;
+
+static FakeZmodEnv fakeZmods[FAKE_MAX_DEVICES]; ///< fake ZMOD devices, indexed by handle - 1
+static uint32_t fakeSamplePeriodNs = 0; ///< simulated sampling period, 0 to fill the buffer immediately
+
+/**
+ * Set the simulated sampling period of the fake ZMOD devices: once started, the acquisition
+ * buffer is full after the number of samples of the S2MM transfer length were sampled.
+ *
+ * @param samplePeriodNs the sampling period in nanoseconds, 0 to fill the buffer immediately
+ */
+void fnFakeSetSamplePeriod(uint32_t samplePeriodNs)
+{
+	fakeSamplePeriodNs = samplePeriodNs;
+}
+
+/**
+ * Get the fake ZMOD device of a handle.
+ *
+ * @param addr the handle returned by fnInitZmod
+ *
+ * @return the device, NULL for an invalid handle
+ */
+static FakeZmodEnv *fnGetFakeZmod(uintptr_t addr)
+{
+	if(addr < 1 || addr > FAKE_MAX_DEVICES || !fakeZmods[addr - 1].used)
+	{
+		return NULL;
+	}
+	return &fakeZmods[addr - 1];
+}
+
+/**
+ * Initialize a fake ZMOD device, with all registers cleared.
+ *
+ * @param addr the address of the ZMOD device
+ * @param zmodInterrupt the interrupt number of the ZMOD device, unused
+ * @param fnZmodInterruptHandler the interrupt callback, unused
+ * @param zmodInterruptData the interrupt callback data, unused
+ *
+ * @return the handle of the device, 0 on failure
+ */
+uint32_t fnInitZmod(uintptr_t addr, int,
+		void *, void *)
+{
+	for(uint32_t i = 0; i < FAKE_MAX_DEVICES; i++)
+	{
+		if(!fakeZmods[i].used)
+		{
+			memset(&fakeZmods[i], 0, sizeof(FakeZmodEnv));
+			fakeZmods[i].used = true;
+			fakeZmods[i].addr = addr;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Destroy a fake ZMOD device.
+ *
+ * @param addr the handle returned by fnInitZmod
+ */
+void fnDestroyZmod(uintptr_t addr)
+{
+	FakeZmodEnv *env = fnGetFakeZmod(addr);
+	if(env)
+	{
+		env->used = false;
+	}
+}
+
+/**
+ * Write a register of the fake ZMOD device.
+ * The SR register is write one to clear, and a rising edge of the RUNSTOP bit of the CR
+ * register starts filling the acquisition buffer (see fnFakeSetSamplePeriod).
+ *
+ * @param base_addr the handle returned by fnInitZmod
+ * @param reg_addr the offset address of the register
+ * @param val the value to write
+ */
+void fnWriteReg(uintptr_t base_addr, uint8_t reg_addr, uint32_t val)
+{
+	FakeZmodEnv *env = fnGetFakeZmod(base_addr);
+	if(!env || reg_addr / 4 >= FAKE_REG_COUNT)
+	{
+		return;
+	}
+	if(reg_addr == ZMOD_REG_ADDR_SR)
+	{
+		env->regs[reg_addr / 4] &= ~val;
+		return;
+	}
+	if(reg_addr == ZMOD_REG_ADDR_CR)
+	{
+		if((val & FAKE_CR_RUNSTOP) && !(env->regs[reg_addr / 4] & FAKE_CR_RUNSTOP))
+		{
+			uint64_t samples = (env->regs[ZMOD_REG_ADDR_AXIS_S2MM_LENGTH / 4] & 0x3FFFFFF) / sizeof(uint32_t);
+			env->filling = true;
+			env->fullTime = fnGetTimeNs() + samples * fakeSamplePeriodNs;
+		}
+		else if(!(val & FAKE_CR_RUNSTOP))
+		{
+			env->filling = false;
+		}
+	}
+	env->regs[reg_addr / 4] = val;
+}
+
+/**
+ * Read a register of the fake ZMOD device.
+ * Commands are sent immediately, so CMD_TX_DONE is always set in the SR register, and
+ * BUF_FULL is set (and RUNSTOP cleared) once the simulated acquisition has filled the buffer.
+ *
+ * @param base_addr the handle returned by fnInitZmod
+ * @param reg_addr the offset address of the register
+ *
+ * @return the value of the register, 0 for an invalid handle or register
+ */
+uint32_t fnReadReg(uintptr_t base_addr, uint8_t reg_addr)
+{
+	FakeZmodEnv *env = fnGetFakeZmod(base_addr);
+	if(!env || reg_addr / 4 >= FAKE_REG_COUNT)
+	{
+		return 0;
+	}
+	if(reg_addr == ZMOD_REG_ADDR_SR)
+	{
+		if(env->filling && fnGetTimeNs() >= env->fullTime)
+		{
+			env->filling = false;
+			env->regs[reg_addr / 4] |= FAKE_SR_BUF_FULL;
+			env->regs[ZMOD_REG_ADDR_CR / 4] &= ~FAKE_CR_RUNSTOP;
+		}
+		return env->regs[reg_addr / 4] | FAKE_SR_CMD_TX_DONE;
+	}
+	return env->regs[reg_addr / 4];
+}
+
+/**
+ * Get the register file of a fake ZMOD device, to inspect or drive it.
+ *
+ * @param addr the handle returned by fnInitZmod
+ *
+ * @return the FAKE_REG_COUNT registers, indexed by offset address / 4, NULL for an invalid handle
+ */
+uint32_t *fnFakeGetRegs(uintptr_t addr)
+{
+	FakeZmodEnv *env = fnGetFakeZmod(addr);
+	return env ? env->regs : NULL;
+}
+
+#endif // FAKE_APP
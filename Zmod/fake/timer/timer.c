@@ -0,0 +1,28 @@
+/**
+ * @file fake/timer/timer.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for time stamping on the fake platform.
+ */
+
+#ifdef FAKE_APP
+
+#include <stdint.h>
+#include <time.h>
+
+#include "../../timer.h"
+
+/**
+ * Read the monotonic time of the host.
+ *
+ * @return the value of CLOCK_MONOTONIC, in nanoseconds
+ */
+uint64_t fnGetTimeNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#endif // FAKE_APP
@@ -15,6 +15,9 @@
 #include <string.h>
 
 #include "../../dma.h"
+#include "../../timer.h"
+#include "../../perf.h"
+#include "../../trace.h"
 #include "../utils.h"
 #include "libaxidma.h"
 
@@ -27,6 +30,8 @@ typedef struct _dma_env {
 	axidma_dev_t dma_inst; ///< a pointer to the instance of the AXI DMA library
 	int channel_id; ///< the channel id that will be used for DMA transfers
 	uint8_t complete_flag; ///< whether the current DMA transfer is complete or not
+	uint64_t complete_time; ///< time the current DMA transfer completed (see fnGetTimeNs), 0 while running
+	uint32_t error_count; ///< number of DMA transfers that failed to start
 } DMAEnv;
 
 /**
@@ -41,7 +46,10 @@ void fnDMAInterruptHandler(int channel_id, void *data)
 	if (!dma_env)
 		return;
 
-	dma_env->complete_flag = 1;
+	// the time is published by the flag, a 64-bit store is not atomic on 32-bit ARM
+	__atomic_store_n(&dma_env->complete_time, fnGetTimeNs(), __ATOMIC_RELAXED);
+	__atomic_store_n(&dma_env->complete_flag, 1, __ATOMIC_RELEASE);
+	ZMOD_TRACE2(dma_complete, dma_env->addr, channel_id);
 }
 
 /**
@@ -60,10 +68,18 @@ int fnOneWayDMATransfer(uintptr_t addr, uint32_t *buf, size_t transfer_size)
 	if (!dma_env)
 		return -1;
 
-	dma_env->complete_flag = 0;
+	__atomic_store_n(&dma_env->complete_flag, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&dma_env->complete_time, 0, __ATOMIC_RELAXED);
 
-	return axidma_oneway_transfer(dma_env->dma_inst, dma_env->channel_id,
+	ZMOD_PERF_BEGIN(perfStart);
+	int rc = axidma_oneway_transfer(dma_env->dma_inst, dma_env->channel_id,
 			(void *)buf, transfer_size, 0);
+	ZMOD_PERF_END(ZMOD_PERF_DMA_START, perfStart);
+	if (rc) {
+		__atomic_fetch_add(&dma_env->error_count, 1, __ATOMIC_RELAXED);
+	}
+
+	return rc;
 }
 
 /**
@@ -79,7 +95,40 @@ uint8_t fnIsDMATransferComplete(uintptr_t addr)
 	if (!dma_env)
 		return 0;
 
-	return dma_env->complete_flag;
+	return __atomic_load_n(&dma_env->complete_flag, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Get the time the DMA transfer previously started has completed, as captured
+ * by the DMA interrupt handler.
+ *
+ * @param addr the address of the DMAEnv instance returned by fnInitDMA
+ *
+ * @return the completion time in nanoseconds (see fnGetTimeNs), 0 if the transfer is still running
+ */
+uint64_t fnGetDMATransferCompleteTime(uintptr_t addr)
+{
+	DMAEnv *dma_env = (DMAEnv *)addr;
+	if (!dma_env)
+		return 0;
+
+	return __atomic_load_n(&dma_env->complete_time, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get the number of DMA errors since the DMA device was initialized.
+ *
+ * @param addr the address of the DMAEnv instance returned by fnInitDMA
+ *
+ * @return the number of transfers that failed to start
+ */
+uint32_t fnGetDMAErrorCount(uintptr_t addr)
+{
+	DMAEnv *dma_env = (DMAEnv *)addr;
+	if (!dma_env)
+		return 0;
+
+	return __atomic_load_n(&dma_env->error_count, __ATOMIC_RELAXED);
 }
 
 #define NODES_DIRECTORY "/sys/firmware/devicetree/base/amba_pl"
@@ -186,6 +235,9 @@ uint32_t fnInitDMA(uintptr_t addr, enum dma_direction direction, int dmaInterrup
 
 	dma_env->addr = addr;
 	dma_env->direction = direction;
+	dma_env->complete_flag = 0;
+	dma_env->complete_time = 0;
+	dma_env->error_count = 0;
 
     // Get channels
 	const array_t *channels;
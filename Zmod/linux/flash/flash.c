@@ -19,6 +19,8 @@
 #include <linux/i2c-dev.h>
 
 #include "../utils.h"
+#include "../../perf.h"
+#include "../../trace.h"
 
 //Linux I2c specific defines
 #define I2C_DEVICES_DIRECTORY 	"/sys/bus/i2c/devices"
@@ -170,6 +172,7 @@ int fnReadFlash(uintptr_t addr, uint16_t data_addr, uint8_t *read_vals, size_t l
 
 	uint8_t txData[2];
 	int rc;
+	ZMOD_PERF_BEGIN(perfStart);
 
 	// Add the register address to stream
 	fnFormatAddr(txData, data_addr);
@@ -190,10 +193,12 @@ int fnReadFlash(uintptr_t addr, uint16_t data_addr, uint8_t *read_vals, size_t l
 
 	// Read back the values
 	rc = read(flash_env->fd, read_vals, length);
+	ZMOD_TRACE4(flash_read, flash_env->slave_addr, data_addr, length, rc);
 	if (rc < 0) {
 		printf("%s: failed to read i2c register address\r\n", __func__);
 		return rc;
 	}
+	ZMOD_PERF_END(ZMOD_PERF_FLASH_READ, perfStart);
 
 	return 0;
 }
@@ -215,6 +220,7 @@ int fnWriteFlash(uintptr_t addr, uint16_t data_addr, uint8_t *write_vals, size_t
 
 	int rc;
 	uint8_t txData[FLASH_MAX_LENGTH];
+	ZMOD_PERF_BEGIN(perfStart);
 
 	//add the register address to stream
 	fnFormatAddr(txData, data_addr);
@@ -231,10 +237,12 @@ int fnWriteFlash(uintptr_t addr, uint16_t data_addr, uint8_t *write_vals, size_t
 
 	//send the data stream
 	rc = write(flash_env->fd, txData, length + 2);
+	ZMOD_TRACE4(flash_write, flash_env->slave_addr, data_addr, length, rc);
 	if (rc < 0) {
 		printf("%s: failed to write i2c register address\r\n", __func__);
 		return rc;
 	}
+	ZMOD_PERF_END(ZMOD_PERF_FLASH_WRITE, perfStart);
 
 	return 0;
 }
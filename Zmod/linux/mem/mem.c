@@ -0,0 +1,120 @@
+/**
+ * @file linux/mem/mem.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for the allocation of large processing buffers.
+ */
+
+#ifdef LINUX_APP
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/mman.h>
+
+#include "../../mem.h"
+
+#define HUGE_PAGE_DEF_SIZE	(2 * 1024 * 1024)	///< size of a huge page when the kernel does not report it
+
+static size_t hugePageSize = 0; ///< size of the default huge pages, 0 before it is read
+
+/**
+ * Get the size of the default huge pages of the kernel, read once from the Hugepagesize
+ * line of /proc/meminfo, HUGE_PAGE_DEF_SIZE if it cannot be read.
+ *
+ * @return the size of a huge page, in bytes, a power of 2
+ */
+static size_t fnGetHugePageSize()
+{
+	size_t size = __atomic_load_n(&hugePageSize, __ATOMIC_RELAXED);
+	char line[128];
+	unsigned long kb;
+	FILE *file;
+
+	if(size)
+	{
+		return size;
+	}
+	size = HUGE_PAGE_DEF_SIZE;
+	file = fopen("/proc/meminfo", "r");
+	if(file)
+	{
+		while(fgets(line, sizeof(line), file))
+		{
+			if(sscanf(line, "Hugepagesize: %lu kB", &kb) == 1)
+			{
+				// a power of 2, the mapping sizes are rounded with a mask
+				if(kb && !(kb & (kb - 1)))
+				{
+					size = (size_t)kb * 1024;
+				}
+				break;
+			}
+		}
+		fclose(file);
+	}
+	__atomic_store_n(&hugePageSize, size, __ATOMIC_RELAXED);
+	return size;
+}
+
+/**
+ * Round a buffer size up to a whole number of huge pages.
+ *
+ * @param size the size of the buffer, in bytes
+ *
+ * @return the size of the mapping, in bytes
+ */
+static size_t fnLargeBufferMapSize(size_t size)
+{
+	size_t pageSize = fnGetHugePageSize();
+
+	return (size + pageSize - 1) & ~(pageSize - 1);
+}
+
+/**
+ * Allocate a large buffer, not used for DMA transfers, backed by huge pages to
+ * limit the TLB pressure of the accesses. Explicit huge pages (hugetlbfs) of the default
+ * size are used when reserved, otherwise the mapping is advised for transparent huge pages.
+ *
+ * @param size the size of the buffer, in bytes
+ *
+ * @return the pointer to the allocated buffer, NULL on failure
+ */
+void* fnAllocLargeBuffer(size_t size)
+{
+	size_t mapSize = fnLargeBufferMapSize(size);
+	void *buf;
+
+#ifdef MAP_HUGETLB
+	buf = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if(buf != MAP_FAILED)
+	{
+		return buf;
+	}
+#endif
+	buf = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(buf == MAP_FAILED)
+	{
+		return NULL;
+	}
+#ifdef MADV_HUGEPAGE
+	madvise(buf, mapSize, MADV_HUGEPAGE);
+#endif
+
+	return buf;
+}
+
+/**
+ * Free a buffer allocated by fnAllocLargeBuffer.
+ *
+ * @param buf the address of the buffer
+ * @param size the size of the buffer, in bytes, as passed to fnAllocLargeBuffer
+ */
+void fnFreeLargeBuffer(void *buf, size_t size)
+{
+	if(buf)
+	{
+		munmap(buf, fnLargeBufferMapSize(size));
+	}
+}
+
+#endif // LINUX_APP
@@ -0,0 +1,28 @@
+/**
+ * @file linux/timer/timer.c
+ * @date 16 Oct 2026
+ * @brief File containing implementations of platform-specific methods for time stamping.
+ */
+
+#ifdef LINUX_APP
+
+#include <stdint.h>
+#include <time.h>
+
+#include "../../timer.h"
+
+/**
+ * Read the monotonic time, not affected by NTP adjustments.
+ *
+ * @return the value of CLOCK_MONOTONIC_RAW, in nanoseconds
+ */
+uint64_t fnGetTimeNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#endif // LINUX_APP
@@ -0,0 +1,16 @@
+/**
+ * @file mem.h
+ * @date 16 Oct 2026
+ * @brief Function declarations used for the allocation of large processing buffers.
+ */
+
+#ifndef MEM_H_
+#define MEM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+void* fnAllocLargeBuffer(size_t size);
+void fnFreeLargeBuffer(void *buf, size_t size);
+
+#endif /* MEM_H_ */
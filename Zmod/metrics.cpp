@@ -0,0 +1,269 @@
+/**
+ * @file metrics.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the running metrics of the ZMOD devices, and of their Prometheus export.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "metrics.h"
+#include "zmod.h"
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif // LINUX_APP || FAKE_APP
+
+/**
+ * Description of an exported metric.
+ */
+typedef struct _ZMODMetricDesc {
+	const char *name; ///< name of the metric
+	const char *type; ///< Prometheus type of the metric
+	const char *help; ///< description of the metric
+	size_t offset; ///< offset of the value in ZMODMetrics
+	bool perChannel; ///< whether the value is an array of ZMOD_METRICS_CHANNELS gauges
+} ZMODMetricDesc;
+
+/// Exported metrics.
+static const ZMODMetricDesc metricDescs[] = {
+	{"zmod_acquisitions_total", "counter", "Acquisitions or buffer loads completed.",
+			offsetof(ZMODMetrics, acquisitions), false},
+	{"zmod_dma_bytes_total", "counter", "Bytes transferred by DMA.",
+			offsetof(ZMODMetrics, bytesTransferred), false},
+	{"zmod_missed_triggers_total", "counter", "Triggers estimated to be lost between segmented acquisitions.",
+			offsetof(ZMODMetrics, missedTriggers), false},
+	{"zmod_timeouts_total", "counter", "Acquisitions that stopped waiting for a trigger.",
+			offsetof(ZMODMetrics, timeouts), false},
+	{"zmod_dma_errors_total", "counter", "DMA errors reported by the platform.",
+			offsetof(ZMODMetrics, dmaErrors), false},
+	{"zmod_calib_id_errors_total", "counter", "User calibrations read with a wrong ID.",
+			offsetof(ZMODMetrics, calibIdErrors), false},
+	{"zmod_calib_crc_errors_total", "counter", "User calibrations read with a wrong CRC.",
+			offsetof(ZMODMetrics, calibCrcErrors), false},
+	{"zmod_gain", "gauge", "Current gain of the channel, 0 for LOW, 1 for HIGH.",
+			offsetof(ZMODMetrics, gain), true},
+	{"zmod_coupling", "gauge", "Current coupling of the channel, 0 for DC, 1 for AC.",
+			offsetof(ZMODMetrics, coupling), true},
+};
+
+/**
+ * Initialize a metrics block: counters cleared, gauges unset.
+ *
+ * @param metrics the metrics block
+ */
+void fnMetricsInit(ZMODMetrics *metrics)
+{
+	memset(metrics, 0, sizeof(ZMODMetrics));
+	for(int ch = 0; ch < ZMOD_METRICS_CHANNELS; ch++)
+	{
+		metrics->gain[ch] = ZMOD_METRICS_UNSET;
+		metrics->coupling[ch] = ZMOD_METRICS_UNSET;
+	}
+}
+
+/**
+ * Copy a metrics block while it may be updated. Each value is read atomically, so it is
+ * consistent by itself, but values updated together can be seen one updated and not the other.
+ *
+ * @param metrics the metrics block
+ * @param snapshot receives the copy
+ */
+void fnMetricsSnapshot(const ZMODMetrics *metrics, ZMODMetrics *snapshot)
+{
+	snapshot->acquisitions = __atomic_load_n(&metrics->acquisitions, __ATOMIC_RELAXED);
+	snapshot->bytesTransferred = __atomic_load_n(&metrics->bytesTransferred, __ATOMIC_RELAXED);
+	snapshot->missedTriggers = __atomic_load_n(&metrics->missedTriggers, __ATOMIC_RELAXED);
+	snapshot->timeouts = __atomic_load_n(&metrics->timeouts, __ATOMIC_RELAXED);
+	snapshot->dmaErrors = __atomic_load_n(&metrics->dmaErrors, __ATOMIC_RELAXED);
+	snapshot->calibIdErrors = __atomic_load_n(&metrics->calibIdErrors, __ATOMIC_RELAXED);
+	snapshot->calibCrcErrors = __atomic_load_n(&metrics->calibCrcErrors, __ATOMIC_RELAXED);
+	for(int ch = 0; ch < ZMOD_METRICS_CHANNELS; ch++)
+	{
+		snapshot->gain[ch] = __atomic_load_n(&metrics->gain[ch], __ATOMIC_RELAXED);
+		snapshot->coupling[ch] = __atomic_load_n(&metrics->coupling[ch], __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * Format metrics snapshots in the Prometheus text exposition format, each device being
+ * identified by a "device" label. The gauges never set are not exported.
+ *
+ * @param text receives the text, null terminated
+ * @param size the size of text, in bytes
+ * @param names the names of the devices, used as "device" label values
+ * @param snapshots the snapshots of the devices (see ZMOD::getMetrics)
+ * @param count the number of devices
+ *
+ * @return the length of the text, ERR_FAIL if text is too small
+ */
+int fnMetricsFormatPrometheus(char *text, size_t size, const char *const *names,
+		const ZMODMetrics *snapshots, uint32_t count)
+{
+	size_t length = 0;
+	int written;
+
+#define METRICS_PRINTF(...) \
+	written = snprintf(text + length, size - length, __VA_ARGS__); \
+	if(written < 0 || (size_t)written >= size - length) \
+	{ \
+		return ERR_FAIL; \
+	} \
+	length += written
+
+	if(!size)
+	{
+		return ERR_FAIL;
+	}
+	text[0] = 0;
+	for(size_t m = 0; m < sizeof(metricDescs) / sizeof(metricDescs[0]); m++)
+	{
+		const ZMODMetricDesc *desc = &metricDescs[m];
+
+		METRICS_PRINTF("# HELP %s %s\n# TYPE %s %s\n", desc->name, desc->help, desc->name, desc->type);
+		for(uint32_t d = 0; d < count; d++)
+		{
+			const char *base = (const char *)&snapshots[d] + desc->offset;
+			if(!desc->perChannel)
+			{
+				METRICS_PRINTF("%s{device=\"%s\"} %llu\n", desc->name, names[d],
+						(unsigned long long)*(const uint64_t *)base);
+				continue;
+			}
+			for(int ch = 0; ch < ZMOD_METRICS_CHANNELS; ch++)
+			{
+				int32_t value = ((const int32_t *)base)[ch];
+				if(value != ZMOD_METRICS_UNSET)
+				{
+					METRICS_PRINTF("%s{device=\"%s\",channel=\"%d\"} %d\n", desc->name, names[d], ch + 1, (int)value);
+				}
+			}
+		}
+	}
+#undef METRICS_PRINTF
+	return (int)length;
+}
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+/**
+ * Write formatted metrics to a file, atomically: a temporary file is written next to it,
+ * then renamed, so that a reader never sees a partial file.
+ *
+ * @param path the path of the file, for example in the node exporter textfile collector directory
+ * @param text the formatted metrics
+ * @param length the length of text
+ *
+ * @return ERR_SUCCESS on success, ERR_FAIL on failure
+ */
+int fnMetricsWriteFile(const char *path, const char *text, size_t length)
+{
+	char tmpPath[256];
+	FILE *file;
+	int status = ERR_SUCCESS;
+
+	if(snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path) >= (int)sizeof(tmpPath))
+	{
+		return ERR_FAIL;
+	}
+	file = fopen(tmpPath, "w");
+	if(!file)
+	{
+		return ERR_FAIL;
+	}
+	if(fwrite(text, 1, length, file) != length)
+	{
+		status = ERR_FAIL;
+	}
+	if(fclose(file) || status != ERR_SUCCESS || rename(tmpPath, path))
+	{
+		unlink(tmpPath);
+		return ERR_FAIL;
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Open a non-blocking Unix stream socket serving the metrics, replacing a stale socket file.
+ *
+ * @param path the path of the socket
+ *
+ * @return the socket file descriptor, ERR_FAIL on failure
+ */
+int fnMetricsOpenSocket(const char *path)
+{
+	struct sockaddr_un addr;
+	int fd;
+
+	if(strlen(path) >= sizeof(addr.sun_path))
+	{
+		return ERR_FAIL;
+	}
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0)
+	{
+		return ERR_FAIL;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	unlink(path);
+	if(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(fd, 8) ||
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK))
+	{
+		close(fd);
+		return ERR_FAIL;
+	}
+	return fd;
+}
+
+/**
+ * Send formatted metrics to each client waiting on the metrics socket, then close
+ * its connection. Does not block when no client is waiting.
+ *
+ * @param fd the socket returned by fnMetricsOpenSocket
+ * @param text the formatted metrics
+ * @param length the length of text
+ *
+ * @return the number of clients served, ERR_FAIL on failure
+ */
+int fnMetricsServeSocket(int fd, const char *text, size_t length)
+{
+	int served = 0;
+
+	for(;;)
+	{
+		int client = accept(fd, NULL, NULL);
+		if(client < 0)
+		{
+			return (errno == EAGAIN || errno == EWOULDBLOCK) ? served : ERR_FAIL;
+		}
+		size_t sent = 0;
+		while(sent < length)
+		{
+			ssize_t rc = send(client, text + sent, length - sent, MSG_NOSIGNAL);
+			if(rc <= 0)
+			{
+				break;
+			}
+			sent += rc;
+		}
+		close(client);
+		served++;
+	}
+}
+
+/**
+ * Close the metrics socket, and remove its file.
+ *
+ * @param fd the socket returned by fnMetricsOpenSocket
+ * @param path the path of the socket
+ */
+void fnMetricsCloseSocket(int fd, const char *path)
+{
+	close(fd);
+	unlink(path);
+}
+#endif // LINUX_APP || FAKE_APP
@@ -0,0 +1,71 @@
+/**
+ * @file metrics.h
+ * @date 16 Oct 2026
+ * @brief Declarations of the running metrics of the ZMOD devices, and of their Prometheus export.
+ *
+ * Each ZMOD holds a metrics block, updated by the acquisition thread (and the interrupt
+ * handlers) with relaxed atomic operations, without locks. Another thread takes consistent
+ * per-counter snapshots with ZMOD::getMetrics, only reading the block, so that scraping
+ * does not delay the acquisitions. The snapshots can be formatted in the Prometheus text
+ * exposition format, and on Linux written to a file (for the node exporter textfile
+ * collector) or served on a Unix socket.
+ */
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ZMOD_METRICS_CHANNELS	2	///< number of channels of the per channel gauges
+#define ZMOD_METRICS_UNSET		-1	///< value of a gauge never set, or not applicable
+
+/**
+ * Struct containing the metrics of a ZMOD device.
+ */
+typedef struct _ZMODMetrics {
+	uint64_t acquisitions; ///< acquisitions (ADC) or buffer loads (DAC) completed, counted at the DMA completion
+	uint64_t bytesTransferred; ///< bytes transferred by DMA
+	uint64_t missedTriggers; ///< triggers estimated to be lost between segmented acquisitions
+	uint64_t timeouts; ///< acquisitions that stopped waiting for a trigger
+	uint64_t dmaErrors; ///< DMA errors reported by the platform (only in snapshots)
+	uint64_t calibIdErrors; ///< user calibrations read with a wrong ID
+	uint64_t calibCrcErrors; ///< user calibrations read with a wrong CRC
+	int32_t gain[ZMOD_METRICS_CHANNELS]; ///< [channel] current gain, 0 for LOW, 1 for HIGH
+	int32_t coupling[ZMOD_METRICS_CHANNELS]; ///< [channel] current coupling, 0 for DC, 1 for AC
+} ZMODMetrics;
+
+/**
+ * Add to a counter of a metrics block. Safe to call concurrently, including from interrupt handlers.
+ *
+ * @param counter the counter
+ * @param value the value to add
+ */
+static inline void fnMetricsAdd(uint64_t *counter, uint64_t value)
+{
+	__atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * Set a gauge of a metrics block.
+ *
+ * @param gauge the gauge
+ * @param value the value
+ */
+static inline void fnMetricsSet(int32_t *gauge, int32_t value)
+{
+	__atomic_store_n(gauge, value, __ATOMIC_RELAXED);
+}
+
+void fnMetricsInit(ZMODMetrics *metrics);
+void fnMetricsSnapshot(const ZMODMetrics *metrics, ZMODMetrics *snapshot);
+int fnMetricsFormatPrometheus(char *text, size_t size, const char *const *names,
+		const ZMODMetrics *snapshots, uint32_t count);
+#if defined(LINUX_APP) || defined(FAKE_APP)
+int fnMetricsWriteFile(const char *path, const char *text, size_t length);
+int fnMetricsOpenSocket(const char *path);
+int fnMetricsServeSocket(int fd, const char *text, size_t length);
+void fnMetricsCloseSocket(int fd, const char *path);
+#endif // LINUX_APP || FAKE_APP
+
+#endif /* METRICS_H_ */
@@ -0,0 +1,160 @@
+/**
+ * @file perf.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the optional latency instrumentation of the driver.
+ */
+
+#include <string.h>
+#include "perf.h"
+
+#ifdef ZMOD_PERF
+static ZMODPerfStats perfStats[ZMOD_PERF_OP_COUNT]; ///< [operation] statistics, updated atomically
+#endif
+
+/**
+ * Record the latency of an operation, usually through the ZMOD_PERF_* macros.
+ * Safe to call concurrently, including from interrupt handlers.
+ *
+ * @param op the operation
+ * @param ns the latency, in nanoseconds
+ */
+void fnPerfRecord(enum zmod_perf_op op, uint64_t ns)
+{
+#ifdef ZMOD_PERF
+	ZMODPerfStats *stats = &perfStats[op];
+	uint32_t bucket = ns ? 64 - __builtin_clzll(ns) : 0;
+	uint64_t max = __atomic_load_n(&stats->maxNs, __ATOMIC_RELAXED);
+
+	if(bucket >= ZMOD_PERF_BUCKETS)
+	{
+		bucket = ZMOD_PERF_BUCKETS - 1;
+	}
+	__atomic_fetch_add(&stats->count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&stats->totalNs, ns, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&stats->buckets[bucket], 1, __ATOMIC_RELAXED);
+	while(ns > max && !__atomic_compare_exchange_n(&stats->maxNs, &max, ns, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+#else
+	(void)op;
+	(void)ns;
+#endif
+}
+
+/**
+ * Copy the statistics of all the operations. The counters of an operation are read
+ * one by one while they may be updated, so they can be off by the operations in progress.
+ *
+ * @param stats the array receiving the statistics, of ZMOD_PERF_OP_COUNT elements,
+ *  indexed by zmod_perf_op; all zeros when the instrumentation is not compiled in
+ */
+void fnPerfSnapshot(ZMODPerfStats *stats)
+{
+#ifdef ZMOD_PERF
+	for(int op = 0; op < ZMOD_PERF_OP_COUNT; op++)
+	{
+		stats[op].count = __atomic_load_n(&perfStats[op].count, __ATOMIC_RELAXED);
+		stats[op].totalNs = __atomic_load_n(&perfStats[op].totalNs, __ATOMIC_RELAXED);
+		stats[op].maxNs = __atomic_load_n(&perfStats[op].maxNs, __ATOMIC_RELAXED);
+		for(int b = 0; b < ZMOD_PERF_BUCKETS; b++)
+		{
+			stats[op].buckets[b] = __atomic_load_n(&perfStats[op].buckets[b], __ATOMIC_RELAXED);
+		}
+	}
+#else
+	memset(stats, 0, ZMOD_PERF_OP_COUNT * sizeof(ZMODPerfStats));
+#endif
+}
+
+/**
+ * Clear the statistics of all the operations.
+ */
+void fnPerfReset()
+{
+#ifdef ZMOD_PERF
+	for(int op = 0; op < ZMOD_PERF_OP_COUNT; op++)
+	{
+		__atomic_store_n(&perfStats[op].count, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&perfStats[op].totalNs, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&perfStats[op].maxNs, 0, __ATOMIC_RELAXED);
+		for(int b = 0; b < ZMOD_PERF_BUCKETS; b++)
+		{
+			__atomic_store_n(&perfStats[op].buckets[b], 0, __ATOMIC_RELAXED);
+		}
+	}
+#endif
+}
+
+/**
+ * Get the name of an operation, for reports.
+ *
+ * @param op the operation
+ *
+ * @return the name of the operation
+ */
+const char *fnPerfOpName(enum zmod_perf_op op)
+{
+	static const char *names[ZMOD_PERF_OP_COUNT] = {
+		"reg_write_fld",
+		"send_commands",
+		"receive_commands",
+		"dma_start",
+		"dma_transfer",
+		"wait_buffer_full",
+		"adc_acquire",
+		"dac_set_data",
+		"flash_read",
+		"flash_write",
+	};
+
+	return (unsigned)op < ZMOD_PERF_OP_COUNT ? names[op] : "unknown";
+}
+
+/**
+ * Get the upper bound of the latencies counted by a bucket.
+ *
+ * @param bucket the bucket
+ *
+ * @return the upper bound, exclusive, in nanoseconds; UINT64_MAX for the last bucket
+ */
+uint64_t fnPerfBucketUpperNs(uint32_t bucket)
+{
+	if(bucket >= ZMOD_PERF_BUCKETS - 1)
+	{
+		return UINT64_MAX;
+	}
+	return 1ULL << bucket;
+}
+
+/**
+ * Estimate a percentile of the latencies of an operation from its histogram,
+ * as the upper bound of the bucket holding it (at most twice the exact value).
+ *
+ * @param stats the statistics of the operation
+ * @param percentile the percentile, between 0 and 100
+ *
+ * @return the estimated percentile, in nanoseconds, 0 if there is no operation;
+ *  the maximum latency if it falls in the last bucket
+ */
+uint64_t fnPerfPercentileNs(const ZMODPerfStats *stats, double percentile)
+{
+	uint64_t rank, seen = 0;
+
+	if(!stats->count)
+	{
+		return 0;
+	}
+	rank = (uint64_t)(percentile / 100.0 * stats->count);
+	if(rank >= stats->count)
+	{
+		rank = stats->count - 1;
+	}
+	for(uint32_t b = 0; b < ZMOD_PERF_BUCKETS; b++)
+	{
+		seen += stats->buckets[b];
+		if(seen > rank)
+		{
+			uint64_t upper = fnPerfBucketUpperNs(b);
+			return upper < stats->maxNs ? upper : stats->maxNs;
+		}
+	}
+	return stats->maxNs;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file perf.h
+ * @date 16 Oct 2026
+ * @brief Declarations of the optional latency instrumentation of the driver.
+ *
+ * The instrumentation is compiled in when ZMOD_PERF is defined (for example -DZMOD_PERF);
+ * otherwise the ZMOD_PERF_* macros expand to nothing, and the snapshot only reports zeros.
+ * Each operation has a histogram of its latencies in power of 2 buckets of nanoseconds,
+ * updated with relaxed atomic additions, so it can be left enabled in production.
+ */
+
+#ifndef PERF_H_
+#define PERF_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ZMOD_PERF_BUCKETS 40 ///< number of buckets: bucket b counts the latencies in [2^(b-1), 2^b) ns, the last one the longer ones
+
+/**
+ * Instrumented operations.
+ */
+enum zmod_perf_op {
+	ZMOD_PERF_REG_WRITE_FLD, ///< register field read-modify-write (ZMOD::writeRegFld)
+	ZMOD_PERF_SEND_COMMANDS, ///< commands sent and command FIFO drained (ZMOD::sendCommands)
+	ZMOD_PERF_RECEIVE_COMMANDS, ///< commands read from the command FIFO (ZMOD::receiveCommands)
+	ZMOD_PERF_DMA_START, ///< DMA transfer start in the backend (fnOneWayDMATransfer)
+	ZMOD_PERF_DMA_TRANSFER, ///< DMA transfer, from start to completion
+	ZMOD_PERF_WAIT_BUFFER_FULL, ///< ADC, from start to buffer full
+	ZMOD_PERF_ADC_ACQUIRE, ///< ADC polling acquisition (ZMODADC1410::acquirePolling)
+	ZMOD_PERF_DAC_SET_DATA, ///< DAC buffer transfer (ZMODDAC1411::setData)
+	ZMOD_PERF_FLASH_READ, ///< I2C flash read in the backend (successful on Linux) (fnReadFlash)
+	ZMOD_PERF_FLASH_WRITE, ///< I2C flash write in the backend (successful on Linux) (fnWriteFlash)
+	ZMOD_PERF_OP_COUNT, ///< number of operations
+};
+
+/**
+ * Struct containing the latency statistics of an operation.
+ */
+typedef struct _ZMODPerfStats {
+	uint64_t count; ///< number of operations
+	uint64_t totalNs; ///< sum of the latencies, in nanoseconds
+	uint64_t maxNs; ///< maximum latency, in nanoseconds
+	uint64_t buckets[ZMOD_PERF_BUCKETS]; ///< latency histogram, see ZMOD_PERF_BUCKETS
+} ZMODPerfStats;
+
+void fnPerfRecord(enum zmod_perf_op op, uint64_t ns);
+void fnPerfSnapshot(ZMODPerfStats *stats);
+void fnPerfReset();
+const char *fnPerfOpName(enum zmod_perf_op op);
+uint64_t fnPerfBucketUpperNs(uint32_t bucket);
+uint64_t fnPerfPercentileNs(const ZMODPerfStats *stats, double percentile);
+
+#ifdef ZMOD_PERF
+#include "timer.h"
+/// Start timing an operation, declaring the local variable holding the start time.
+#define ZMOD_PERF_BEGIN(start) uint64_t start = fnGetTimeNs()
+/// Record the latency of an operation started with ZMOD_PERF_BEGIN.
+#define ZMOD_PERF_END(op, start) fnPerfRecord((op), fnGetTimeNs() - (start))
+/// Record a latency measured by other means.
+#define ZMOD_PERF_RECORD(op, ns) fnPerfRecord((op), (ns))
+#else
+#define ZMOD_PERF_BEGIN(start)
+#define ZMOD_PERF_END(op, start)
+#define ZMOD_PERF_RECORD(op, ns)
+#endif
+
+#endif /* PERF_H_ */
@@ -0,0 +1,301 @@
+/**
+ * @file regtrace.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the optional recording of the device accesses of the driver.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "regtrace.h"
+#include "timer.h"
+#include "zmod.h"
+
+#ifdef ZMOD_REGTRACE
+static ZMODRegTraceRecord *traceRecords = NULL; ///< the trace, NULL before the first start
+static uint32_t traceCapacity = 0; ///< capacity of the trace, in records
+static uint32_t traceCount = 0; ///< number of records reserved, may exceed the capacity
+static bool traceEnabled = false; ///< whether the accesses are recorded
+static uint32_t traceWriters = 0; ///< number of fnRegTraceRecord calls recording, waited for by fnRegTraceStop
+static uintptr_t traceHandles[ZMOD_REGTRACE_MAX_DEVICES]; ///< [device index] handle
+static uint8_t traceKinds[ZMOD_REGTRACE_MAX_DEVICES]; ///< [device index] zmod_regtrace_device
+static uint32_t traceDevices = 0; ///< number of devices seen, published once their handle and kind are written
+static uint32_t traceDevicesLock = 0; ///< held while a device is introduced
+
+/**
+ * Append a record to the trace, if there is room.
+ *
+ * @param type the zmod_regtrace_type
+ * @param device the index of the device
+ * @param addr the address
+ * @param value the value
+ */
+static void fnRegTraceAppend(uint8_t type, uint8_t device, uint16_t addr, uint32_t value)
+{
+	uint32_t index = __atomic_fetch_add(&traceCount, 1, __ATOMIC_RELAXED);
+
+	if(index < traceCapacity)
+	{
+		ZMODRegTraceRecord *record = &traceRecords[index];
+		record->timeNs = fnGetTimeNs();
+		record->value = value;
+		record->addr = addr;
+		record->type = type;
+		record->device = device;
+	}
+}
+
+/**
+ * Find the index of a device already introduced in the trace.
+ *
+ * @param kind the zmod_regtrace_device
+ * @param handle the handle of the device
+ * @param devices the number of devices to search
+ *
+ * @return the index of the device, devices if it is not found
+ */
+static uint32_t fnRegTraceFindDevice(uint8_t kind, uintptr_t handle, uint32_t devices)
+{
+	for(uint32_t i = 0; i < devices; i++)
+	{
+		if(traceHandles[i] == handle && traceKinds[i] == kind)
+		{
+			return i;
+		}
+	}
+	return devices;
+}
+
+/**
+ * Get the index of a device, introducing it in the trace the first time it is seen.
+ * The devices are searched without locking; introducing one is serialized between
+ * the recording threads, so that a device gets a single index.
+ *
+ * @param kind the zmod_regtrace_device
+ * @param handle the handle of the device, as returned by the fnInit* functions
+ *
+ * @return the index of the device, ZMOD_REGTRACE_MAX_DEVICES when there are too many devices
+ */
+static uint8_t fnRegTraceDevice(uint8_t kind, uintptr_t handle)
+{
+	uint32_t devices = __atomic_load_n(&traceDevices, __ATOMIC_ACQUIRE);
+	uint32_t index = fnRegTraceFindDevice(kind, handle, devices);
+	uint32_t expected = 0;
+
+	if(index < devices)
+	{
+		return index;
+	}
+	while(!__atomic_compare_exchange_n(&traceDevicesLock, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+	{
+		expected = 0;
+	}
+	// another thread may have introduced it meanwhile
+	devices = traceDevices;
+	index = fnRegTraceFindDevice(kind, handle, devices);
+	if(index == devices)
+	{
+		if(devices >= ZMOD_REGTRACE_MAX_DEVICES)
+		{
+			index = ZMOD_REGTRACE_MAX_DEVICES;
+		}
+		else
+		{
+			traceHandles[index] = handle;
+			traceKinds[index] = kind;
+			fnRegTraceAppend(ZMOD_REGTRACE_DEVICE, index, kind, (uint32_t)handle);
+			__atomic_store_n(&traceDevices, devices + 1, __ATOMIC_RELEASE);
+		}
+	}
+	__atomic_store_n(&traceDevicesLock, 0, __ATOMIC_RELEASE);
+	return index;
+}
+#endif
+
+/**
+ * Start recording the device accesses, discarding the previous trace.
+ *
+ * @param capacity the maximum number of records, the next ones are counted as dropped
+ *
+ * @return ERR_SUCCESS on success, ERR_FAIL if the trace cannot be allocated or the
+ *  recording is not compiled in
+ */
+int fnRegTraceStart(uint32_t capacity)
+{
+#ifdef ZMOD_REGTRACE
+	ZMODRegTraceRecord *records = (ZMODRegTraceRecord *)malloc(capacity * sizeof(ZMODRegTraceRecord));
+
+	if(!records)
+	{
+		return ERR_FAIL;
+	}
+	fnRegTraceStop(); // no writer uses the previous trace after this
+	free(traceRecords);
+	traceRecords = records;
+	traceCapacity = capacity;
+	traceDevices = 0;
+	traceCount = 0;
+	__atomic_store_n(&traceEnabled, true, __ATOMIC_RELEASE);
+	return ERR_SUCCESS;
+#else
+	(void)capacity;
+	return ERR_FAIL;
+#endif
+}
+
+/**
+ * Stop recording the device accesses; the trace is kept until the next fnRegTraceStart.
+ * Waits for the accesses being recorded by other threads, so that the trace is complete
+ * and no longer written on return. Must not be called from an interrupt handler.
+ */
+void fnRegTraceStop()
+{
+#ifdef ZMOD_REGTRACE
+	__atomic_store_n(&traceEnabled, false, __ATOMIC_SEQ_CST);
+	while(__atomic_load_n(&traceWriters, __ATOMIC_SEQ_CST))
+	{
+	}
+#endif
+}
+
+/**
+ * Record a device access, usually through the ZMOD_REGTRACE* macros.
+ * Does nothing when not recording.
+ *
+ * @param type the zmod_regtrace_type
+ * @param handle the handle of the device, as returned by the fnInit* functions
+ * @param addr the address, see zmod_regtrace_type
+ * @param value the value, see zmod_regtrace_type
+ */
+void fnRegTraceRecord(enum zmod_regtrace_type type, uintptr_t handle, uint16_t addr, uint32_t value)
+{
+#ifdef ZMOD_REGTRACE
+	uint8_t kind;
+
+	if(!__atomic_load_n(&traceEnabled, __ATOMIC_ACQUIRE))
+	{
+		return;
+	}
+	// announce the write before checking again, fnRegTraceStop clears the flag then waits for the writers
+	__atomic_fetch_add(&traceWriters, 1, __ATOMIC_SEQ_CST);
+	if(!__atomic_load_n(&traceEnabled, __ATOMIC_SEQ_CST))
+	{
+		__atomic_fetch_sub(&traceWriters, 1, __ATOMIC_RELEASE);
+		return;
+	}
+	switch(type)
+	{
+	case ZMOD_REGTRACE_DMA_START:
+	case ZMOD_REGTRACE_DMA_COMPLETE:
+		kind = ZMOD_REGTRACE_DEV_DMA;
+		break;
+	case ZMOD_REGTRACE_FLASH_READ:
+	case ZMOD_REGTRACE_FLASH_WRITE:
+		kind = ZMOD_REGTRACE_DEV_FLASH;
+		break;
+	default:
+		kind = ZMOD_REGTRACE_DEV_ZMOD;
+		break;
+	}
+	fnRegTraceAppend(type, fnRegTraceDevice(kind, handle), addr, value);
+	__atomic_fetch_sub(&traceWriters, 1, __ATOMIC_RELEASE);
+#else
+	(void)type;
+	(void)handle;
+	(void)addr;
+	(void)value;
+#endif
+}
+
+/**
+ * Get the records of the trace.
+ *
+ * @param count receives the number of records
+ * @param dropped receives the number of records lost because the trace was full, can be NULL
+ *
+ * @return the records, NULL if there is no trace
+ */
+const ZMODRegTraceRecord *fnRegTraceGetRecords(uint32_t *count, uint32_t *dropped)
+{
+#ifdef ZMOD_REGTRACE
+	uint32_t reserved = __atomic_load_n(&traceCount, __ATOMIC_RELAXED);
+
+	*count = reserved < traceCapacity ? reserved : traceCapacity;
+	if(dropped)
+	{
+		*dropped = reserved - *count;
+	}
+	return traceRecords;
+#else
+	*count = 0;
+	if(dropped)
+	{
+		*dropped = 0;
+	}
+	return NULL;
+#endif
+}
+
+/**
+ * Save the trace to a file, see regtrace.h for the format.
+ *
+ * @param path the path of the file
+ *
+ * @return ERR_SUCCESS on success, ERR_FAIL on failure
+ */
+int fnRegTraceSave(const char *path)
+{
+	ZMODRegTraceHeader header;
+	const ZMODRegTraceRecord *records;
+	FILE *file;
+	int status = ERR_SUCCESS;
+
+	records = fnRegTraceGetRecords(&header.count, &header.dropped);
+	if(!records)
+	{
+		return ERR_FAIL;
+	}
+	header.magic = ZMOD_REGTRACE_MAGIC;
+	header.version = ZMOD_REGTRACE_VERSION;
+	header.recordSize = sizeof(ZMODRegTraceRecord);
+
+	file = fopen(path, "wb");
+	if(!file)
+	{
+		return ERR_FAIL;
+	}
+	if(fwrite(&header, sizeof(header), 1, file) != 1 ||
+			fwrite(records, sizeof(ZMODRegTraceRecord), header.count, file) != header.count)
+	{
+		status = ERR_FAIL;
+	}
+	if(fclose(file))
+	{
+		status = ERR_FAIL;
+	}
+	return status;
+}
+
+/**
+ * Get the name of a high-level call, for reports.
+ *
+ * @param api the high-level call
+ *
+ * @return the name of the call
+ */
+const char *fnRegTraceApiName(enum zmod_regtrace_api api)
+{
+	static const char *names[ZMOD_REGTRACE_API_COUNT] = {
+		"set_trigger",
+		"read_user_calib",
+		"write_user_calib",
+		"send_commands",
+		"receive_commands",
+		"set_gain",
+		"set_coupling",
+		"adc_acquire",
+		"dac_set_data",
+	};
+
+	return (unsigned)api < ZMOD_REGTRACE_API_COUNT ? names[api] : "unknown";
+}
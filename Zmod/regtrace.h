@@ -0,0 +1,113 @@
+/**
+ * @file regtrace.h
+ * @date 16 Oct 2026
+ * @brief Declarations of the optional recording of the device accesses of the driver.
+ *
+ * The recording is compiled in when ZMOD_REGTRACE is defined (for example -DZMOD_REGTRACE);
+ * otherwise the ZMOD_REGTRACE* macros expand to nothing. Once started with fnRegTraceStart,
+ * every register read and write, DMA transfer start and completion and flash access done through
+ * the ZMOD class is appended, with its time, to an in-memory trace, together with the begin
+ * and end of the high-level calls (setTrigger, readUserCalib, sendCommands...) they belong to.
+ * The trace can then be saved to a compact binary file (fnRegTraceSave) and replayed offline
+ * against the fake platform by tools/regreplay.cpp, which counts the redundant accesses of each
+ * high-level call.
+ *
+ * File format, little endian: a ZMODRegTraceHeader followed by header.count ZMODRegTraceRecord.
+ * A device is identified in the records by a small index, introduced by a
+ * ZMOD_REGTRACE_DEVICE record before its first access.
+ */
+
+#ifndef REGTRACE_H_
+#define REGTRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ZMOD_REGTRACE_MAGIC		0x54524D5A	///< "ZMRT", magic number of the trace files
+#define ZMOD_REGTRACE_VERSION	1			///< version of the trace file format
+#define ZMOD_REGTRACE_MAX_DEVICES	32		///< maximum number of devices of a trace
+
+/**
+ * Types of the trace records.
+ */
+enum zmod_regtrace_type {
+	ZMOD_REGTRACE_DEVICE, ///< new device: addr is the zmod_regtrace_device kind, value the low 32 bits of the handle
+	ZMOD_REGTRACE_REG_WRITE, ///< register write: addr is the register offset, value the value written
+	ZMOD_REGTRACE_REG_READ, ///< register read: addr is the register offset, value the value read
+	ZMOD_REGTRACE_DMA_START, ///< DMA transfer start: value is the transfer size, in bytes
+	ZMOD_REGTRACE_DMA_COMPLETE, ///< DMA transfer completion seen
+	ZMOD_REGTRACE_FLASH_READ, ///< flash read: addr is the flash address, value the length, in bytes
+	ZMOD_REGTRACE_FLASH_WRITE, ///< flash write: addr is the flash address, value the length, in bytes
+	ZMOD_REGTRACE_API_BEGIN, ///< begin of a high-level call: value is the zmod_regtrace_api
+	ZMOD_REGTRACE_API_END, ///< end of a high-level call: value is the zmod_regtrace_api
+	ZMOD_REGTRACE_TYPE_COUNT, ///< number of record types
+};
+
+/**
+ * Kinds of the traced devices.
+ */
+enum zmod_regtrace_device {
+	ZMOD_REGTRACE_DEV_ZMOD, ///< ZMOD IP registers
+	ZMOD_REGTRACE_DEV_DMA, ///< DMA
+	ZMOD_REGTRACE_DEV_FLASH, ///< calibration flash
+};
+
+/**
+ * High-level calls delimited in the trace.
+ */
+enum zmod_regtrace_api {
+	ZMOD_REGTRACE_API_SET_TRIGGER, ///< ZMODADC1410::setTrigger
+	ZMOD_REGTRACE_API_READ_USER_CALIB, ///< ZMODADC1410::readUserCalib, ZMODDAC1411::readUserCalib
+	ZMOD_REGTRACE_API_WRITE_USER_CALIB, ///< ZMOD::writeUserCalib
+	ZMOD_REGTRACE_API_SEND_COMMANDS, ///< ZMOD::sendCommands
+	ZMOD_REGTRACE_API_RECEIVE_COMMANDS, ///< ZMOD::receiveCommands
+	ZMOD_REGTRACE_API_SET_GAIN, ///< ZMODADC1410::setGain, ZMODDAC1411::setGain
+	ZMOD_REGTRACE_API_SET_COUPLING, ///< ZMODADC1410::setCoupling
+	ZMOD_REGTRACE_API_ADC_ACQUIRE, ///< ZMODADC1410 polling acquisition
+	ZMOD_REGTRACE_API_DAC_SET_DATA, ///< ZMODDAC1411::setData
+	ZMOD_REGTRACE_API_COUNT, ///< number of high-level calls
+};
+
+/**
+ * Struct containing the header of a trace file.
+ */
+typedef struct _ZMODRegTraceHeader {
+	uint32_t magic; ///< ZMOD_REGTRACE_MAGIC
+	uint16_t version; ///< ZMOD_REGTRACE_VERSION
+	uint16_t recordSize; ///< sizeof(ZMODRegTraceRecord)
+	uint32_t count; ///< number of records
+	uint32_t dropped; ///< number of records lost because the trace was full
+} ZMODRegTraceHeader;
+
+/**
+ * Struct containing a trace record.
+ */
+typedef struct _ZMODRegTraceRecord {
+	uint64_t timeNs; ///< time of the access, see fnGetTimeNs
+	uint32_t value; ///< value, see zmod_regtrace_type
+	uint16_t addr; ///< address, see zmod_regtrace_type
+	uint8_t type; ///< zmod_regtrace_type
+	uint8_t device; ///< index of the device
+} ZMODRegTraceRecord;
+
+int fnRegTraceStart(uint32_t capacity);
+void fnRegTraceStop();
+void fnRegTraceRecord(enum zmod_regtrace_type type, uintptr_t handle, uint16_t addr, uint32_t value);
+const ZMODRegTraceRecord *fnRegTraceGetRecords(uint32_t *count, uint32_t *dropped);
+int fnRegTraceSave(const char *path);
+const char *fnRegTraceApiName(enum zmod_regtrace_api api);
+
+#ifdef ZMOD_REGTRACE
+/// Record a device access.
+#define ZMOD_REGTRACE_RECORD(type, handle, addr, value) fnRegTraceRecord((type), (handle), (addr), (value))
+/// Record the begin of a high-level call on the ZMOD device handle.
+#define ZMOD_REGTRACE_BEGIN(api, handle) fnRegTraceRecord(ZMOD_REGTRACE_API_BEGIN, (handle), 0, (api))
+/// Record the end of a high-level call on the ZMOD device handle.
+#define ZMOD_REGTRACE_END(api, handle) fnRegTraceRecord(ZMOD_REGTRACE_API_END, (handle), 0, (api))
+#else
+#define ZMOD_REGTRACE_RECORD(type, handle, addr, value)
+#define ZMOD_REGTRACE_BEGIN(api, handle)
+#define ZMOD_REGTRACE_END(api, handle)
+#endif
+
+#endif /* REGTRACE_H_ */
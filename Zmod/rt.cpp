@@ -0,0 +1,291 @@
+/**
+ * @file rt.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the real-time deterministic mode of the acquisition thread.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "rt.h"
+#include "timer.h"
+#include "zmod.h"
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif // LINUX_APP || FAKE_APP
+
+static bool fRtEnabled = false; ///< whether fnRtEnter succeeded
+
+#ifdef ZMOD_ALLOC_CHECK
+#include <new>
+
+static uint64_t heapCalls = 0; ///< number of heap calls, see fnRtGetUsage
+
+// With -Wl,--wrap=malloc (and so on), the linker resolves the calls to malloc of the
+// application and of the library to __wrap_malloc, and __real_malloc to the C library.
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size)
+{
+	__atomic_fetch_add(&heapCalls, 1, __ATOMIC_RELAXED);
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+	__atomic_fetch_add(&heapCalls, 1, __ATOMIC_RELAXED);
+	return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	__atomic_fetch_add(&heapCalls, 1, __ATOMIC_RELAXED);
+	return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr)
+{
+	if(ptr)
+	{
+		__atomic_fetch_add(&heapCalls, 1, __ATOMIC_RELAXED);
+	}
+	__real_free(ptr);
+}
+}
+
+// The C++ runtime calls malloc from its own shared library, out of reach of --wrap,
+// so new and delete are replaced to go through the wrapped functions.
+void *operator new(size_t size)
+{
+	void *ptr = malloc(size ? size : 1);
+	if(!ptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	free(ptr);
+}
+#endif // ZMOD_ALLOC_CHECK
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+/**
+ * Touch a stack area, so that its pages are mapped before the steady state.
+ */
+static void fnRtPrefaultStack()
+{
+	volatile uint8_t stack[ZMOD_RT_STACK_PREFAULT];
+
+	for(size_t i = 0; i < sizeof(stack); i += 512)
+	{
+		stack[i] = 0;
+	}
+}
+
+/**
+ * Prepare the process and the calling thread for the real-time mode: lock the current and
+ * future memory, pin the thread to a CPU, set its SCHED_FIFO priority and pre-fault its stack.
+ * Locking the memory and changing the priority usually need privileges (CAP_IPC_LOCK,
+ * CAP_SYS_NICE or matching RLIMIT_MEMLOCK and RLIMIT_RTPRIO limits).
+ *
+ * @param config the configuration of the real-time mode
+ *
+ * @return ERR_SUCCESS on success, ERR_FAIL if a step failed (the previous steps stay applied)
+ */
+int fnRtEnter(const ZMODRtConfig *config)
+{
+	if(mlockall(MCL_CURRENT | MCL_FUTURE))
+	{
+		return ERR_FAIL;
+	}
+	if(config->cpu != ZMOD_RT_CPU_ANY)
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(config->cpu, &cpus);
+		if(pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus))
+		{
+			return ERR_FAIL;
+		}
+	}
+	if(config->priority)
+	{
+		struct sched_param param;
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = config->priority;
+		if(pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+		{
+			return ERR_FAIL;
+		}
+	}
+	fnRtPrefaultStack();
+	fRtEnabled = true;
+
+	return ERR_SUCCESS;
+}
+
+/**
+ * Pre-fault a buffer: touch each of its pages, keeping the content, so that they are
+ * mapped (and locked, after fnRtEnter) before the steady state.
+ *
+ * @param buf the address of the buffer
+ * @param size the size of the buffer, in bytes
+ */
+void fnRtPrefault(void *buf, size_t size)
+{
+	volatile uint8_t *bytes = (volatile uint8_t *)buf;
+	size_t pageSize = sysconf(_SC_PAGESIZE);
+
+	if(!buf)
+	{
+		return;
+	}
+	for(size_t i = 0; i < size; i += pageSize)
+	{
+		bytes[i] = bytes[i];
+	}
+	if(size)
+	{
+		bytes[size - 1] = bytes[size - 1];
+	}
+}
+
+/**
+ * Read the resource usage of the calling thread.
+ *
+ * @param usage receives the resource usage
+ */
+void fnRtGetUsage(ZMODRtUsage *usage)
+{
+	struct rusage ru;
+
+	memset(usage, 0, sizeof(ZMODRtUsage));
+#ifdef ZMOD_ALLOC_CHECK
+	usage->heapCalls = __atomic_load_n(&heapCalls, __ATOMIC_RELAXED);
+#endif // ZMOD_ALLOC_CHECK
+	if(!getrusage(RUSAGE_THREAD, &ru))
+	{
+		usage->minorFaults = ru.ru_minflt;
+		usage->majorFaults = ru.ru_majflt;
+		usage->voluntarySwitches = ru.ru_nvcsw;
+		usage->involuntarySwitches = ru.ru_nivcsw;
+	}
+}
+#else
+/**
+ * Prepare for the real-time mode. Nothing is needed on the baremetal platform.
+ *
+ * @param config the configuration of the real-time mode, ignored
+ *
+ * @return ERR_SUCCESS
+ */
+int fnRtEnter(const ZMODRtConfig *)
+{
+	fRtEnabled = true;
+	return ERR_SUCCESS;
+}
+
+/**
+ * Pre-fault a buffer. Nothing is needed on the baremetal platform.
+ *
+ * @param buf the address of the buffer, ignored
+ * @param size the size of the buffer, in bytes, ignored
+ */
+void fnRtPrefault(void *, size_t)
+{
+}
+
+/**
+ * Read the resource usage. Only the heap calls are available on the baremetal platform.
+ *
+ * @param usage receives the resource usage
+ */
+void fnRtGetUsage(ZMODRtUsage *usage)
+{
+	memset(usage, 0, sizeof(ZMODRtUsage));
+#ifdef ZMOD_ALLOC_CHECK
+	usage->heapCalls = __atomic_load_n(&heapCalls, __ATOMIC_RELAXED);
+#endif // ZMOD_ALLOC_CHECK
+}
+#endif // LINUX_APP || FAKE_APP
+
+/**
+ * Check whether the real-time mode was entered.
+ *
+ * @return true after a successful fnRtEnter
+ */
+bool fnRtIsEnabled()
+{
+	return fRtEnabled;
+}
+
+/**
+ * Start measuring the period of a loop.
+ *
+ * @param jitter the period statistics
+ */
+void fnRtJitterReset(ZMODRtJitter *jitter)
+{
+	jitter->last = 0;
+	jitter->count = 0;
+	jitter->minNs = UINT64_MAX;
+	jitter->maxNs = 0;
+}
+
+/**
+ * Mark an iteration of a loop, measuring the period since the previous mark.
+ *
+ * @param jitter the period statistics
+ */
+void fnRtJitterTick(ZMODRtJitter *jitter)
+{
+	uint64_t now = fnGetTimeNs();
+
+	if(jitter->last)
+	{
+		uint64_t period = now - jitter->last;
+		if(period < jitter->minNs)
+		{
+			jitter->minNs = period;
+		}
+		if(period > jitter->maxNs)
+		{
+			jitter->maxNs = period;
+		}
+		jitter->count++;
+	}
+	jitter->last = now;
+}
+
+/**
+ * Get the worst-case jitter of a loop: the difference between its longest and its shortest period.
+ *
+ * @param jitter the period statistics
+ *
+ * @return the jitter in nanoseconds, 0 if less than 2 periods were measured
+ */
+uint64_t fnRtJitterWorstNs(const ZMODRtJitter *jitter)
+{
+	return jitter->count < 2 ? 0 : jitter->maxNs - jitter->minNs;
+}
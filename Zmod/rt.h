@@ -0,0 +1,73 @@
+/**
+ * @file rt.h
+ * @date 16 Oct 2026
+ * @brief Declarations of the real-time deterministic mode of the acquisition thread.
+ *
+ * fnRtEnter prepares the process and the calling thread up front: it locks all the current
+ * and future memory (mlockall), pins the thread to a CPU, optionally runs it under
+ * SCHED_FIFO and pre-faults its stack. The DMA buffers allocated afterwards are pre-faulted
+ * as well (see ZMOD::allocDMABuffer); fnRtPrefault pre-faults the other work buffers.
+ *
+ * The steady-state path of ZMODADC1410::acquirePolling and of ZMODDAC1411::setData then
+ * only accesses the mapped registers and issues the DMA ioctl. The processing classes
+ * allocate their buffers in their constructors, or at the first use (AcquisitionBlock),
+ * so one warm-up iteration must run before the steady state.
+ * This can be verified with fnRtGetUsage, taken before and after the steady state: the
+ * page faults and context switches come from getrusage, and the heap calls from the
+ * allocation counter, compiled in debug builds with -DZMOD_ALLOC_CHECK and linked with
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free.
+ * ZMODRtJitter measures the worst-case jitter of the period of a loop.
+ *
+ * On the baremetal platform, which has no paging nor scheduler, fnRtEnter and fnRtPrefault
+ * do nothing, and only the heap calls are reported.
+ */
+
+#ifndef RT_H_
+#define RT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ZMOD_RT_CPU_ANY			-1			///< do not change the CPU affinity of the thread
+#define ZMOD_RT_STACK_PREFAULT	(64 * 1024)	///< bytes of stack pre-faulted by fnRtEnter
+
+/**
+ * Struct containing the configuration of the real-time mode.
+ */
+typedef struct _ZMODRtConfig {
+	int cpu; ///< CPU the calling thread is pinned to, ZMOD_RT_CPU_ANY to keep its affinity
+	int priority; ///< SCHED_FIFO priority of the calling thread (1 to 99), 0 to keep its policy
+} ZMODRtConfig;
+
+/**
+ * Struct containing the resource usage of the calling thread, to be compared before and
+ * after a steady state.
+ */
+typedef struct _ZMODRtUsage {
+	uint64_t heapCalls; ///< malloc, calloc, realloc and free calls of the process, 0 unless built with ZMOD_ALLOC_CHECK
+	uint64_t minorFaults; ///< page faults served without I/O
+	uint64_t majorFaults; ///< page faults that required I/O
+	uint64_t voluntarySwitches; ///< context switches because the thread blocked (in a system call)
+	uint64_t involuntarySwitches; ///< context switches because the thread was preempted
+} ZMODRtUsage;
+
+/**
+ * Struct containing the period statistics of a loop, updated by fnRtJitterTick.
+ */
+typedef struct _ZMODRtJitter {
+	uint64_t last; ///< time of the last tick, 0 before the first one
+	uint64_t count; ///< number of periods measured
+	uint64_t minNs; ///< shortest period, in nanoseconds
+	uint64_t maxNs; ///< longest period, in nanoseconds
+} ZMODRtJitter;
+
+int fnRtEnter(const ZMODRtConfig *config);
+bool fnRtIsEnabled();
+void fnRtPrefault(void *buf, size_t size);
+void fnRtGetUsage(ZMODRtUsage *usage);
+
+void fnRtJitterReset(ZMODRtJitter *jitter);
+void fnRtJitterTick(ZMODRtJitter *jitter);
+uint64_t fnRtJitterWorstNs(const ZMODRtJitter *jitter);
+
+#endif /* RT_H_ */
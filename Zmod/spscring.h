@@ -0,0 +1,227 @@
+/**
+ * @file spscring.h
+ * @date 16 Oct 2026
+ * @brief Wait-free single-producer single-consumer ring, used to hand buffers between threads.
+ *
+ * One thread pushes and one thread pops, without locks: each side only writes its own index,
+ * and publishes the slots with a release store of it. The producer index and the consumer
+ * index sit on separate cache lines, each with the cached copy of the other index, so the
+ * two sides only exchange cache lines when the cached copy says the ring looks full or empty.
+ * Batch push and pop publish several elements with a single index store.
+ *
+ * For a drop-oldest policy, the producer can also take the oldest element back with
+ * dropOldest; the consumer of such a ring must then pop with popShared, which claims the
+ * elements with a compare-and-swap of its index instead of a store (lock-free, no longer wait-free).
+ */
+
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define SPSCRING_CACHE_LINE	64	///< cache line size, the separation between the producer and consumer fields
+
+/**
+ * Wait-free single-producer single-consumer ring of elements of type T, which must be
+ * trivially copyable (typically pointers or small handles). The capacity is rounded up
+ * to a power of 2.
+ */
+template<typename T>
+class SPSCRing {
+private:
+	T *slots; ///< [capacity] elements
+	size_t mask; ///< capacity - 1
+	uint8_t pad0[SPSCRING_CACHE_LINE];
+
+	// producer cache line
+	size_t head; ///< number of elements pushed, written by the producer only
+	size_t cachedTail; ///< last value of tail seen by the producer
+	uint8_t pad1[SPSCRING_CACHE_LINE - 2 * sizeof(size_t)];
+
+	// consumer cache line
+	size_t tail; ///< number of elements popped, written by the consumer only (and by dropOldest)
+	size_t cachedHead; ///< last value of head seen by the consumer
+	uint8_t pad2[SPSCRING_CACHE_LINE - 2 * sizeof(size_t)];
+
+	SPSCRing(const SPSCRing &);
+	SPSCRing &operator=(const SPSCRing &);
+
+public:
+	/**
+	 * Create an empty ring, to be allocated with init.
+	 */
+	SPSCRing() : slots(NULL), mask(0), head(0), cachedTail(0), tail(0), cachedHead(0) {
+	}
+
+	/**
+	 * Allocate a ring.
+	 * @param capacity the minimum number of elements of the ring, rounded up to a power of 2
+	 */
+	SPSCRing(size_t capacity) : slots(NULL), mask(0), head(0), cachedTail(0), tail(0), cachedHead(0) {
+		init(capacity);
+	}
+
+	~SPSCRing() {
+		free(slots);
+	}
+
+	/**
+	 * Allocate the ring, emptying it. Not thread safe.
+	 * @param capacity the minimum number of elements of the ring, rounded up to a power of 2
+	 * @return true on success, false if the memory could not be allocated
+	 */
+	bool init(size_t capacity) {
+		size_t size = 1;
+		while(size < capacity)
+		{
+			size <<= 1;
+		}
+		free(slots);
+		slots = (T *)malloc(size * sizeof(T));
+		mask = slots ? size - 1 : 0;
+		head = cachedTail = tail = cachedHead = 0;
+		return slots != NULL;
+	}
+
+	/**
+	 * Check if the ring was allocated.
+	 * @return true if the ring can be used
+	 */
+	bool isValid() {
+		return slots != NULL;
+	}
+
+	/**
+	 * Get the number of elements the ring can hold.
+	 * @return the capacity
+	 */
+	size_t getCapacity() {
+		return slots ? mask + 1 : 0;
+	}
+
+	/**
+	 * Get the number of elements in the ring. Exact from the producer or the consumer
+	 *  when the other side is idle, otherwise a snapshot.
+	 * @return the number of elements
+	 */
+	size_t getCount() {
+		return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+	}
+
+	/**
+	 * Push elements (producer only). Pushes as many elements as there is room for.
+	 * @param items the elements to push
+	 * @param count the number of elements to push
+	 * @return the number of elements pushed
+	 */
+	size_t push(const T *items, size_t count) {
+		size_t h = head;
+		size_t room = getCapacity() - (h - cachedTail);
+		if(room < count)
+		{
+			cachedTail = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+			room = getCapacity() - (h - cachedTail);
+		}
+		if(count > room)
+		{
+			count = room;
+		}
+		for(size_t i = 0; i < count; i++)
+		{
+			// atomic, as popShared may read a slot it then fails to claim
+			__atomic_store(&slots[(h + i) & mask], &items[i], __ATOMIC_RELAXED);
+		}
+		__atomic_store_n(&head, h + count, __ATOMIC_RELEASE);
+		return count;
+	}
+
+	/**
+	 * Push an element (producer only).
+	 * @param item the element to push
+	 * @return true if the element was pushed, false if the ring is full
+	 */
+	bool push(const T &item) {
+		return push(&item, 1) == 1;
+	}
+
+	/**
+	 * Pop elements (consumer only). Pops as many elements as available.
+	 * @param items receives the elements
+	 * @param count the maximum number of elements to pop
+	 * @return the number of elements popped
+	 */
+	size_t pop(T *items, size_t count) {
+		size_t t = tail;
+		size_t available = cachedHead - t;
+		if(available < count)
+		{
+			cachedHead = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+			available = cachedHead - t;
+		}
+		if(count > available)
+		{
+			count = available;
+		}
+		for(size_t i = 0; i < count; i++)
+		{
+			items[i] = slots[(t + i) & mask];
+		}
+		__atomic_store_n(&tail, t + count, __ATOMIC_RELEASE);
+		return count;
+	}
+
+	/**
+	 * Pop an element (consumer only).
+	 * @param item receives the element
+	 * @return true if an element was popped, false if the ring is empty
+	 */
+	bool pop(T &item) {
+		return pop(&item, 1) == 1;
+	}
+
+	/**
+	 * Pop elements (consumer only) on a ring where the producer may call dropOldest.
+	 * @param items receives the elements
+	 * @param count the maximum number of elements to pop
+	 * @return the number of elements popped
+	 */
+	size_t popShared(T *items, size_t count) {
+		size_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+		size_t n;
+		do
+		{
+			size_t available = __atomic_load_n(&head, __ATOMIC_ACQUIRE) - t;
+			n = count > available ? available : count;
+			for(size_t i = 0; i < n; i++)
+			{
+				__atomic_load(&slots[(t + i) & mask], &items[i], __ATOMIC_RELAXED);
+			}
+			// on failure, t receives the index moved by dropOldest
+		} while(n && !__atomic_compare_exchange_n(&tail, &t, t + n, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+		return n;
+	}
+
+	/**
+	 * Take back the oldest element (producer only), to make room for a new one. The consumer
+	 * must pop with popShared.
+	 * @param item receives the element
+	 * @return true if an element was taken, false if the ring is empty
+	 */
+	bool dropOldest(T &item) {
+		size_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+		while(t != head)
+		{
+			__atomic_load(&slots[t & mask], &item, __ATOMIC_RELAXED);
+			if(__atomic_compare_exchange_n(&tail, &t, t + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			{
+				cachedTail = t + 1;
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+#endif /* SPSCRING_H_ */
@@ -0,0 +1,14 @@
+/**
+ * @file timer.h
+ * @date 16 Oct 2026
+ * @brief Function declarations used for time stamping.
+ */
+
+#ifndef TIMER_H_
+#define TIMER_H_
+
+#include <stdint.h>
+
+uint64_t fnGetTimeNs();
+
+#endif /* TIMER_H_ */
@@ -0,0 +1,46 @@
+/**
+ * @file trace.h
+ * @date 16 Oct 2026
+ * @brief Static tracepoints (USDT) of the driver.
+ *
+ * On Linux, when <sys/sdt.h> (systemtap-sdt-dev) is available at build time, the ZMOD_TRACE*
+ * macros place SystemTap SDT probes of the "zmod" provider, that perf, bpftrace or SystemTap
+ * can attach to in a running process, for example:
+ *  bpftrace -e 'usdt:./app:zmod:dma_start { printf("%x %d\n", arg0, arg2); }'
+ * A probe is a single nop instruction until it is attached, and adds no runtime dependency.
+ * Otherwise, or when ZMOD_NO_TRACE is defined, the macros expand to nothing.
+ *
+ * Probes:
+ *  - dma_start(dma device address, buffer, bytes)
+ *  - dma_complete(dma device address, dma channel id)
+ *  - adc_start(zmod device address), adc_stop(zmod device address)
+ *  - adc_buffer_full(zmod device address, ns since start)
+ *  - dac_start(zmod device address), dac_stop(zmod device address)
+ *  - send_commands(zmod device address, number of commands)
+ *  - flash_read(i2c slave address, flash address, bytes, status),
+ *    flash_write(i2c slave address, flash address, bytes, status)
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#if defined(LINUX_APP) && !defined(ZMOD_NO_TRACE) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define ZMOD_TRACE_ENABLED
+#endif
+#endif
+
+#ifdef ZMOD_TRACE_ENABLED
+#define ZMOD_TRACE1(name, a1) DTRACE_PROBE1(zmod, name, a1)
+#define ZMOD_TRACE2(name, a1, a2) DTRACE_PROBE2(zmod, name, a1, a2)
+#define ZMOD_TRACE3(name, a1, a2, a3) DTRACE_PROBE3(zmod, name, a1, a2, a3)
+#define ZMOD_TRACE4(name, a1, a2, a3, a4) DTRACE_PROBE4(zmod, name, a1, a2, a3, a4)
+#else
+#define ZMOD_TRACE1(name, a1)
+#define ZMOD_TRACE2(name, a1, a2)
+#define ZMOD_TRACE3(name, a1, a2, a3)
+#define ZMOD_TRACE4(name, a1, a2, a3, a4)
+#endif
+
+#endif /* TRACE_H_ */
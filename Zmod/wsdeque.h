@@ -0,0 +1,142 @@
+/**
+ * @file wsdeque.h
+ * @date 16 Oct 2026
+ * @brief Work-stealing deque (Chase-Lev), used to balance tasks between worker threads.
+ *
+ * The owner thread pushes and takes tasks at the bottom, in LIFO order, without contention
+ * in the common case; the other threads steal tasks at the top, in FIFO order, with a
+ * compare-and-swap. Only the take of the last task races with the thieves, and is settled
+ * by the same compare-and-swap. The capacity is fixed: the owner must not push more tasks
+ * than it holds. This is the C11 formulation of Le, Pop, Cohen and Zappa Nardelli
+ * ("Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013), with the
+ * __atomic builtins.
+ */
+
+#ifndef WSDEQUE_H_
+#define WSDEQUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define WSDEQUE_CACHE_LINE	64	///< cache line size, the separation between the owner and thief fields
+
+/**
+ * Work-stealing deque of elements of type T, which must be trivially copyable and lock-free
+ * for the __atomic builtins (at most 8 bytes). The capacity is rounded up to a power of 2.
+ */
+template<typename T>
+class WSDeque {
+private:
+	T *slots; ///< [capacity] tasks
+	int64_t mask; ///< capacity - 1
+	uint8_t pad0[WSDEQUE_CACHE_LINE];
+	int64_t top; ///< index of the oldest task, incremented by the thieves and the take of the last task
+	uint8_t pad1[WSDEQUE_CACHE_LINE - sizeof(int64_t)];
+	int64_t bottom; ///< index after the newest task, written by the owner only
+	uint8_t pad2[WSDEQUE_CACHE_LINE - sizeof(int64_t)];
+
+	WSDeque(const WSDeque &);
+	WSDeque &operator=(const WSDeque &);
+
+public:
+	/**
+	 * Create an empty deque, to be allocated with init.
+	 */
+	WSDeque() : slots(NULL), mask(0), top(0), bottom(0) {
+	}
+
+	~WSDeque() {
+		free(slots);
+	}
+
+	/**
+	 * Allocate the deque, emptying it. Not thread safe.
+	 * @param capacity the minimum number of tasks of the deque, rounded up to a power of 2
+	 * @return true on success, false if the memory could not be allocated
+	 */
+	bool init(size_t capacity) {
+		size_t size = 1;
+		while(size < capacity)
+		{
+			size <<= 1;
+		}
+		free(slots);
+		slots = (T *)malloc(size * sizeof(T));
+		mask = slots ? (int64_t)size - 1 : -1;
+		top = bottom = 0;
+		return slots != NULL;
+	}
+
+	/**
+	 * Push a task at the bottom (owner only).
+	 * @param item the task
+	 * @return true if the task was pushed, false if the deque is full
+	 */
+	bool push(const T &item) {
+		int64_t b = __atomic_load_n(&bottom, __ATOMIC_RELAXED);
+		int64_t t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+		if(b - t > mask)
+		{
+			return false;
+		}
+		__atomic_store(&slots[b & mask], &item, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		__atomic_store_n(&bottom, b + 1, __ATOMIC_RELAXED);
+		return true;
+	}
+
+	/**
+	 * Take the newest task (owner only).
+	 * @param item receives the task
+	 * @return true if a task was taken, false if the deque is empty
+	 */
+	bool take(T &item) {
+		int64_t b = __atomic_load_n(&bottom, __ATOMIC_RELAXED) - 1;
+		__atomic_store_n(&bottom, b, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		int64_t t = __atomic_load_n(&top, __ATOMIC_RELAXED);
+		if(t > b)
+		{
+			// empty
+			__atomic_store_n(&bottom, b + 1, __ATOMIC_RELAXED);
+			return false;
+		}
+		__atomic_load(&slots[b & mask], &item, __ATOMIC_RELAXED);
+		if(t == b)
+		{
+			// last task, race with the thieves
+			bool won = __atomic_compare_exchange_n(&top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+			__atomic_store_n(&bottom, b + 1, __ATOMIC_RELAXED);
+			return won;
+		}
+		return true;
+	}
+
+	/**
+	 * Steal the oldest task (any thread but the owner).
+	 * @param item receives the task
+	 * @return true if a task was stolen, false if the deque is empty or the race was lost
+	 */
+	bool steal(T &item) {
+		int64_t t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		int64_t b = __atomic_load_n(&bottom, __ATOMIC_ACQUIRE);
+		if(t >= b)
+		{
+			return false;
+		}
+		__atomic_load(&slots[t & mask], &item, __ATOMIC_RELAXED);
+		return __atomic_compare_exchange_n(&top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * Check whether the deque looks empty, a snapshot when other threads use it.
+	 * @return true if no task is visible
+	 */
+	bool isEmpty() {
+		return __atomic_load_n(&top, __ATOMIC_ACQUIRE) >= __atomic_load_n(&bottom, __ATOMIC_ACQUIRE);
+	}
+};
+
+#endif /* WSDEQUE_H_ */
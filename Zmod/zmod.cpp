@@ -12,6 +12,11 @@
 #include "dma.h"
 #include "zmod.h"
 #include "flash.h"
+#include "timer.h"
+#include "perf.h"
+#include "regtrace.h"
+#include "rt.h"
+#include "trace.h"
 
 void fnZmodInterruptHandler(void *data);
 
@@ -52,7 +57,11 @@ ZMOD::ZMOD(uintptr_t baseAddress, uintptr_t dmaAddress, uintptr_t iicAddress, ui
 	flashAddr = fnInitFlash(iicAddress, flashAddress);
 
 	this->direction = direction;
+	deviceAddr = baseAddress;
+	dmaDeviceAddr = dmaAddress;
 	transferSize = 0;
+	memset(&timestamps, 0, sizeof(timestamps));
+	fnMetricsInit(&metrics);
 	calib = 0;	// this will be later allocated by allocCalib
 
 	// toggle reset bit
@@ -84,6 +93,7 @@ ZMOD::~ZMOD() {
  *  specified by its offset address.
  */
 void ZMOD::writeReg(uint8_t regAddr, uint32_t value) {
+	ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_REG_WRITE, baseAddr, regAddr, value);
 	fnWriteReg(baseAddr, regAddr, value);
 }
 
@@ -98,7 +108,9 @@ void ZMOD::writeReg(uint8_t regAddr, uint32_t value) {
  *  specified by its offset address.
  */
 uint32_t ZMOD::readReg(uint8_t regAddr) {
-	return fnReadReg(baseAddr, regAddr);
+	uint32_t value = fnReadReg(baseAddr, regAddr);
+	ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_REG_READ, baseAddr, regAddr, value);
+	return value;
 }
 
 /**
@@ -112,6 +124,7 @@ uint32_t ZMOD::readReg(uint8_t regAddr) {
  *  bits starting at lsbBit (inclusive) and ending at lsbBit + noBits (exclusive)
  */
 void ZMOD::writeRegFld(uint8_t regAddr, uint8_t lsbBit, uint8_t noBits, uint32_t value) {
+	ZMOD_PERF_BEGIN(perfStart);
 	uint32_t regMask = ((1 << noBits) - 1) << lsbBit;
 	uint32_t regValue = readReg(regAddr);
 
@@ -128,6 +141,7 @@ void ZMOD::writeRegFld(uint8_t regAddr, uint8_t lsbBit, uint8_t noBits, uint32_t
 	regValue |= value;
 
 	writeReg(regAddr, regValue);
+	ZMOD_PERF_END(ZMOD_PERF_REG_WRITE_FLD, perfStart);
 }
 
 /**
@@ -213,14 +227,20 @@ void ZMOD::processInterrupt(){
 }
 
 /**
- * Allocate a DMA buffer.
+ * Allocate a DMA buffer. In the real-time mode (see fnRtEnter), the buffer is pre-faulted.
  *
  * @param size the size of the DMA buffer, in bytes
  *
  * @return the address of the DMA buffer
  */
 void* ZMOD::allocDMABuffer(size_t size) {
-	return fnAllocBuffer(dmaAddr, size);
+	void *buf = fnAllocBuffer(dmaAddr, size);
+
+	if(buf && fnRtIsEnabled())
+	{
+		fnRtPrefault(buf, size);
+	}
+	return buf;
 }
 
 /**
@@ -260,6 +280,11 @@ int ZMOD::startDMATransfer(uint32_t* buffer) {
 		return ERR_FAIL;
 	}
 
+	// also called by the buffer full interrupt handler
+	__atomic_store_n(&timestamps.dmaStart, fnGetTimeNs(), __ATOMIC_RELAXED);
+	__atomic_store_n(&timestamps.dmaComplete, 0, __ATOMIC_RELAXED);
+	ZMOD_TRACE3(dma_start, dmaDeviceAddr, buffer, transferSize);
+	ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_DMA_START, dmaAddr, 0, transferSize);
 	return fnOneWayDMATransfer(dmaAddr, buffer, transferSize);
 }
 
@@ -269,7 +294,57 @@ int ZMOD::startDMATransfer(uint32_t* buffer) {
  * @return true if the DMA transfer completed, false if it is still running
  */
 bool ZMOD::isDMATransferComplete() {
-	return fnIsDMATransferComplete(dmaAddr);
+	if (!fnIsDMATransferComplete(dmaAddr)) {
+		return false;
+	}
+	if (!__atomic_load_n(&timestamps.dmaComplete, __ATOMIC_RELAXED)) {
+		// the time captured by the DMA interrupt, or the time the completion is seen
+		uint64_t complete = fnGetDMATransferCompleteTime(dmaAddr);
+		if (!complete) {
+			complete = fnGetTimeNs();
+		}
+		__atomic_store_n(&timestamps.dmaComplete, complete, __ATOMIC_RELAXED);
+		ZMOD_PERF_RECORD(ZMOD_PERF_DMA_TRANSFER, complete - __atomic_load_n(&timestamps.dmaStart, __ATOMIC_RELAXED));
+		ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_DMA_COMPLETE, dmaAddr, 0, 0);
+		fnMetricsAdd(&metrics.acquisitions, 1);
+		fnMetricsAdd(&metrics.bytesTransferred, transferSize);
+	}
+	return true;
+}
+
+/**
+ * Get the times of the steps of the last acquisition (or generation):
+ * start, buffer full, DMA transfer start and completion.
+ *
+ * @return a copy of the timestamps
+ */
+ZMODTimestamps ZMOD::getTimestamps() {
+	ZMODTimestamps snapshot;
+
+	snapshot.arm = timestamps.arm;
+	snapshot.bufferFull = __atomic_load_n(&timestamps.bufferFull, __ATOMIC_RELAXED);
+	snapshot.dmaStart = __atomic_load_n(&timestamps.dmaStart, __ATOMIC_RELAXED);
+	snapshot.dmaComplete = __atomic_load_n(&timestamps.dmaComplete, __ATOMIC_RELAXED);
+	return snapshot;
+}
+
+/**
+ * Take a snapshot of the running metrics of the ZMOD, including the DMA errors reported
+ * by the platform. Only reads the metrics, so it can be called from another thread
+ * without delaying the acquisitions.
+ *
+ * @param snapshot receives the metrics
+ */
+void ZMOD::getMetrics(ZMODMetrics &snapshot) {
+	fnMetricsSnapshot(&metrics, &snapshot);
+	snapshot.dmaErrors = fnGetDMAErrorCount(dmaAddr);
+}
+
+/**
+ * Count an acquisition that stopped waiting for a trigger, in the metrics.
+ */
+void ZMOD::countTimeout() {
+	fnMetricsAdd(&metrics.timeouts, 1);
 }
 
 /**
@@ -302,6 +377,9 @@ void ZMOD::sendCommands(uint32_t *commands, size_t length) {
 	if (!commands) {
 		return;
 	}
+	ZMOD_PERF_BEGIN(perfStart);
+	ZMOD_TRACE2(send_commands, deviceAddr, length);
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_SEND_COMMANDS, baseAddr);
 
 	// Write each command to the internal FIFO
 	for (size_t i = 0; i < length; i++) {
@@ -315,6 +393,8 @@ void ZMOD::sendCommands(uint32_t *commands, size_t length) {
 	// Wait until the internal FIFO is empty
 	while(!readRegFld(ZMOD_REGFLD_SR_CMD_TX_DONE)) {}
 	writeRegFld(ZMOD_REGFLD_SR_CMD_TX_DONE, 1);
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_SEND_COMMANDS, baseAddr);
+	ZMOD_PERF_END(ZMOD_PERF_SEND_COMMANDS, perfStart);
 }
 
 /**
@@ -328,6 +408,8 @@ size_t ZMOD::receiveCommands(uint32_t *commands) {
 	if (!commands) {
 		return 0;
 	}
+	ZMOD_PERF_BEGIN(perfStart);
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_RECEIVE_COMMANDS, baseAddr);
 
 	// Get the number of bytes present in the RX FIFO
 	size_t length = readRegFld(ZMOD_REGFLD_SR_CMD_RX_COUNT);
@@ -336,6 +418,8 @@ size_t ZMOD::receiveCommands(uint32_t *commands) {
 	for (size_t i = 0; i < length; i++) {
 		commands[i] = receiveCommand();
 	}
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_RECEIVE_COMMANDS, baseAddr);
+	ZMOD_PERF_END(ZMOD_PERF_RECEIVE_COMMANDS, perfStart);
 
 	return length;
 }
@@ -371,6 +455,7 @@ int ZMOD::readUserCalib()
 	int status;
 	uint8_t crc;
 	// read the user calibration data as an array of bytes
+	ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_FLASH_READ, flashAddr, userCalibAddr, calibSize);
 	status = fnReadFlash(flashAddr, userCalibAddr, calib, calibSize);
 	if(status == ERR_SUCCESS)
 	{
@@ -379,6 +464,7 @@ int ZMOD::readUserCalib()
 		{
 			// Calib ID error
 			status = ERR_CALIB_ID;
+			fnMetricsAdd(&metrics.calibIdErrors, 1);
 		}
 		else
 		{
@@ -388,6 +474,7 @@ int ZMOD::readUserCalib()
 			{
 				// CRC error
 				status = ERR_CALIB_CRC;
+				fnMetricsAdd(&metrics.calibCrcErrors, 1);
 			}
 		}
 	}
@@ -436,7 +523,10 @@ void ZMOD::writeUserCalib()
 	// fill the checksum byte on the last byte of calib area
 	calib[calibSize] = crc;
 
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_WRITE_USER_CALIB, baseAddr);
+	ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_FLASH_WRITE, flashAddr, userCalibAddr, calibSize);
 	fnWriteFlash(flashAddr, userCalibAddr, calib, calibSize);
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_WRITE_USER_CALIB, baseAddr);
 }
 
 /**
@@ -449,6 +539,7 @@ int ZMOD::restoreFactoryCalib()
 	// reads the factory calibration into calib as an array of bytes
 	int status;
 	// read the user calibration data as an array of bytes
+	ZMOD_REGTRACE_RECORD(ZMOD_REGTRACE_FLASH_READ, flashAddr, factCalibAddr, calibSize);
 	status = fnReadFlash(flashAddr, factCalibAddr, calib, calibSize);
 	if(status == ERR_SUCCESS)
 	{
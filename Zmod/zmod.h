@@ -10,6 +10,7 @@
 
 #include "dma.h"
 #include "reg.h"
+#include "metrics.h"
 
 #ifndef _ZMOD_H
 #define  _ZMOD_H
@@ -46,6 +47,19 @@
 #define ZMOD_REGFLD_AXIS_S2MM_LENGTH_LENGTH	ZMOD_REG_ADDR_AXIS_S2MM_LENGTH, 0, 26	///< LENGTH field of AXIS_S2MM_LENGTH register
 #define ZMOD_REGFLD_AXIS_MM2S_LENGTH_LENGTH ZMOD_REG_ADDR_AXIS_MM2S_LENGTH, 0, 26	///< LENGTH field of AXIS_MM2S_LENGTH register
 
+/**
+ * Struct containing the times of the steps of the last acquisition (or generation),
+ * in nanoseconds (see fnGetTimeNs); 0 for the steps that did not happen yet.
+ * The interrupt handlers write bufferFull, dmaStart and dmaComplete, so these fields are
+ * accessed with the __atomic builtins (a 64-bit access is not atomic on 32-bit ARM).
+ */
+typedef struct _ZMODTimestamps {
+	uint64_t arm; ///< time the ZMOD was started (armed)
+	uint64_t bufferFull; ///< time the buffer full was detected (polling) or interrupted
+	uint64_t dmaStart; ///< time the DMA transfer was started
+	uint64_t dmaComplete; ///< time the DMA transfer completed, captured by the DMA interrupt when available
+} ZMODTimestamps;
+
 /**
  * Class containing functionality common to all ZMODs.
  */
@@ -53,6 +67,8 @@ class ZMOD {
 protected:
 	uintptr_t 	baseAddr; ///< Zmod base address
 	uintptr_t 	dmaAddr; ///< DMA environment pointer
+	uintptr_t 	deviceAddr; ///< physical base address of the ZMOD device, as given to the constructor
+	uintptr_t 	dmaDeviceAddr; ///< physical base address of the DMA device, as given to the constructor
 	uintptr_t 	flashAddr; ///< Flash  base address
 	size_t	transferSize; ///< DMA transfer size
 	uint8_t *calib; ///< pointer to calibration data
@@ -61,6 +77,8 @@ protected:
 	uint16_t factCalibAddr;///< address of factory calibration area
 	uint8_t calibID; ///< calibration ID
 	enum dma_direction direction; ///< DMA tranfer direction
+	ZMODTimestamps timestamps; ///< times of the steps of the last acquisition
+	ZMODMetrics metrics; ///< running metrics, updated atomically
 	int initCalib(uint32_t calibSize, uint8_t calibID, uint32_t userCalibAddr,uint32_t factCalibAddr);
 	void* allocDMABuffer(size_t size);
 	void freeDMABuffer(uint32_t *buf, size_t size);
@@ -69,7 +87,7 @@ protected:
 public:
 	ZMOD(uintptr_t baseAddress, uintptr_t dmaAddress, uintptr_t iicAddress, uintptr_t flashAddress,
 			enum dma_direction direction, int zmodInterrupt, int dmaInterrupt);
-	~ZMOD();
+	virtual ~ZMOD();
 
 	void writeReg(uint8_t regAddr, uint32_t value);
 	void writeRegFld(uint8_t regAddr, uint8_t lsbBit, uint8_t noBits, uint32_t value);
@@ -82,6 +100,9 @@ public:
 	void setTransferSize(size_t size);
 	int startDMATransfer(uint32_t* buffer);
 	bool isDMATransferComplete();
+	ZMODTimestamps getTimestamps();
+	void getMetrics(ZMODMetrics &snapshot);
+	void countTimeout();
 
 	void sendCommand(uint32_t command);
 	uint32_t receiveCommand();
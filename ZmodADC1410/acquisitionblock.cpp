@@ -0,0 +1,286 @@
+/**
+ * @file acquisitionblock.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the acquisition block methods.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "acquisitionblock.h"
+#include "adctrigger.h"
+#include "../Zmod/timer.h"
+
+/**
+ * Create an acquisition block, allocating its raw DMA buffer.
+ * The length of the allocated buffer is limited to the maximum supported buffer length (0x3FFF),
+ * altering the value of the reference parameter accordingly.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param length the number of elements (samples) in the buffer - passed by reference
+ */
+AcquisitionBlock::AcquisitionBlock(ZMODADC1410 *adc, size_t &length)
+{
+	this->adc = adc;
+	buffer = adc->allocChannelsBuffer(length);
+	bufferLength = buffer ? length : 0;
+	ownBuffer = true;
+	memset(signedData, 0, sizeof(signedData));
+	memset(voltData, 0, sizeof(voltData));
+	memset(&info, 0, sizeof(info));
+	info.length = bufferLength;
+	invalidate();
+}
+
+/**
+ * Create an acquisition block over an existing raw DMA buffer.
+ * The buffer is not freed when the block is destroyed.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param buffer the raw DMA buffer, normally allocated using allocChannelsBuffer
+ * @param length the number of elements (samples) in the buffer
+ */
+AcquisitionBlock::AcquisitionBlock(ZMODADC1410 *adc, uint32_t *buffer, size_t length)
+{
+	this->adc = adc;
+	this->buffer = buffer;
+	bufferLength = length;
+	ownBuffer = false;
+	memset(signedData, 0, sizeof(signedData));
+	memset(voltData, 0, sizeof(voltData));
+	memset(&info, 0, sizeof(info));
+	info.length = bufferLength;
+	invalidate();
+}
+
+/**
+ * Acquisition block destructor. Frees the channel data and, if owned, the raw DMA buffer.
+ */
+AcquisitionBlock::~AcquisitionBlock()
+{
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		free(signedData[channel]);
+		free(voltData[channel]);
+	}
+	if(ownBuffer && buffer)
+	{
+		adc->freeChannelsBuffer(buffer, bufferLength);
+	}
+}
+
+/**
+ * Fill the acquisition settings, reading the gain and coupling from the ADC.
+ *
+ * @param channel the trigger channel
+ * @param mode the trigger mode
+ * @param level the trigger level
+ * @param edge the trigger edge
+ * @param window the window position
+ */
+void AcquisitionBlock::fillInfo(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window)
+{
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		info.gain[ch] = adc->getGain(ch);
+		info.coupling[ch] = adc->getCoupling(ch);
+	}
+	info.trigChannel = channel;
+	info.trigMode = mode;
+	info.trigLevel = level;
+	info.trigEdge = edge;
+	info.window = window;
+	info.length = bufferLength;
+	info.triggerTime = 0;
+}
+
+/**
+ * Acquire a triggered buffer into the block, using a polling method, will block until
+ * the acquisition completes. The parameters are the ones of ZMODADC1410::acquireTriggeredPolling,
+ * the length being the one of the block.
+ *
+ * @param channel the channel for which trigger is set: 0 for channel 1,
+ *  1 for channel 2
+ * @param level the level on which to run the data acquisition,
+ *  can be any valid 14bit unsigned number
+ * @param edge the trigger edge at which to run the data acquisition,
+ *  0 for rising edge, 1 for falling edge
+ * @param window the window position at which to run the data acquisition,
+ *  can be any unsigned number smaller than length
+ *
+ * @return 0 on success, any other number on failure
+ */
+uint8_t AcquisitionBlock::acquireTriggeredPolling(uint8_t channel, uint32_t level, uint32_t edge, uint32_t window)
+{
+	uint8_t status;
+
+	invalidate();
+	status = adc->acquireTriggeredPolling(buffer, channel, level, edge, window, bufferLength);
+	fillInfo(channel, 0, (int16_t)level, edge, window);
+	info.triggerTime = fnInterpolateTrigger(buffer, info.length, channel, info.trigLevel, edge, window,
+			ADC_INTERPOLATION_CUBIC);
+	info.times = adc->getTimestamps();
+	info.timestamp = fnGetTimeNs();
+	return status;
+}
+
+/**
+ * Acquire an immediate buffer into the block, using a polling method, will block until
+ * the acquisition completes.
+ *
+ * @return 0 on success, any other number on failure
+ */
+uint8_t AcquisitionBlock::acquireImmediatePolling()
+{
+	uint8_t status;
+	size_t length = bufferLength;
+
+	invalidate();
+	status = adc->acquireImmediatePolling(buffer, length);
+	fillInfo(0, 1, 0, 0, 0);
+	info.times = adc->getTimestamps();
+	info.timestamp = fnGetTimeNs();
+	return status;
+}
+
+/**
+ * Mark the channel data as outdated. Must be called when the raw buffer is changed
+ * outside the block methods (for example by a DMA transfer started by the caller).
+ */
+void AcquisitionBlock::invalidate()
+{
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		signedValid[channel] = false;
+		voltValid[channel] = false;
+	}
+}
+
+/**
+ * Set the acquisition settings, when the raw buffer is filled outside the block methods.
+ * The channel data is marked as outdated.
+ *
+ * @param info the settings and time of the acquisition
+ */
+void AcquisitionBlock::setInfo(const AcquisitionInfo &info)
+{
+	this->info = info;
+	if(this->info.length > bufferLength)
+	{
+		this->info.length = bufferLength;
+	}
+	invalidate();
+}
+
+/**
+ * Get the raw DMA buffer of the block.
+ *
+ * @return the raw DMA buffer
+ */
+uint32_t *AcquisitionBlock::getRawBuffer()
+{
+	return buffer;
+}
+
+/**
+ * Get the number of samples of the last acquisition.
+ *
+ * @return the number of samples
+ */
+size_t AcquisitionBlock::getLength()
+{
+	return info.length;
+}
+
+/**
+ * Get the settings and time of the last acquisition.
+ *
+ * @return the acquisition settings
+ */
+const AcquisitionInfo &AcquisitionBlock::getInfo()
+{
+	return info;
+}
+
+/**
+ * Get the signed raw data of a channel, converting it from the raw buffer if needed.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ *
+ * @return the contiguous signed raw data of the channel, NULL on allocation failure
+ */
+const int16_t *AcquisitionBlock::getSignedChannel(uint8_t channel)
+{
+	channel = channel ? 1 : 0;
+	if(!signedData[channel])
+	{
+		signedData[channel] = (int16_t *)malloc(bufferLength * sizeof(int16_t));
+		if(!signedData[channel])
+		{
+			return NULL;
+		}
+	}
+	if(!signedValid[channel])
+	{
+		adc->signedChannelsData(channel, buffer, signedData[channel], info.length);
+		signedValid[channel] = true;
+	}
+	return signedData[channel];
+}
+
+/**
+ * Get the Volts data of a channel, converting it from the raw buffer if needed,
+ * using the gain of the channel at the moment of the acquisition.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ *
+ * @return the contiguous Volts data of the channel, NULL on allocation failure
+ */
+const float *AcquisitionBlock::getVoltChannel(uint8_t channel)
+{
+	const int16_t *raw;
+
+	channel = channel ? 1 : 0;
+	if(!voltData[channel])
+	{
+		voltData[channel] = (float *)malloc(bufferLength * sizeof(float));
+		if(!voltData[channel])
+		{
+			return NULL;
+		}
+	}
+	if(!voltValid[channel])
+	{
+		raw = getSignedChannel(channel);
+		if(!raw)
+		{
+			return NULL;
+		}
+		adc->getVoltsFromSignedRaw(raw, voltData[channel], info.length, info.gain[channel]);
+		voltValid[channel] = true;
+	}
+	return voltData[channel];
+}
+
+/**
+ * Get the Volts data of a channel resampled so that the interpolated trigger crossing
+ * (see AcquisitionInfo::triggerTime) lands exactly on the window sample, to overlay or average
+ * acquisitions without the jitter of the sample grid. Acquisitions without trigger are copied unchanged.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param data the buffer receiving the aligned data, of at least getLength() elements
+ * @param interpolation the interpolation, see adc_interpolation
+ *
+ * @return 0 on success, any other number on failure
+ */
+uint8_t AcquisitionBlock::getAlignedVoltChannel(uint8_t channel, float *data, uint8_t interpolation)
+{
+	const float *volt = getVoltChannel(channel);
+	double shift = info.trigMode ? 0 : info.triggerTime - info.window;
+
+	if(!volt)
+	{
+		return ERR_FAIL;
+	}
+	fnShiftSamples(volt, data, info.length, shift, interpolation);
+	return ERR_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file acquisitionblock.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the acquisition block, holding the data of a ZMOD ADC1410 acquisition.
+ */
+
+#include "zmodadc1410.h"
+#include "adcview.h"
+
+#ifndef _ACQUISITIONBLOCK_H
+#define  _ACQUISITIONBLOCK_H
+
+/**
+ * Struct containing the settings and time of an acquisition.
+ */
+typedef struct _AcquisitionInfo {
+	uint8_t gain[2]; ///< [channel 0:1] gain: 0 for LOW gain, 1 for HIGH gain
+	uint8_t coupling[2]; ///< [channel 0:1] coupling: 0 for DC Coupling, 1 for AC Coupling
+	uint8_t trigChannel; ///< trigger channel: 0 for channel 1, 1 for channel 2
+	uint8_t trigMode; ///< trigger mode: 0 for normal trigger, 1 for not trigger
+	uint8_t trigEdge; ///< trigger edge: 0 for rising edge, 1 for falling edge
+	int16_t trigLevel; ///< trigger level, signed raw value
+	uint32_t window; ///< window position (index of the trigger sample in the buffer)
+	double triggerTime; ///< interpolated position of the trigger crossing in the buffer, in samples (see fnInterpolateTrigger), 0 for not trigger
+	size_t length; ///< number of samples in the buffer
+	uint64_t timestamp; ///< time when the acquisition completed, in nanoseconds (see fnGetTimeNs)
+	ZMODTimestamps times; ///< times of the acquisition steps (of the last hardware acquisition, when several are combined)
+} AcquisitionInfo;
+
+/**
+ * Class holding the raw data of a ZMOD ADC1410 acquisition, together with its settings.
+ * The per channel signed raw and Volts data is converted from the raw data only when
+ * it is first requested, and kept until the raw data changes, so that any number of
+ * consumers can use contiguous channel data while the conversion is done at most once.
+ * The conversion is not protected against concurrent calls: when a block is shared
+ * between threads, request the needed channel data before sharing it.
+ */
+class AcquisitionBlock {
+private:
+	ZMODADC1410 *adc; ///< the ADC used for acquisition and conversion
+	uint32_t *buffer; ///< raw DMA buffer
+	size_t bufferLength; ///< number of elements allocated in the raw DMA buffer
+	bool ownBuffer; ///< whether the raw DMA buffer is allocated (and will be freed) by the block
+	int16_t *signedData[2]; ///< [channel 0:1] signed raw data, NULL if not yet allocated
+	float *voltData[2]; ///< [channel 0:1] Volts data, NULL if not yet allocated
+	bool signedValid[2]; ///< [channel 0:1] whether signedData holds the conversion of buffer
+	bool voltValid[2]; ///< [channel 0:1] whether voltData holds the conversion of buffer
+	AcquisitionInfo info; ///< settings and time of the last acquisition
+
+	void fillInfo(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window);
+
+public:
+	AcquisitionBlock(ZMODADC1410 *adc, size_t &length);
+	AcquisitionBlock(ZMODADC1410 *adc, uint32_t *buffer, size_t length);
+	~AcquisitionBlock();
+	AcquisitionBlock(const AcquisitionBlock &) = delete; ///< not copyable, owns its buffers
+	AcquisitionBlock &operator=(const AcquisitionBlock &) = delete; ///< not copyable, owns its buffers
+
+	uint8_t acquireTriggeredPolling(uint8_t channel, uint32_t level, uint32_t edge, uint32_t window);
+	uint8_t acquireImmediatePolling();
+
+	void invalidate();
+	void setInfo(const AcquisitionInfo &info);
+
+	uint32_t *getRawBuffer();
+	size_t getLength();
+	const AcquisitionInfo &getInfo();
+	const int16_t *getSignedChannel(uint8_t channel);
+	const float *getVoltChannel(uint8_t channel);
+	uint8_t getAlignedVoltChannel(uint8_t channel, float *data, uint8_t interpolation);
+
+	/**
+	 * Create a lazy view over the signed raw data of a channel, converting on access
+	 *  instead of materializing the channel data (see adcview.h).
+	 * @param channel 0 for channel 1, 1 for channel 2
+	 * @return the view, valid as long as the block
+	 */
+	ADCChannelView<ADCRawConv> channel(uint8_t channel) {
+		return ADCChannelView<ADCRawConv>(buffer, info.length, 1, channel, ADCRawConv());
+	}
+};
+
+#endif
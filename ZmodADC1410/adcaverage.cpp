@@ -0,0 +1,273 @@
+/**
+ * @file adcaverage.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the trigger synchronous averaging of ZMOD ADC1410 acquisitions.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "adcaverage.h"
+#include "../Zmod/timer.h"
+
+/**
+ * Create an averaging accumulator, allocating its raw DMA buffer.
+ * The length is limited to the maximum supported buffer length (0x3FFF),
+ * altering the value of the reference parameter accordingly.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param length the number of samples of each acquisition - passed by reference
+ */
+ADCAverage::ADCAverage(ZMODADC1410 *adc, size_t &length)
+{
+	this->adc = adc;
+	buffer = adc->allocChannelsBuffer(length);
+	this->length = length;
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		sum[channel] = (int64_t *)malloc(length * sizeof(int64_t));
+		sumSq[channel] = (uint64_t *)malloc(length * sizeof(uint64_t));
+	}
+	memset(&info, 0, sizeof(info));
+	info.length = length;
+	reset();
+}
+
+/**
+ * Averaging accumulator destructor.
+ */
+ADCAverage::~ADCAverage()
+{
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		free(sum[channel]);
+		free(sumSq[channel]);
+	}
+	if(buffer)
+	{
+		adc->freeChannelsBuffer(buffer, length);
+	}
+}
+
+/**
+ * Check that all the buffers were allocated.
+ *
+ * @return true if the accumulator can be used
+ */
+bool ADCAverage::isValid()
+{
+	return buffer && sum[0] && sum[1] && sumSq[0] && sumSq[1];
+}
+
+/**
+ * Clear the accumulated acquisitions.
+ */
+void ADCAverage::reset()
+{
+	count = 0;
+	if(!isValid())
+	{
+		return;
+	}
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		memset(sum[channel], 0, length * sizeof(int64_t));
+		memset(sumSq[channel], 0, length * sizeof(uint64_t));
+	}
+}
+
+/**
+ * Add a raw buffer to the accumulated sums, in a loop without branches
+ * that is vectorized by the compiler.
+ *
+ * @param buffer the raw buffer of getLength() elements, as acquired from the ZMOD ADC1410
+ */
+void ADCAverage::accumulate(const uint32_t *buffer)
+{
+	int64_t *sum1 = sum[0], *sum2 = sum[1];
+	uint64_t *sumSq1 = sumSq[0], *sumSq2 = sumSq[1];
+	size_t n = length; // local copy, so that the stores are known not to alias it
+
+	if(!isValid())
+	{
+		return;
+	}
+	for(size_t i = 0; i < n; i++)
+	{
+		int32_t v1 = ZMODADC1410_SIGNED_CHANNEL_DATA(0, buffer[i]);
+		int32_t v2 = ZMODADC1410_SIGNED_CHANNEL_DATA(1, buffer[i]);
+		sum1[i] += v1;
+		sum2[i] += v2;
+		sumSq1[i] += (uint32_t)(v1 * v1);
+		sumSq2[i] += (uint32_t)(v2 * v2);
+	}
+	count++;
+}
+
+/**
+ * Acquire and accumulate a number of triggered acquisitions, using a polling method,
+ * will block until all the acquisitions complete. The trigger and transfer length are
+ * configured once; as soon as an acquisition is transferred, the ADC is armed for the
+ * next one, so the accumulation of an acquisition overlaps the acquisition of the next one.
+ * The parameters are the ones of ZMODADC1410::acquireTriggeredPolling.
+ *
+ * @param channel the channel for which trigger is set: 0 for channel 1,
+ *  1 for channel 2
+ * @param level the level on which to run the data acquisition,
+ *  can be any valid 14bit unsigned number
+ * @param edge the trigger edge at which to run the data acquisition,
+ *  0 for rising edge, 1 for falling edge
+ * @param window the window position at which to run the data acquisition,
+ *  can be any unsigned number smaller than length
+ * @param acquisitions the number of acquisitions to accumulate
+ *
+ * @return 0 on success, any other number on failure
+ */
+uint8_t ADCAverage::acquireTriggeredPolling(uint8_t channel, uint32_t level, uint32_t edge, uint32_t window, uint32_t acquisitions)
+{
+	size_t transferLength = length;
+
+	if(!isValid())
+	{
+		return ERR_FAIL;
+	}
+
+	// Set trigger data and DMA RX transfer length, once for all acquisitions
+	adc->setTrigger(channel, 0, level, edge, window);
+	adc->setTransferLength(transferLength);
+	adc->enableBufferFullInterrupt(0);
+
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		info.gain[ch] = adc->getGain(ch);
+		info.coupling[ch] = adc->getCoupling(ch);
+	}
+	info.trigChannel = channel;
+	info.trigMode = 0;
+	info.trigLevel = (int16_t)level;
+	info.trigEdge = edge;
+	info.window = window;
+	info.length = length;
+
+	// arm the first acquisition
+	adc->start();
+	for(uint32_t k = 0; k < acquisitions; k++)
+	{
+		adc->waitForBufferFullPolling();
+		if(adc->startDMATransfer(buffer))
+		{
+			return ERR_FAIL;
+		}
+		while(!adc->isDMATransferComplete()) {}
+
+		// arm the next acquisition before accumulating the current one
+		if(k + 1 < acquisitions)
+		{
+			adc->start();
+		}
+		accumulate(buffer);
+	}
+	info.times = adc->getTimestamps();
+	info.timestamp = fnGetTimeNs();
+
+	return ERR_SUCCESS;
+}
+
+/**
+ * Get the number of accumulated acquisitions.
+ *
+ * @return the number of acquisitions
+ */
+uint32_t ADCAverage::getCount()
+{
+	return count;
+}
+
+/**
+ * Get the number of samples of each acquisition.
+ *
+ * @return the number of samples
+ */
+size_t ADCAverage::getLength()
+{
+	return length;
+}
+
+/**
+ * Get the settings of the accumulated acquisitions, and the time of the last one.
+ *
+ * @return the acquisition settings
+ */
+const AcquisitionInfo &ADCAverage::getInfo()
+{
+	return info;
+}
+
+/**
+ * Get the averaged record of a channel, in signed raw units.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param mean the array receiving getLength() averaged samples
+ */
+void ADCAverage::getMean(uint8_t channel, float *mean)
+{
+	const int64_t *s = sum[channel ? 1 : 0];
+	double scale = count ? 1.0 / count : 0;
+
+	for(size_t i = 0; i < length; i++)
+	{
+		mean[i] = (float)((double)s[i] * scale);
+	}
+}
+
+/**
+ * Get the per sample variance of a channel (population variance), in squared signed raw units.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param variance the array receiving getLength() variances
+ */
+void ADCAverage::getVariance(uint8_t channel, float *variance)
+{
+	const int64_t *s = sum[channel ? 1 : 0];
+	const uint64_t *sq = sumSq[channel ? 1 : 0];
+
+	for(size_t i = 0; i < length; i++)
+	{
+		double mean = count ? (double)s[i] / count : 0;
+		double var = count ? (double)sq[i] / count - mean * mean : 0;
+		variance[i] = (float)(var > 0 ? var : 0);
+	}
+}
+
+/**
+ * Get the averaged record of a channel, in Volts, using the gain of the accumulated acquisitions.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param mean the array receiving getLength() averaged samples
+ */
+void ADCAverage::getMeanVolt(uint8_t channel, float *mean)
+{
+	float scale = ZMODADC1410_VOLT_PER_LSB(info.gain[channel ? 1 : 0]);
+
+	getMean(channel, mean);
+	for(size_t i = 0; i < length; i++)
+	{
+		mean[i] *= scale;
+	}
+}
+
+/**
+ * Get the per sample variance of a channel, in squared Volts, using the gain of the accumulated acquisitions.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param variance the array receiving getLength() variances
+ */
+void ADCAverage::getVarianceVolt(uint8_t channel, float *variance)
+{
+	float scale = ZMODADC1410_VOLT_PER_LSB(info.gain[channel ? 1 : 0]);
+
+	getVariance(channel, variance);
+	for(size_t i = 0; i < length; i++)
+	{
+		variance[i] *= scale * scale;
+	}
+}
@@ -0,0 +1,50 @@
+/**
+ * @file adcaverage.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the trigger synchronous averaging of ZMOD ADC1410 acquisitions.
+ */
+
+#include "zmodadc1410.h"
+#include "acquisitionblock.h"
+
+#ifndef _ADCAVERAGE_H
+#define  _ADCAVERAGE_H
+
+/**
+ * Class averaging many triggered acquisitions of the same window, sample by sample,
+ * to improve the signal to noise ratio of repetitive signals.
+ * The raw buffers are accumulated into 64 bits integer sums and sums of squares, directly from
+ * the packed elements, which gives the average record and the per sample variance. The sums
+ * cannot overflow before the 32 bits count of acquisitions does.
+ */
+class ADCAverage {
+private:
+	ZMODADC1410 *adc; ///< the ADC used for acquisition
+	uint32_t *buffer; ///< raw DMA buffer
+	size_t length; ///< number of samples of each acquisition
+	int64_t *sum[2]; ///< [channel 0:1] per sample sums
+	uint64_t *sumSq[2]; ///< [channel 0:1] per sample sums of squares
+	uint32_t count; ///< number of accumulated acquisitions
+	AcquisitionInfo info; ///< settings of the accumulated acquisitions
+
+public:
+	ADCAverage(ZMODADC1410 *adc, size_t &length);
+	~ADCAverage();
+	ADCAverage(const ADCAverage &) = delete; ///< not copyable, owns its buffers
+	ADCAverage &operator=(const ADCAverage &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	void reset();
+	void accumulate(const uint32_t *buffer);
+	uint8_t acquireTriggeredPolling(uint8_t channel, uint32_t level, uint32_t edge, uint32_t window, uint32_t acquisitions);
+
+	uint32_t getCount();
+	size_t getLength();
+	const AcquisitionInfo &getInfo();
+	void getMean(uint8_t channel, float *mean);
+	void getVariance(uint8_t channel, float *variance);
+	void getMeanVolt(uint8_t channel, float *mean);
+	void getVarianceVolt(uint8_t channel, float *variance);
+};
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * @file adcenvelope.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the min/max envelope decimation of ZMOD ADC1410 raw buffers.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "adcenvelope.h"
+
+/**
+ * Compute the min/max of a channel over consecutive buffer elements,
+ * in a loop without branches, vectorized by the compiler.
+ *
+ * @param buffer the first buffer element
+ * @param length the number of buffer elements, at least 1
+ * @param shift 0 for channel 1, 16 for channel 2
+ * @param min the location receiving the minimum
+ * @param max the location receiving the maximum
+ */
+static void fnMinMax(const uint32_t *buffer, size_t length, uint8_t shift, int16_t *min, int16_t *max)
+{
+	int16_t mn = INT16_MAX, mx = INT16_MIN;
+	for(size_t i = 0; i < length; i++)
+	{
+		int16_t v = (int16_t)((int32_t)(buffer[i] << shift) >> 18);
+		mn = (v < mn) ? v : mn;
+		mx = (v > mx) ? v : mx;
+	}
+	*min = mn;
+	*max = mx;
+}
+
+/**
+ * Compute the min/max of both channels over consecutive buffer elements,
+ * in a loop without branches, vectorized by the compiler.
+ *
+ * @param buffer the first buffer element
+ * @param length the number of buffer elements, at least 1
+ * @param mins the locations receiving the minimums of channel 1 and channel 2
+ * @param maxs the locations receiving the maximums of channel 1 and channel 2
+ */
+static void fnMinMaxChannels(const uint32_t *buffer, size_t length, int16_t *mins, int16_t *maxs)
+{
+	int16_t mn1 = INT16_MAX, mx1 = INT16_MIN, mn2 = INT16_MAX, mx2 = INT16_MIN;
+	for(size_t i = 0; i < length; i++)
+	{
+		int16_t v1 = ZMODADC1410_SIGNED_CHANNEL_DATA(0, buffer[i]);
+		int16_t v2 = ZMODADC1410_SIGNED_CHANNEL_DATA(1, buffer[i]);
+		mn1 = (v1 < mn1) ? v1 : mn1;
+		mx1 = (v1 > mx1) ? v1 : mx1;
+		mn2 = (v2 < mn2) ? v2 : mn2;
+		mx2 = (v2 > mx2) ? v2 : mx2;
+	}
+	mins[0] = mn1;
+	maxs[0] = mx1;
+	mins[1] = mn2;
+	maxs[1] = mx2;
+}
+
+/**
+ * Decimate the signed data of a channel into min/max pairs, one pair per bucket.
+ * The buffer is split in buckets of (almost) equal size: bucket i covers the elements
+ * from i * length / buckets (inclusive) to (i + 1) * length / buckets (exclusive).
+ * When there are more buckets than elements, a bucket covers its nearest element.
+ *
+ * @param buffer the raw buffer, as acquired from the ZMOD ADC1410
+ * @param length the number of elements in the buffer
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param mins the array receiving the minimum of each bucket
+ * @param maxs the array receiving the maximum of each bucket
+ * @param buckets the number of buckets (for example the number of display pixels)
+ */
+void fnDecimateMinMax(const uint32_t *buffer, size_t length, uint8_t channel,
+		int16_t *mins, int16_t *maxs, size_t buckets)
+{
+	uint8_t shift = channel ? 16 : 0;
+	if(!length)
+	{
+		return;
+	}
+	for(size_t i = 0; i < buckets; i++)
+	{
+		size_t start = (size_t)((uint64_t)i * length / buckets);
+		size_t end = (size_t)((uint64_t)(i + 1) * length / buckets);
+		if(end <= start)
+		{
+			end = start + 1;
+		}
+		fnMinMax(buffer + start, end - start, shift, &mins[i], &maxs[i]);
+	}
+}
+
+/**
+ * Decimate the signed data of both channels into min/max pairs, one pair per bucket,
+ * reading the buffer once. The buckets are the ones of fnDecimateMinMax.
+ *
+ * @param buffer the raw buffer, as acquired from the ZMOD ADC1410
+ * @param length the number of elements in the buffer
+ * @param mins1 the array receiving the minimum of each bucket, for channel 1
+ * @param maxs1 the array receiving the maximum of each bucket, for channel 1
+ * @param mins2 the array receiving the minimum of each bucket, for channel 2
+ * @param maxs2 the array receiving the maximum of each bucket, for channel 2
+ * @param buckets the number of buckets (for example the number of display pixels)
+ */
+void fnDecimateMinMaxChannels(const uint32_t *buffer, size_t length,
+		int16_t *mins1, int16_t *maxs1, int16_t *mins2, int16_t *maxs2, size_t buckets)
+{
+	int16_t mins[2], maxs[2];
+	if(!length)
+	{
+		return;
+	}
+	for(size_t i = 0; i < buckets; i++)
+	{
+		size_t start = (size_t)((uint64_t)i * length / buckets);
+		size_t end = (size_t)((uint64_t)(i + 1) * length / buckets);
+		if(end <= start)
+		{
+			end = start + 1;
+		}
+		fnMinMaxChannels(buffer + start, end - start, mins, maxs);
+		mins1[i] = mins[0];
+		maxs1[i] = maxs[0];
+		mins2[i] = mins[1];
+		maxs2[i] = maxs[1];
+	}
+}
+
+/**
+ * Create an envelope pyramid.
+ *
+ * @param capacity the maximum number of samples of the recording,
+ *  samples appended after the capacity is reached are ignored
+ * @param baseBucket the number of samples in a bucket of the finest level, 0 is treated as 1
+ */
+ADCEnvelope::ADCEnvelope(size_t capacity, size_t baseBucket)
+{
+	size_t buckets;
+
+	this->baseBucket = baseBucket ? baseBucket : 1;
+	this->capacity = capacity;
+	buckets = capacity / this->baseBucket;
+	memset(mins, 0, sizeof(mins));
+	memset(maxs, 0, sizeof(maxs));
+
+	// one level for each halving of the number of buckets, down to a single bucket
+	for(levels = 0; levels < ADCENVELOPE_MAX_LEVELS; levels++)
+	{
+		size_t levelBuckets = buckets >> levels;
+		if(levels && levelBuckets < 1)
+		{
+			break;
+		}
+		for(uint8_t channel = 0; channel < 2; channel++)
+		{
+			mins[levels][channel] = (int16_t *)malloc((levelBuckets + 1) * sizeof(int16_t));
+			maxs[levels][channel] = (int16_t *)malloc((levelBuckets + 1) * sizeof(int16_t));
+		}
+	}
+	reset();
+}
+
+/**
+ * Envelope pyramid destructor.
+ */
+ADCEnvelope::~ADCEnvelope()
+{
+	for(uint8_t level = 0; level < levels; level++)
+	{
+		for(uint8_t channel = 0; channel < 2; channel++)
+		{
+			free(mins[level][channel]);
+			free(maxs[level][channel]);
+		}
+	}
+}
+
+/**
+ * Drop all the samples appended, starting a new recording.
+ */
+void ADCEnvelope::reset()
+{
+	memset(count, 0, sizeof(count));
+	pendingCount = 0;
+	samples = 0;
+}
+
+/**
+ * Add a level 0 bucket and combine the completed pairs of buckets into the coarser levels.
+ *
+ * @param min1 the minimum of channel 1
+ * @param max1 the maximum of channel 1
+ * @param min2 the minimum of channel 2
+ * @param max2 the maximum of channel 2
+ */
+void ADCEnvelope::pushBucket(int16_t min1, int16_t max1, int16_t min2, int16_t max2)
+{
+	int16_t mn[2] = { min1, min2 };
+	int16_t mx[2] = { max1, max2 };
+
+	for(uint8_t level = 0; level < levels; level++)
+	{
+		size_t index = count[level];
+		if(!mins[level][0] || !maxs[level][0] || !mins[level][1] || !maxs[level][1])
+		{
+			return;
+		}
+		for(uint8_t channel = 0; channel < 2; channel++)
+		{
+			mins[level][channel][index] = mn[channel];
+			maxs[level][channel][index] = mx[channel];
+		}
+		count[level] = index + 1;
+		// a bucket of the next level is complete only after each pair of buckets
+		if(!(index & 1))
+		{
+			return;
+		}
+		for(uint8_t channel = 0; channel < 2; channel++)
+		{
+			int16_t prevMin = mins[level][channel][index - 1];
+			int16_t prevMax = maxs[level][channel][index - 1];
+			mn[channel] = (prevMin < mn[channel]) ? prevMin : mn[channel];
+			mx[channel] = (prevMax > mx[channel]) ? prevMax : mx[channel];
+		}
+	}
+}
+
+/**
+ * Append a raw buffer to the recording, updating all the levels.
+ *
+ * @param buffer the raw buffer, as acquired from the ZMOD ADC1410
+ * @param length the number of elements in the buffer
+ *
+ * @return the number of elements appended, smaller than length when the capacity is reached
+ */
+size_t ADCEnvelope::append(const uint32_t *buffer, size_t length)
+{
+	int16_t mn[2], mx[2];
+	size_t i = 0, n;
+
+	if(length > capacity - samples)
+	{
+		length = capacity - samples;
+	}
+
+	// complete the bucket left incomplete by the previous buffer
+	if(pendingCount && length)
+	{
+		n = baseBucket - pendingCount;
+		n = (n < length) ? n : length;
+		fnMinMaxChannels(buffer, n, mn, mx);
+		for(uint8_t channel = 0; channel < 2; channel++)
+		{
+			pendingMin[channel] = (mn[channel] < pendingMin[channel]) ? mn[channel] : pendingMin[channel];
+			pendingMax[channel] = (mx[channel] > pendingMax[channel]) ? mx[channel] : pendingMax[channel];
+		}
+		pendingCount += n;
+		i = n;
+		if(pendingCount == baseBucket)
+		{
+			pushBucket(pendingMin[0], pendingMax[0], pendingMin[1], pendingMax[1]);
+			pendingCount = 0;
+		}
+	}
+
+	// complete buckets
+	while(length - i >= baseBucket)
+	{
+		fnMinMaxChannels(buffer + i, baseBucket, mn, mx);
+		pushBucket(mn[0], mx[0], mn[1], mx[1]);
+		i += baseBucket;
+	}
+
+	// start a new incomplete bucket with the remaining elements
+	if(i < length)
+	{
+		fnMinMaxChannels(buffer + i, length - i, pendingMin, pendingMax);
+		pendingCount = length - i;
+	}
+
+	samples += length;
+	return length;
+}
+
+/**
+ * Get the number of samples appended to the recording.
+ *
+ * @return the number of samples
+ */
+size_t ADCEnvelope::getLength()
+{
+	return samples;
+}
+
+/**
+ * Render the envelope of a channel over a span of the recording, one min/max pair per pixel.
+ * The samples of the last, incomplete, level 0 bucket are not rendered. When the span is
+ * shorter than one level 0 bucket per pixel, neighbouring pixels share the same bucket.
+ * The pixels at the end of the recording, whose buckets are not yet combined into the
+ * coarse level, are rendered from the finer levels.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param start the index of the first sample of the span
+ * @param end the index after the last sample of the span
+ * @param mins the array receiving the minimum of each pixel
+ * @param maxs the array receiving the maximum of each pixel
+ * @param pixels the number of pixels
+ *
+ * @return the number of pixels filled, smaller than pixels when the span exceeds the recorded data
+ */
+size_t ADCEnvelope::query(uint8_t channel, size_t start, size_t end, int16_t *mins, int16_t *maxs, size_t pixels)
+{
+	uint8_t top = 0;
+	size_t span, p;
+
+	channel = channel ? 1 : 0;
+	if(end <= start || !pixels || !levels)
+	{
+		return 0;
+	}
+	span = end - start;
+
+	// coarsest level still having at least one bucket per pixel
+	while(top + 1 < levels && (baseBucket << (top + 1)) * pixels <= span)
+	{
+		top++;
+	}
+
+	for(p = 0; p < pixels; p++)
+	{
+		size_t s = start + (size_t)((uint64_t)p * span / pixels);
+		size_t e = start + (size_t)((uint64_t)(p + 1) * span / pixels);
+		size_t first, last;
+		uint8_t level = top;
+		// the coarse levels have not folded the last odd buckets yet, render the tail from a finer level
+		for(;;)
+		{
+			size_t bucket = baseBucket << level;
+			first = s / bucket;
+			last = (e + bucket - 1) / bucket;
+			if(last <= first)
+			{
+				last = first + 1;
+			}
+			if(last <= count[level] || !level)
+			{
+				break;
+			}
+			level--;
+		}
+		if(last > count[level])
+		{
+			break;
+		}
+		int16_t mn = INT16_MAX, mx = INT16_MIN;
+		for(size_t b = first; b < last; b++)
+		{
+			int16_t bMin = this->mins[level][channel][b];
+			int16_t bMax = this->maxs[level][channel][b];
+			mn = (bMin < mn) ? bMin : mn;
+			mx = (bMax > mx) ? bMax : mx;
+		}
+		mins[p] = mn;
+		maxs[p] = mx;
+	}
+	return p;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file adcenvelope.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the min/max envelope decimation of ZMOD ADC1410 raw buffers.
+ */
+
+#include "zmodadc1410.h"
+
+#ifndef _ADCENVELOPE_H
+#define  _ADCENVELOPE_H
+
+#define ADCENVELOPE_MAX_LEVELS	24	///< maximum number of levels of an envelope pyramid
+
+void fnDecimateMinMax(const uint32_t *buffer, size_t length, uint8_t channel,
+		int16_t *mins, int16_t *maxs, size_t buckets);
+void fnDecimateMinMaxChannels(const uint32_t *buffer, size_t length,
+		int16_t *mins1, int16_t *maxs1, int16_t *mins2, int16_t *maxs2, size_t buckets);
+
+/**
+ * Class keeping a multi-resolution min/max envelope of both channels of a streamed recording.
+ * Level 0 holds the min/max of each group of baseBucket samples, and each following level
+ * holds the min/max of pairs of buckets of the previous level. Any span of the recording is
+ * then rendered from the coarsest level that still has at least one bucket per pixel,
+ * so the cost of a query is proportional to the number of pixels, not of samples.
+ */
+class ADCEnvelope {
+private:
+	size_t baseBucket; ///< number of samples in a level 0 bucket
+	size_t capacity; ///< maximum number of samples in the recording
+	uint8_t levels; ///< number of levels
+	int16_t *mins[ADCENVELOPE_MAX_LEVELS][2]; ///< [level][channel 0:1] bucket minimums
+	int16_t *maxs[ADCENVELOPE_MAX_LEVELS][2]; ///< [level][channel 0:1] bucket maximums
+	size_t count[ADCENVELOPE_MAX_LEVELS]; ///< [level] number of complete buckets
+	int16_t pendingMin[2]; ///< [channel 0:1] minimum of the incomplete level 0 bucket
+	int16_t pendingMax[2]; ///< [channel 0:1] maximum of the incomplete level 0 bucket
+	size_t pendingCount; ///< number of samples in the incomplete level 0 bucket
+	size_t samples; ///< number of samples appended
+
+	void pushBucket(int16_t min1, int16_t max1, int16_t min2, int16_t max2);
+
+public:
+	ADCEnvelope(size_t capacity, size_t baseBucket);
+	~ADCEnvelope();
+	ADCEnvelope(const ADCEnvelope &) = delete; ///< not copyable, owns its buffers
+	ADCEnvelope &operator=(const ADCEnvelope &) = delete; ///< not copyable, owns its buffers
+
+	void reset();
+	size_t append(const uint32_t *buffer, size_t length);
+	size_t getLength();
+	size_t query(uint8_t channel, size_t start, size_t end, int16_t *mins, int16_t *maxs, size_t pixels);
+};
+
+#endif
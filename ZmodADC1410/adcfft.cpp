@@ -0,0 +1,171 @@
+/**
+ * @file adcfft.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the real input FFT used by the ZMOD ADC1410 spectrum stages.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "adcfft.h"
+
+/**
+ * Create the plan of a real input FFT.
+ * If the size is not a power of 2 of at least 4, or the allocation fails, the plan is invalid.
+ *
+ * @param size the number of real input samples, power of 2
+ */
+ADCFFT::ADCFFT(size_t size)
+{
+	uint8_t bits = 0;
+
+	this->size = size;
+	half = size / 2;
+	twiddles = NULL;
+	splitTwiddles = NULL;
+	bitReverse = NULL;
+	if(size < 4 || (size & (size - 1)))
+	{
+		return;
+	}
+	while(((size_t)1 << bits) < half)
+	{
+		bits++;
+	}
+
+	twiddles = (float *)malloc(half * sizeof(float));
+	splitTwiddles = (float *)malloc(2 * half * sizeof(float));
+	bitReverse = (uint32_t *)malloc(half * sizeof(uint32_t));
+	if(!twiddles || !splitTwiddles || !bitReverse)
+	{
+		return;
+	}
+	for(size_t k = 0; k < half / 2; k++)
+	{
+		double a = 2.0 * M_PI * (double)k / (double)half;
+		twiddles[2 * k] = (float)cos(a);
+		twiddles[2 * k + 1] = (float)-sin(a);
+	}
+	for(size_t k = 0; k < half; k++)
+	{
+		double a = 2.0 * M_PI * (double)k / (double)size;
+		splitTwiddles[2 * k] = (float)cos(a);
+		splitTwiddles[2 * k + 1] = (float)-sin(a);
+	}
+	for(size_t i = 0; i < half; i++)
+	{
+		uint32_t r = 0;
+		for(uint8_t b = 0; b < bits; b++)
+		{
+			r |= ((i >> b) & 1) << (bits - 1 - b);
+		}
+		bitReverse[i] = r;
+	}
+}
+
+/**
+ * FFT plan destructor.
+ */
+ADCFFT::~ADCFFT()
+{
+	free(twiddles);
+	free(splitTwiddles);
+	free(bitReverse);
+}
+
+/**
+ * Check that the plan was created successfully.
+ *
+ * @return true if the plan can be used
+ */
+bool ADCFFT::isValid()
+{
+	return twiddles && splitTwiddles && bitReverse;
+}
+
+/**
+ * Get the number of real input samples.
+ *
+ * @return the FFT size
+ */
+size_t ADCFFT::getSize()
+{
+	return size;
+}
+
+/**
+ * Get the number of output bins, from DC to Nyquist frequency.
+ *
+ * @return size / 2 + 1
+ */
+size_t ADCFFT::getBins()
+{
+	return half + 1;
+}
+
+/**
+ * Compute the FFT of real input samples.
+ * The samples are processed as half complex values (even samples as real parts, odd samples
+ * as imaginary parts) by an iterative radix-2 FFT, then the spectrum of the real input is
+ * separated from the complex result.
+ *
+ * @param data the size input samples, overwritten by the computation
+ * @param re the array receiving the real parts of the size / 2 + 1 output bins
+ * @param im the array receiving the imaginary parts of the size / 2 + 1 output bins
+ */
+void ADCFFT::forward(float *data, float *re, float *im)
+{
+	size_t i, k, len;
+
+	// bit reversal permutation of the complex values
+	for(i = 0; i < half; i++)
+	{
+		size_t j = bitReverse[i];
+		if(j > i)
+		{
+			float tr = data[2 * i], ti = data[2 * i + 1];
+			data[2 * i] = data[2 * j];
+			data[2 * i + 1] = data[2 * j + 1];
+			data[2 * j] = tr;
+			data[2 * j + 1] = ti;
+		}
+	}
+
+	// radix-2 butterflies
+	for(len = 2; len <= half; len <<= 1)
+	{
+		size_t step = half / len;
+		for(i = 0; i < half; i += len)
+		{
+			float *a = data + 2 * i;
+			float *b = data + 2 * (i + len / 2);
+			for(k = 0; k < len / 2; k++)
+			{
+				float wr = twiddles[2 * k * step];
+				float wi = twiddles[2 * k * step + 1];
+				float br = b[2 * k] * wr - b[2 * k + 1] * wi;
+				float bi = b[2 * k] * wi + b[2 * k + 1] * wr;
+				b[2 * k] = a[2 * k] - br;
+				b[2 * k + 1] = a[2 * k + 1] - bi;
+				a[2 * k] += br;
+				a[2 * k + 1] += bi;
+			}
+		}
+	}
+
+	// separate the spectrum of the real input: X[k] = E[k] + W^k * O[k]
+	re[0] = data[0] + data[1];
+	im[0] = 0;
+	re[half] = data[0] - data[1];
+	im[half] = 0;
+	for(k = 1; k < half; k++)
+	{
+		float zr = data[2 * k], zi = data[2 * k + 1];
+		float cr = data[2 * (half - k)], ci = -data[2 * (half - k) + 1];
+		float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+		// O = (Z - conj(Z[half - k])) / 2i
+		float or_ = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+		float wr = splitTwiddles[2 * k], wi = splitTwiddles[2 * k + 1];
+		re[k] = er + or_ * wr - oi * wi;
+		im[k] = ei + or_ * wi + oi * wr;
+	}
+}
@@ -0,0 +1,38 @@
+/**
+ * @file adcfft.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the real input FFT used by the ZMOD ADC1410 spectrum stages.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef _ADCFFT_H
+#define  _ADCFFT_H
+
+/**
+ * Class holding the precomputed plan (twiddles and bit reversal table) of a real input FFT.
+ * The plan is read only after construction, so one instance can be shared by several threads,
+ * each of them providing its own data and output arrays.
+ */
+class ADCFFT {
+private:
+	size_t size; ///< number of real input samples, power of 2
+	size_t half; ///< size / 2, number of points of the complex FFT
+	float *twiddles; ///< interleaved cos/-sin of 2 * pi * k / half, for k < half / 2
+	float *splitTwiddles; ///< interleaved cos/-sin of 2 * pi * k / size, for k < half
+	uint32_t *bitReverse; ///< bit reversal permutation of half elements
+
+public:
+	ADCFFT(size_t size);
+	~ADCFFT();
+	ADCFFT(const ADCFFT &) = delete; ///< not copyable, owns its buffers
+	ADCFFT &operator=(const ADCFFT &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	size_t getSize();
+	size_t getBins();
+	void forward(float *data, float *re, float *im);
+};
+
+#endif
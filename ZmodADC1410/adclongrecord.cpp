@@ -0,0 +1,206 @@
+/**
+ * @file adclongrecord.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the long record used by the ZMOD ADC1410 long record acquisition.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "adclongrecord.h"
+
+/**
+ * Create a long record, allocating the DMA region for the whole record.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param length the number of samples of the record, not limited to the maximum buffer length
+ * @param windowLength the number of samples of each hardware window,
+ *  limited to the maximum supported buffer length (0x3FFF)
+ */
+ADCLongRecord::ADCLongRecord(ZMODADC1410 *adc, size_t length, size_t windowLength)
+{
+	init(adc, length, windowLength);
+	buffer = adc->allocRecordBuffer(length);
+	ownBuffer = true;
+}
+
+/**
+ * Create a long record over a caller provided DMA buffer,
+ * for example allocated by ZMODADC1410::allocRecordBuffer.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param buffer the DMA buffer receiving the record, of at least length elements
+ * @param length the number of samples of the record, not limited to the maximum buffer length
+ * @param windowLength the number of samples of each hardware window,
+ *  limited to the maximum supported buffer length (0x3FFF)
+ */
+ADCLongRecord::ADCLongRecord(ZMODADC1410 *adc, uint32_t *buffer, size_t length, size_t windowLength)
+{
+	init(adc, length, windowLength);
+	this->buffer = buffer;
+	ownBuffer = false;
+}
+
+/**
+ * Initialize the record geometry and the gap list.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param length the number of samples of the record
+ * @param windowLength the number of samples of each hardware window
+ */
+void ADCLongRecord::init(ZMODADC1410 *adc, size_t length, size_t windowLength)
+{
+	if(windowLength > ZMODADC1410_MAX_BUFFER_LEN || windowLength == 0)
+	{
+		windowLength = ZMODADC1410_MAX_BUFFER_LEN;
+	}
+	this->adc = adc;
+	this->length = length;
+	this->windowLength = windowLength;
+	windows = (uint32_t)((length + windowLength - 1) / windowLength);
+	gaps = NULL;
+	if(windows > 1)
+	{
+		gaps = (RecordGap *)malloc((windows - 1) * sizeof(RecordGap));
+	}
+	memset(&info, 0, sizeof(info));
+	reset();
+}
+
+/**
+ * Long record destructor.
+ */
+ADCLongRecord::~ADCLongRecord()
+{
+	if(ownBuffer && buffer)
+	{
+		adc->freeRecordBuffer(buffer, length);
+	}
+	free(gaps);
+}
+
+/**
+ * Check that the record was allocated.
+ *
+ * @return true if the record can be used
+ */
+bool ADCLongRecord::isValid()
+{
+	return buffer && (windows < 2 || gaps);
+}
+
+/**
+ * Clear the gaps of the last acquisition.
+ */
+void ADCLongRecord::reset()
+{
+	gapCount = 0;
+	minGapNs = 0;
+	maxGapNs = 0;
+	totalGapNs = 0;
+}
+
+/**
+ * Get the raw data of the record.
+ *
+ * @return the raw buffer of getLength() elements
+ */
+uint32_t *ADCLongRecord::getRawBuffer()
+{
+	return buffer;
+}
+
+/**
+ * Get the number of samples of the record.
+ *
+ * @return the record length
+ */
+size_t ADCLongRecord::getLength()
+{
+	return length;
+}
+
+/**
+ * Get the number of samples of each hardware window, the last one may be shorter.
+ *
+ * @return the window length
+ */
+size_t ADCLongRecord::getWindowLength()
+{
+	return windowLength;
+}
+
+/**
+ * Get the number of hardware windows composing the record.
+ *
+ * @return the number of windows
+ */
+uint32_t ADCLongRecord::getWindowCount()
+{
+	return windows;
+}
+
+/**
+ * Get the number of gaps measured by the last acquisition, one between each pair of windows.
+ *
+ * @return the number of gaps
+ */
+uint32_t ADCLongRecord::getGapCount()
+{
+	return gapCount;
+}
+
+/**
+ * Get a gap of the last acquisition.
+ *
+ * @param gap the index of the gap, the gap k precedes the window k + 1
+ *
+ * @return the gap, NULL if the index is out of range
+ */
+const RecordGap *ADCLongRecord::getGap(uint32_t gap)
+{
+	if(gap >= gapCount)
+	{
+		return NULL;
+	}
+	return &gaps[gap];
+}
+
+/**
+ * Get the minimum gap between windows of the last acquisition.
+ *
+ * @return the minimum gap, in nanoseconds
+ */
+uint64_t ADCLongRecord::getMinGapNs()
+{
+	return minGapNs;
+}
+
+/**
+ * Get the maximum gap between windows of the last acquisition.
+ *
+ * @return the maximum gap, in nanoseconds
+ */
+uint64_t ADCLongRecord::getMaxGapNs()
+{
+	return maxGapNs;
+}
+
+/**
+ * Get the total time not acquired during the last acquisition.
+ *
+ * @return the sum of the gaps, in nanoseconds
+ */
+uint64_t ADCLongRecord::getTotalGapNs()
+{
+	return totalGapNs;
+}
+
+/**
+ * Get the settings of the last acquisition, and the time it completed.
+ *
+ * @return the acquisition settings
+ */
+const AcquisitionInfo &ADCLongRecord::getInfo()
+{
+	return info;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file adclongrecord.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the long record used by the ZMOD ADC1410 long record acquisition.
+ */
+
+#include "zmodadc1410.h"
+#include "acquisitionblock.h"
+
+#ifndef _ADCLONGRECORD_H
+#define  _ADCLONGRECORD_H
+
+/**
+ * Struct describing a discontinuity between two consecutive hardware windows of a long record.
+ */
+typedef struct _RecordGap {
+	size_t index; ///< index of the first sample following the gap
+	uint64_t gapNs; ///< estimated time not acquired between the two windows, in nanoseconds
+	uint64_t gapSamples; ///< estimated number of samples lost between the two windows
+} RecordGap;
+
+/**
+ * Class holding a record longer than the maximum buffer length supported by the IP,
+ * filled by ZMODADC1410::acquireLongRecordPolling with consecutive immediate acquisitions
+ * (windows), and the list of gaps between the windows.
+ */
+class ADCLongRecord {
+	friend class ZMODADC1410;
+
+private:
+	ZMODADC1410 *adc; ///< the ADC used for acquisition
+	uint32_t *buffer; ///< raw DMA buffer of the whole record
+	bool ownBuffer; ///< true if the buffer was allocated by the record
+	size_t length; ///< number of samples of the record
+	size_t windowLength; ///< number of samples of each hardware window
+	uint32_t windows; ///< number of hardware windows
+	RecordGap *gaps; ///< [windows - 1] gaps between consecutive windows
+	uint32_t gapCount; ///< number of gaps measured by the last acquisition
+	uint64_t minGapNs; ///< minimum gap of the last acquisition
+	uint64_t maxGapNs; ///< maximum gap of the last acquisition
+	uint64_t totalGapNs; ///< sum of the gaps of the last acquisition
+	AcquisitionInfo info; ///< settings of the last acquisition
+
+	void init(ZMODADC1410 *adc, size_t length, size_t windowLength);
+
+public:
+	ADCLongRecord(ZMODADC1410 *adc, size_t length, size_t windowLength = ZMODADC1410_MAX_BUFFER_LEN);
+	ADCLongRecord(ZMODADC1410 *adc, uint32_t *buffer, size_t length, size_t windowLength = ZMODADC1410_MAX_BUFFER_LEN);
+	~ADCLongRecord();
+	ADCLongRecord(const ADCLongRecord &) = delete; ///< not copyable, owns its buffers
+	ADCLongRecord &operator=(const ADCLongRecord &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	void reset();
+
+	uint32_t *getRawBuffer();
+	size_t getLength();
+	size_t getWindowLength();
+	uint32_t getWindowCount();
+	uint32_t getGapCount();
+	const RecordGap *getGap(uint32_t gap);
+	uint64_t getMinGapNs();
+	uint64_t getMaxGapNs();
+	uint64_t getTotalGapNs();
+	const AcquisitionInfo &getInfo();
+};
+
+#endif
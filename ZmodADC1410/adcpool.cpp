@@ -0,0 +1,503 @@
+/**
+ * @file adcpool.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the work-stealing pool processing ZMOD ADC1410 buffers in parallel.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "adcpool.h"
+
+/**
+ * Create a statistics stage.
+ */
+ADCStatsStage::ADCStatsStage()
+{
+	buffers = 0;
+}
+
+/**
+ * Get the size of the result of a chunk: the statistics of the chunk.
+ *
+ * @return the result size, in bytes
+ */
+size_t ADCStatsStage::getChunkResultSize()
+{
+	return sizeof(ADCStats);
+}
+
+/**
+ * Compute the statistics of a chunk.
+ *
+ * @param buffer the whole buffer
+ * @param offset the index of the first sample of the chunk
+ * @param length the number of samples of the chunk
+ * @param result receives the statistics of the chunk
+ */
+void ADCStatsStage::processChunk(const uint32_t *buffer, size_t offset, size_t length, void *result)
+{
+	ADCStats *stats = (ADCStats *)result;
+
+	stats->reset();
+	stats->update(buffer + offset, length);
+}
+
+/**
+ * Merge the statistics of the chunks of a buffer, and add them to the running total.
+ *
+ * @param buffer the buffer
+ * @param length the number of samples of the buffer
+ * @param context the context given at submission
+ * @param results the statistics of the chunks
+ * @param chunkCount the number of chunks
+ */
+void ADCStatsStage::completeBuffer(const uint32_t *, size_t, void *,
+		const void *results, uint32_t chunkCount)
+{
+	const ADCStats *stats = (const ADCStats *)results;
+
+	last.reset();
+	for(uint32_t i = 0; i < chunkCount; i++)
+	{
+		last.merge(stats[i]);
+	}
+	total.merge(last);
+	buffers++;
+}
+
+/**
+ * Get the statistics of the last completed buffer.
+ *
+ * @return the statistics
+ */
+const ADCStats &ADCStatsStage::getLast()
+{
+	return last;
+}
+
+/**
+ * Get the statistics of all the completed buffers.
+ *
+ * @return the statistics
+ */
+const ADCStats &ADCStatsStage::getTotal()
+{
+	return total;
+}
+
+/**
+ * Get the number of completed buffers.
+ *
+ * @return the number of buffers
+ */
+uint64_t ADCStatsStage::getBufferCount()
+{
+	return buffers;
+}
+
+/**
+ * Create a processing pool and start its worker threads.
+ *
+ * @param stage the processing stage, which must outlive the pool
+ * @param maxLength the maximum number of samples of a buffer
+ * @param depth the maximum number of buffers in process
+ * @param threads the number of worker threads, limited to ADCPOOL_MAX_THREADS;
+ *  none on baremetal platforms
+ */
+ADCProcessingPool::ADCProcessingPool(ADCProcessingStage *stage, size_t maxLength, uint32_t depth, uint8_t threads)
+{
+	this->stage = stage;
+	this->maxLength = maxLength;
+	this->depth = depth ? depth : 1;
+	chunkLength = stage->getChunkLength();
+	if(!chunkLength)
+	{
+		chunkLength = ADCPOOL_DEF_CHUNK_LEN;
+	}
+	resultSize = stage->getChunkResultSize();
+	maxChunks = (maxLength + chunkLength - 1) / chunkLength;
+	submitted = 0;
+	dispatched = 0;
+	completed = 0;
+	completing = 0;
+	steals = 0;
+
+	jobs = (ADCPoolJob *)malloc(this->depth * sizeof(ADCPoolJob));
+	results = (uint8_t *)malloc((size_t)this->depth * maxChunks * resultSize);
+	if(jobs && results)
+	{
+		memset(jobs, 0, this->depth * sizeof(ADCPoolJob));
+		for(uint32_t i = 0; i < this->depth; i++)
+		{
+			jobs[i].results = results + (size_t)i * maxChunks * resultSize;
+		}
+	}
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+	this->threads = threads < 1 ? 1 : (threads > ADCPOOL_MAX_THREADS ? ADCPOOL_MAX_THREADS : threads);
+	sem_init(&wake, 0, 0);
+	idle = 0;
+	quit = 0;
+	for(uint8_t i = 0; i < this->threads; i++)
+	{
+		workers[i].pool = this;
+		workers[i].index = i;
+		// a worker claims a buffer only when its deque is empty
+		if(!isValid() || !workers[i].tasks.init(maxChunks) ||
+				pthread_create(&workers[i].thread, NULL, threadMain, &workers[i]))
+		{
+			// run with the threads created so far
+			this->threads = i;
+			break;
+		}
+	}
+#else
+	this->threads = 0;
+#endif // LINUX_APP || FAKE_APP
+}
+
+/**
+ * Processing pool destructor. Stops the worker threads; the buffers still in process are abandoned.
+ */
+ADCProcessingPool::~ADCProcessingPool()
+{
+#if defined(LINUX_APP) || defined(FAKE_APP)
+	__atomic_store_n(&quit, 1, __ATOMIC_SEQ_CST);
+	for(uint8_t i = 0; i < threads; i++)
+	{
+		sem_post(&wake);
+	}
+	for(uint8_t i = 0; i < threads; i++)
+	{
+		pthread_join(workers[i].thread, NULL);
+	}
+	sem_destroy(&wake);
+#endif // LINUX_APP || FAKE_APP
+	free(jobs);
+	free(results);
+}
+
+/**
+ * Check that the pool was created successfully.
+ *
+ * @return true if the job slots are allocated and, on Linux, a worker thread runs
+ */
+bool ADCProcessingPool::isValid()
+{
+#if defined(LINUX_APP) || defined(FAKE_APP)
+	if(!threads)
+	{
+		return false;
+	}
+#endif // LINUX_APP || FAKE_APP
+	return jobs && results && maxChunks;
+}
+
+/**
+ * Submit a buffer to process, without blocking. The buffer must stay valid and unchanged
+ * until the stage completes it.
+ *
+ * @param buffer the buffer
+ * @param length the number of samples of the buffer, at most the maximum length of the pool
+ * @param context a context passed to the completion of the buffer
+ *
+ * @return true if the buffer was submitted, false if the pool is not valid, all the job slots are busy or the length is invalid
+ */
+bool ADCProcessingPool::submit(const uint32_t *buffer, size_t length, void *context)
+{
+	return submitJob(buffer, length, context, NULL, 0, NULL);
+}
+
+/**
+ * Record a buffer in the next job slot and publish it to the workers.
+ *
+ * @param buffer the buffer
+ * @param length the number of samples of the buffer
+ * @param context a context passed to the completion of the buffer
+ * @param stream the stream the buffer is released to after completion, NULL for none
+ * @param consumer the consumer number of the pool in the stream
+ * @param streamBuffer the stream buffer to release
+ *
+ * @return true if the buffer was submitted, false if the pool is not valid, all the job slots are busy or the length is invalid
+ */
+bool ADCProcessingPool::submitJob(const uint32_t *buffer, size_t length, void *context,
+		ADCStream *stream, int consumer, ADCStreamBuffer *streamBuffer)
+{
+	uint64_t job = submitted;
+	ADCPoolJob *slot;
+
+	if(!isValid())
+	{
+		return false;
+	}
+	if(!length || length > maxLength || job - __atomic_load_n(&completed, __ATOMIC_ACQUIRE) >= depth)
+	{
+		return false;
+	}
+	slot = &jobs[job % depth];
+	slot->buffer = buffer;
+	slot->length = length;
+	slot->context = context;
+	slot->stream = stream;
+	slot->consumer = consumer;
+	slot->streamBuffer = streamBuffer;
+	slot->chunkCount = (length + chunkLength - 1) / chunkLength;
+	slot->remaining = slot->chunkCount;
+	slot->done = 0;
+	__atomic_store_n(&submitted, job + 1, __ATOMIC_SEQ_CST);
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+	if(__atomic_load_n(&idle, __ATOMIC_SEQ_CST))
+	{
+		sem_post(&wake);
+	}
+#else
+	for(uint32_t chunk = 0; chunk < slot->chunkCount; chunk++)
+	{
+		runTask(((job % depth) << 32) | chunk);
+	}
+#endif // LINUX_APP || FAKE_APP
+	return true;
+}
+
+/**
+ * Submit the buffers queued to a consumer of a stream, as many as there are free job
+ * slots, without blocking. Each buffer is released to the stream once the stage completed
+ * it, so the pool owns the consumer: only the calling thread receives from it, and the
+ * pool releases to it, always with the completion held.
+ *
+ * @param stream the stream
+ * @param consumer the consumer number of the pool, returned by ADCStream::addConsumer
+ *
+ * @return the number of buffers submitted
+ */
+uint32_t ADCProcessingPool::submitStream(ADCStream &stream, int consumer)
+{
+	ADCStreamBuffer *streamBuffer;
+	uint32_t count = 0;
+
+	while(submitted - __atomic_load_n(&completed, __ATOMIC_ACQUIRE) < depth &&
+			stream.receive(consumer, &streamBuffer, 1))
+	{
+		if(!submitJob(streamBuffer->buffer, streamBuffer->info.length, streamBuffer, &stream, consumer, streamBuffer))
+		{
+			// longer than the maximum length: released with the completion held, as the
+			// completing thread releases to the same consumer, and the consumer has one producer
+			uint32_t expected = 0;
+			while(!__atomic_compare_exchange_n(&completing, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			{
+				expected = 0;
+			}
+			stream.release(consumer, &streamBuffer, 1);
+			__atomic_store_n(&completing, 0, __ATOMIC_SEQ_CST);
+			// the buffers finished meanwhile found the completion busy
+			tryComplete();
+			continue;
+		}
+		count++;
+	}
+	return count;
+}
+
+/**
+ * Check that all the submitted buffers are completed.
+ *
+ * @return true if no buffer is in process
+ */
+bool ADCProcessingPool::isIdle()
+{
+	return __atomic_load_n(&completed, __ATOMIC_ACQUIRE) == submitted;
+}
+
+/**
+ * Get the number of completed buffers. Can be called from any thread.
+ *
+ * @return the number of buffers
+ */
+uint64_t ADCProcessingPool::getCompletedCount()
+{
+	return __atomic_load_n(&completed, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Get the number of chunks processed by another worker than the one that split their
+ * buffer, a measure of the load balancing. Can be called from any thread.
+ *
+ * @return the number of chunks stolen
+ */
+uint64_t ADCProcessingPool::getStealCount()
+{
+	return __atomic_load_n(&steals, __ATOMIC_RELAXED);
+}
+
+/**
+ * Process a chunk and, if it is the last one of its buffer, complete the buffers in order.
+ *
+ * @param task the chunk, job slot << 32 | chunk
+ */
+void ADCProcessingPool::runTask(uint64_t task)
+{
+	ADCPoolJob *job = &jobs[task >> 32];
+	uint32_t chunk = (uint32_t)task;
+	size_t offset = (size_t)chunk * chunkLength;
+	size_t length = job->length - offset < chunkLength ? job->length - offset : chunkLength;
+
+	stage->processChunk(job->buffer, offset, length, job->results + chunk * resultSize);
+	if(__atomic_sub_fetch(&job->remaining, 1, __ATOMIC_ACQ_REL) == 0)
+	{
+		__atomic_store_n(&job->done, 1, __ATOMIC_SEQ_CST);
+		tryComplete();
+	}
+}
+
+/**
+ * Complete the processed buffers, in submission order, unless another thread is already
+ * completing them. Does not wait: a thread finding the completion busy leaves its buffer
+ * to the completing thread, which checks again for completed buffers before leaving.
+ */
+void ADCProcessingPool::tryComplete()
+{
+	for(;;)
+	{
+		uint32_t expected = 0;
+		if(!__atomic_compare_exchange_n(&completing, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+		{
+			return;
+		}
+		uint64_t job = completed;
+		while(job < __atomic_load_n(&submitted, __ATOMIC_SEQ_CST) &&
+				__atomic_load_n(&jobs[job % depth].done, __ATOMIC_SEQ_CST))
+		{
+			ADCPoolJob *slot = &jobs[job % depth];
+			stage->completeBuffer(slot->buffer, slot->length, slot->context, slot->results, slot->chunkCount);
+			if(slot->stream)
+			{
+				slot->stream->release(slot->consumer, &slot->streamBuffer, 1);
+			}
+			slot->done = 0;
+			__atomic_store_n(&completed, ++job, __ATOMIC_RELEASE);
+		}
+		__atomic_store_n(&completing, 0, __ATOMIC_SEQ_CST);
+
+		// a buffer finished after the check may have found the completion busy
+		if(job == __atomic_load_n(&submitted, __ATOMIC_SEQ_CST) ||
+				!__atomic_load_n(&jobs[job % depth].done, __ATOMIC_SEQ_CST))
+		{
+			return;
+		}
+	}
+}
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+/**
+ * Claim the next submitted buffer, if any, and split it: the first chunk is returned,
+ * the others are pushed on the deque of the worker, and idle workers are woken to steal them.
+ *
+ * @param worker the worker claiming the buffer, with an empty deque
+ * @param task receives the first chunk
+ *
+ * @return true if a buffer was claimed
+ */
+bool ADCProcessingPool::dispatchJob(ADCPoolWorker *worker, uint64_t &task)
+{
+	uint64_t job = __atomic_load_n(&dispatched, __ATOMIC_SEQ_CST);
+
+	while(job < __atomic_load_n(&submitted, __ATOMIC_SEQ_CST))
+	{
+		if(__atomic_compare_exchange_n(&dispatched, &job, job + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+		{
+			uint64_t slot = job % depth;
+			uint32_t chunks = jobs[slot].chunkCount;
+			// pushed last to first, so that the owner takes them in order and the thieves the last ones
+			for(uint32_t chunk = chunks - 1; chunk > 0; chunk--)
+			{
+				worker->tasks.push((slot << 32) | chunk);
+			}
+			uint32_t sleepers = __atomic_load_n(&idle, __ATOMIC_SEQ_CST);
+			for(uint32_t i = 0; i < sleepers && i + 1 < chunks; i++)
+			{
+				sem_post(&wake);
+			}
+			task = slot << 32;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Steal a chunk from the other workers.
+ *
+ * @param worker the stealing worker
+ * @param task receives the chunk
+ *
+ * @return true if a chunk was stolen
+ */
+bool ADCProcessingPool::stealTask(ADCPoolWorker *worker, uint64_t &task)
+{
+	for(uint8_t i = 1; i < threads; i++)
+	{
+		ADCPoolWorker *victim = &workers[(worker->index + i) % threads];
+		if(victim->tasks.steal(task))
+		{
+			__atomic_fetch_add(&steals, 1, __ATOMIC_RELAXED);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Check whether a worker could find a buffer to claim or a chunk to steal.
+ *
+ * @return true if there is work, or the pool is stopping
+ */
+bool ADCProcessingPool::hasWork()
+{
+	if(__atomic_load_n(&quit, __ATOMIC_SEQ_CST) ||
+			__atomic_load_n(&dispatched, __ATOMIC_SEQ_CST) < __atomic_load_n(&submitted, __ATOMIC_SEQ_CST))
+	{
+		return true;
+	}
+	for(uint8_t i = 0; i < threads; i++)
+	{
+		if(!workers[i].tasks.isEmpty())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Worker thread: process its own chunks, then claim new buffers, then steal chunks,
+ * and sleep when there is no work.
+ *
+ * @param data the ADCPoolWorker of the thread
+ *
+ * @return NULL
+ */
+void *ADCProcessingPool::threadMain(void *data)
+{
+	ADCPoolWorker *worker = (ADCPoolWorker *)data;
+	ADCProcessingPool *pool = worker->pool;
+	uint64_t task;
+
+	while(!__atomic_load_n(&pool->quit, __ATOMIC_SEQ_CST))
+	{
+		if(worker->tasks.take(task) || pool->dispatchJob(worker, task) || pool->stealTask(worker, task))
+		{
+			pool->runTask(task);
+			continue;
+		}
+		// announce the sleep before checking for work, so that the submitter posts
+		__atomic_add_fetch(&pool->idle, 1, __ATOMIC_SEQ_CST);
+		if(!pool->hasWork())
+		{
+			sem_wait(&pool->wake);
+		}
+		__atomic_sub_fetch(&pool->idle, 1, __ATOMIC_SEQ_CST);
+	}
+	return NULL;
+}
+#endif // LINUX_APP || FAKE_APP
@@ -0,0 +1,180 @@
+/**
+ * @file adcpool.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the work-stealing pool processing ZMOD ADC1410 buffers in parallel.
+ */
+
+#include "zmodadc1410.h"
+#include "adcstats.h"
+#include "adcstream.h"
+#include "../Zmod/wsdeque.h"
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+#include <pthread.h>
+#include <semaphore.h>
+#endif // LINUX_APP || FAKE_APP
+
+#ifndef _ADCPOOL_H
+#define  _ADCPOOL_H
+
+#define ADCPOOL_MAX_THREADS		8		///< maximum number of worker threads
+#define ADCPOOL_DEF_CHUNK_LEN	2048	///< default chunk length in samples: 8 KiB of raw data, a quarter of the Cortex-A9 L1 data cache
+
+/**
+ * Interface of a processing stage run by ADCProcessingPool. Each buffer is split into chunks
+ * of getChunkLength samples, processed in parallel by processChunk, each into its own result;
+ * completeBuffer then reassembles the results of the buffer. completeBuffer is called for
+ * the buffers in their submission order, one call at a time, possibly from different threads.
+ */
+class ADCProcessingStage {
+public:
+	virtual ~ADCProcessingStage() {}
+
+	/**
+	 * Get the number of samples of each chunk; the last chunk of a buffer can be shorter.
+	 * @return the chunk length
+	 */
+	virtual size_t getChunkLength() {
+		return ADCPOOL_DEF_CHUNK_LEN;
+	}
+
+	/**
+	 * Get the size of the result of a chunk.
+	 * @return the result size, in bytes
+	 */
+	virtual size_t getChunkResultSize() = 0;
+
+	/**
+	 * Process a chunk, concurrently with the other chunks.
+	 * @param buffer the whole buffer, which must only be read (samples before offset are available to filters)
+	 * @param offset the index of the first sample of the chunk
+	 * @param length the number of samples of the chunk
+	 * @param result receives the result of the chunk
+	 */
+	virtual void processChunk(const uint32_t *buffer, size_t offset, size_t length, void *result) = 0;
+
+	/**
+	 * Reassemble the results of a buffer, in submission order.
+	 * @param buffer the buffer
+	 * @param length the number of samples of the buffer
+	 * @param context the context given at submission
+	 * @param results the results of the chunks, in chunk order
+	 * @param chunkCount the number of chunks
+	 */
+	virtual void completeBuffer(const uint32_t *buffer, size_t length, void *context,
+			const void *results, uint32_t chunkCount) = 0;
+};
+
+/**
+ * Processing stage computing the statistics of both channels (see ADCStats) of each buffer,
+ * and their running total. The statistics are read from completeBuffer of a derived class,
+ * or once the pool is idle.
+ */
+class ADCStatsStage : public ADCProcessingStage {
+private:
+	ADCStats last; ///< statistics of the last completed buffer
+	ADCStats total; ///< statistics of all the completed buffers
+	uint64_t buffers; ///< number of completed buffers
+
+public:
+	ADCStatsStage();
+
+	size_t getChunkResultSize() override;
+	void processChunk(const uint32_t *buffer, size_t offset, size_t length, void *result) override;
+	void completeBuffer(const uint32_t *buffer, size_t length, void *context,
+			const void *results, uint32_t chunkCount) override;
+
+	const ADCStats &getLast();
+	const ADCStats &getTotal();
+	uint64_t getBufferCount();
+};
+
+class ADCProcessingPool;
+
+/**
+ * Struct containing a buffer submitted to the pool.
+ */
+typedef struct _ADCPoolJob {
+	const uint32_t *buffer; ///< the buffer
+	size_t length; ///< number of samples of the buffer
+	void *context; ///< context given at submission
+	ADCStream *stream; ///< stream the buffer is released to after completion, NULL for none
+	int consumer; ///< consumer number of the pool in the stream
+	ADCStreamBuffer *streamBuffer; ///< the stream buffer to release
+	uint32_t chunkCount; ///< number of chunks
+	uint32_t remaining; ///< number of chunks not processed yet
+	uint32_t done; ///< 1 once all the chunks are processed
+	uint8_t *results; ///< [chunkCount] results of the chunks
+} ADCPoolJob;
+
+/**
+ * Struct containing the data of a worker thread of the pool.
+ */
+typedef struct _ADCPoolWorker {
+	ADCProcessingPool *pool; ///< the pool the thread belongs to
+	uint8_t index; ///< index of the thread
+	WSDeque<uint64_t> tasks; ///< chunks to process (job slot << 32 | chunk), stolen by the other threads when idle
+#if defined(LINUX_APP) || defined(FAKE_APP)
+	pthread_t thread; ///< the thread
+#endif // LINUX_APP || FAKE_APP
+} ADCPoolWorker;
+
+/**
+ * Class processing ZMOD ADC1410 buffers with a processing stage, in parallel across cores.
+ * submit and submitStream never block: the buffer is recorded in a free job slot, or
+ * refused when all the slots are busy, and an idle worker claims it, splits it into chunks
+ * pushed on its work-stealing deque, from which the other workers steal. The worker
+ * finishing the last chunk of the oldest buffers completes them, in submission order,
+ * without waiting for the other workers.
+ *
+ * The submitting methods must be called from one thread (typically the acquisition
+ * thread or a stream consumer). On the baremetal platform, which has no threads, the
+ * buffers are processed during submit.
+ */
+class ADCProcessingPool {
+private:
+	ADCProcessingStage *stage; ///< the processing stage
+	size_t maxLength; ///< maximum number of samples of a buffer
+	size_t chunkLength; ///< number of samples of each chunk
+	size_t resultSize; ///< size of the result of a chunk
+	uint32_t maxChunks; ///< number of chunks of a buffer of maxLength samples
+	uint32_t depth; ///< number of job slots, the maximum number of buffers in process
+	ADCPoolJob *jobs; ///< [depth] job slots, job n in slot n % depth
+	uint8_t *results; ///< [depth][maxChunks] results storage
+	uint64_t submitted; ///< number of jobs submitted, written by the submitting thread only
+	uint64_t dispatched; ///< number of jobs claimed by the workers
+	uint64_t completed; ///< number of jobs completed, written by the completing thread only
+	uint32_t completing; ///< 1 while a thread completes jobs
+	uint64_t steals; ///< number of chunks stolen
+	uint8_t threads; ///< number of worker threads
+	ADCPoolWorker workers[ADCPOOL_MAX_THREADS]; ///< worker threads data
+#if defined(LINUX_APP) || defined(FAKE_APP)
+	sem_t wake; ///< posted to wake idle workers
+	uint32_t idle; ///< number of workers waiting on wake
+	uint32_t quit; ///< set to stop the workers
+	static void *threadMain(void *data);
+#endif // LINUX_APP || FAKE_APP
+
+	bool submitJob(const uint32_t *buffer, size_t length, void *context,
+			ADCStream *stream, int consumer, ADCStreamBuffer *streamBuffer);
+	bool dispatchJob(ADCPoolWorker *worker, uint64_t &task);
+	bool stealTask(ADCPoolWorker *worker, uint64_t &task);
+	void runTask(uint64_t task);
+	void tryComplete();
+	bool hasWork();
+
+public:
+	ADCProcessingPool(ADCProcessingStage *stage, size_t maxLength, uint32_t depth, uint8_t threads);
+	~ADCProcessingPool();
+	ADCProcessingPool(const ADCProcessingPool &) = delete; ///< not copyable, owns its buffers
+	ADCProcessingPool &operator=(const ADCProcessingPool &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	bool submit(const uint32_t *buffer, size_t length, void *context);
+	uint32_t submitStream(ADCStream &stream, int consumer);
+	bool isIdle();
+	uint64_t getCompletedCount();
+	uint64_t getStealCount();
+};
+
+#endif
@@ -0,0 +1,328 @@
+/**
+ * @file adcpretrigger.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the software pre-trigger recorder of the ZMOD ADC1410.
+ */
+
+#include <string.h>
+#include "adcpretrigger.h"
+#include "adctrigger.h"
+#include "../Zmod/mem.h"
+#include "../Zmod/timer.h"
+
+/**
+ * Create a pre-trigger recorder, allocating the DMA buffer of one hardware window
+ * and the ring, backed by huge pages when the platform supports them.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param ringLength the number of samples of the ring, at least windowLength
+ * @param windowLength the number of samples of each hardware window,
+ *  limited to the maximum supported buffer length (0x3FFF)
+ */
+ADCPreTriggerRecorder::ADCPreTriggerRecorder(ZMODADC1410 *adc, size_t ringLength, size_t windowLength)
+{
+	this->adc = adc;
+	this->windowLength = windowLength;
+	window = adc->allocChannelsBuffer(this->windowLength);
+	if(ringLength < this->windowLength)
+	{
+		ringLength = this->windowLength;
+	}
+	this->ringLength = ringLength;
+	ring = (uint32_t *)fnAllocLargeBuffer(ringLength * sizeof(uint32_t));
+	head = 0;
+	trigger = 0;
+	triggered = false;
+	preTrigger = 0;
+	postTrigger = 0;
+	memset(&info, 0, sizeof(info));
+}
+
+/**
+ * Pre-trigger recorder destructor.
+ */
+ADCPreTriggerRecorder::~ADCPreTriggerRecorder()
+{
+	if(window)
+	{
+		adc->freeChannelsBuffer(window, windowLength);
+	}
+	fnFreeLargeBuffer(ring, ringLength * sizeof(uint32_t));
+}
+
+/**
+ * Check that the recorder buffers were allocated.
+ *
+ * @return true if the recorder can be used
+ */
+bool ADCPreTriggerRecorder::isValid()
+{
+	return window && ring;
+}
+
+/**
+ * Copy the acquired window at the head of the ring.
+ *
+ * @param length the number of samples of the window
+ */
+void ADCPreTriggerRecorder::push(size_t length)
+{
+	size_t pos = (size_t)(head % ringLength);
+	size_t first = ringLength - pos < length ? ringLength - pos : length;
+
+	memcpy(ring + pos, window, first * sizeof(uint32_t));
+	memcpy(ring, window + first, (length - first) * sizeof(uint32_t));
+	head += length;
+}
+
+/**
+ * Acquire a record of preTrigger samples before a software trigger and postTrigger samples
+ * from the trigger on, using a polling method, will block until the record is complete or
+ * the timeout expires. Immediate hardware windows are streamed into the ring, and each
+ * window is searched for the trigger edge (see fnFindEdge); only samples preceded by
+ * at least preTrigger samples can trigger. The windows are not contiguous in time, so a
+ * crossing between the last sample of a window and the first of the next is not detected.
+ * After the trigger, the windows are shortened so that the acquisition stops at the last
+ * sample of the record.
+ *
+ * @param channel the channel for which trigger is set: 0 for channel 1,
+ *  1 for channel 2
+ * @param level the trigger level, as a signed 14 bits raw value
+ * @param edge the trigger edge, 0 for rising edge, 1 for falling edge
+ * @param preTrigger the number of samples of the record before the trigger
+ * @param postTrigger the number of samples of the record from the trigger on, at least 1;
+ *  preTrigger + postTrigger and preTrigger + the window length must not exceed the ring length
+ * @param timeoutNs the maximum time to wait for the trigger, in nanoseconds,
+ *  0 to wait forever
+ *
+ * @return 0 on success, any other number on failure; a trigger timeout is not a failure,
+ *  see isTriggered()
+ */
+uint8_t ADCPreTriggerRecorder::acquirePolling(uint8_t channel, int16_t level, uint32_t edge,
+		size_t preTrigger, size_t postTrigger, uint64_t timeoutNs)
+{
+	size_t transferLength = windowLength;
+	uint64_t startTime;
+
+	head = 0;
+	triggered = false;
+	if(!isValid() || postTrigger == 0 || preTrigger + postTrigger > ringLength ||
+			preTrigger + windowLength > ringLength)
+	{
+		return ERR_FAIL;
+	}
+	this->preTrigger = preTrigger;
+	this->postTrigger = postTrigger;
+
+	// Set immediate trigger, the trigger is evaluated in software
+	adc->setTrigger(0, 1, 0, 0, 0);
+	adc->setTransferLength(transferLength);
+	adc->enableBufferFullInterrupt(0);
+
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		info.gain[ch] = adc->getGain(ch);
+		info.coupling[ch] = adc->getCoupling(ch);
+	}
+	info.trigChannel = channel;
+	info.trigMode = 0;
+	info.trigEdge = edge;
+	info.trigLevel = level;
+	info.window = preTrigger;
+	info.length = preTrigger + postTrigger;
+	info.triggerTime = 0;
+
+	startTime = fnGetTimeNs();
+	while(true)
+	{
+		size_t length = windowLength;
+		uint64_t start = head;
+
+		if(triggered)
+		{
+			if(head >= trigger + postTrigger)
+			{
+				break;
+			}
+			uint64_t remaining = trigger + postTrigger - head;
+			if(remaining < length)
+			{
+				length = (size_t)remaining;
+			}
+		}
+		if(length != transferLength)
+		{
+			transferLength = length;
+			adc->setTransferLength(transferLength);
+		}
+
+		// RunStop bit = 1, waits until buffer full bit is set by the ZMODADC1410 IP
+		adc->start();
+		while(!adc->isBufferFull()) {}
+		adc->writeRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL, 1);
+		if(adc->startDMATransfer(window))
+		{
+			return ERR_FAIL;
+		}
+		while(!adc->isDMATransferComplete()) {}
+		push(length);
+
+		if(!triggered)
+		{
+			// skip the samples that do not have preTrigger samples before them
+			size_t first = start < preTrigger ? (size_t)(preTrigger - start) : 0;
+			// the windows are separate acquisitions: the first sample of a window has no previous sample
+			int16_t previous = level;
+			if(first > length)
+			{
+				first = length;
+			}
+			if(first)
+			{
+				previous = adc->signedChannelData(channel, window[first - 1]);
+			}
+			size_t index = first + fnFindEdge(window + first, length - first, channel, level, edge, previous);
+			if(index < length)
+			{
+				triggered = true;
+				trigger = start + index;
+				info.triggerTime = preTrigger + fnInterpolateTrigger(window, length, channel, level, edge, index,
+						ADC_INTERPOLATION_CUBIC) - index;
+			}
+			else
+			{
+				if(timeoutNs && fnGetTimeNs() - startTime > timeoutNs)
+				{
+					adc->countTimeout();
+					break;
+				}
+			}
+		}
+	}
+	info.times = adc->getTimestamps();
+	info.timestamp = fnGetTimeNs();
+
+	return ERR_SUCCESS;
+}
+
+/**
+ * Check whether the last acquisition triggered, and holds a complete record.
+ *
+ * @return true if the record is available
+ */
+bool ADCPreTriggerRecorder::isTriggered()
+{
+	return triggered;
+}
+
+/**
+ * Get the number of samples of the ring.
+ *
+ * @return the ring length
+ */
+size_t ADCPreTriggerRecorder::getRingLength()
+{
+	return ringLength;
+}
+
+/**
+ * Get the number of samples of the record.
+ *
+ * @return the record length, preTrigger + postTrigger
+ */
+size_t ADCPreTriggerRecorder::getLength()
+{
+	return preTrigger + postTrigger;
+}
+
+/**
+ * Get the number of samples of the record before the trigger,
+ * which is also the index of the trigger sample in the record.
+ *
+ * @return the number of pre-trigger samples
+ */
+size_t ADCPreTriggerRecorder::getPreTrigger()
+{
+	return preTrigger;
+}
+
+/**
+ * Get the index of the trigger sample in the stream acquired by the last acquisition.
+ *
+ * @return the trigger index in the stream
+ */
+uint64_t ADCPreTriggerRecorder::getTriggerIndex()
+{
+	return trigger;
+}
+
+/**
+ * Get a sample of the record.
+ *
+ * @param index the index of the sample in the record, lower than getLength()
+ *
+ * @return the raw sample
+ */
+uint32_t ADCPreTriggerRecorder::getSample(size_t index)
+{
+	return ring[(size_t)((trigger - preTrigger + index) % ringLength)];
+}
+
+/**
+ * Get the record without copying it, as the two contiguous parts of the ring holding it.
+ *
+ * @param first receives the first part of the record
+ * @param firstLength receives the number of samples of the first part
+ * @param second receives the second part of the record, the start of the ring
+ * @param secondLength receives the number of samples of the second part, 0 if the
+ *  record does not wrap around the ring
+ */
+void ADCPreTriggerRecorder::getRecord(const uint32_t **first, size_t *firstLength, const uint32_t **second, size_t *secondLength)
+{
+	size_t pos = (size_t)((trigger - preTrigger) % ringLength);
+	size_t length = getLength();
+
+	*firstLength = ringLength - pos < length ? ringLength - pos : length;
+	*first = ring + pos;
+	*secondLength = length - *firstLength;
+	*second = ring;
+}
+
+/**
+ * Copy the record into a contiguous buffer.
+ *
+ * @param buffer the buffer receiving the record
+ * @param length the number of elements of the buffer
+ *
+ * @return the number of samples copied, at most getLength()
+ */
+size_t ADCPreTriggerRecorder::copyRecord(uint32_t *buffer, size_t length)
+{
+	const uint32_t *first, *second;
+	size_t firstLength, secondLength;
+
+	getRecord(&first, &firstLength, &second, &secondLength);
+	if(length > firstLength + secondLength)
+	{
+		length = firstLength + secondLength;
+	}
+	if(firstLength > length)
+	{
+		firstLength = length;
+	}
+	memcpy(buffer, first, firstLength * sizeof(uint32_t));
+	memcpy(buffer + firstLength, second, (length - firstLength) * sizeof(uint32_t));
+
+	return length;
+}
+
+/**
+ * Get the settings of the last acquisition, and the time it completed.
+ * The window holds the number of pre-trigger samples, and the length the record length.
+ *
+ * @return the acquisition settings
+ */
+const AcquisitionInfo &ADCPreTriggerRecorder::getInfo()
+{
+	return info;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file adcpretrigger.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the software pre-trigger recorder of the ZMOD ADC1410.
+ */
+
+#include "zmodadc1410.h"
+#include "acquisitionblock.h"
+
+#ifndef _ADCPRETRIGGER_H
+#define  _ADCPRETRIGGER_H
+
+/**
+ * Class streaming immediate acquisitions into a software ring, evaluating the trigger
+ * in software, and freezing a record of any number of samples before and after the
+ * trigger, only limited by the ring length.
+ *
+ * Like the long record, the stream is not continuous at the boundaries of the hardware
+ * windows (see ZMODADC1410::acquireLongRecordPolling).
+ */
+class ADCPreTriggerRecorder {
+private:
+	ZMODADC1410 *adc; ///< the ADC used for acquisition
+	uint32_t *window; ///< DMA buffer of one hardware window
+	size_t windowLength; ///< number of samples of a hardware window
+	uint32_t *ring; ///< ring of the last ringLength samples
+	size_t ringLength; ///< number of samples of the ring
+	uint64_t head; ///< number of samples written to the ring since the start of the acquisition
+	uint64_t trigger; ///< index in the stream of the trigger sample
+	bool triggered; ///< true if the last acquisition triggered
+	size_t preTrigger; ///< number of samples of the record before the trigger
+	size_t postTrigger; ///< number of samples of the record from the trigger on
+	AcquisitionInfo info; ///< settings of the last acquisition
+
+	void push(size_t length);
+
+public:
+	ADCPreTriggerRecorder(ZMODADC1410 *adc, size_t ringLength, size_t windowLength = ZMODADC1410_MAX_BUFFER_LEN);
+	~ADCPreTriggerRecorder();
+	ADCPreTriggerRecorder(const ADCPreTriggerRecorder &) = delete; ///< not copyable, owns its buffers
+	ADCPreTriggerRecorder &operator=(const ADCPreTriggerRecorder &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	uint8_t acquirePolling(uint8_t channel, int16_t level, uint32_t edge, size_t preTrigger, size_t postTrigger, uint64_t timeoutNs);
+
+	bool isTriggered();
+	size_t getRingLength();
+	size_t getLength();
+	size_t getPreTrigger();
+	uint64_t getTriggerIndex();
+	uint32_t getSample(size_t index);
+	void getRecord(const uint32_t **first, size_t *firstLength, const uint32_t **second, size_t *secondLength);
+	size_t copyRecord(uint32_t *buffer, size_t length);
+	const AcquisitionInfo &getInfo();
+};
+
+#endif
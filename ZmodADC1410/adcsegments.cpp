@@ -0,0 +1,182 @@
+/**
+ * @file adcsegments.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the segment table used by the ZMOD ADC1410 segmented acquisition.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "adcsegments.h"
+
+/**
+ * Create a segment table, allocating one DMA region for all the segments.
+ * The segment length is limited to the maximum supported buffer length (0x3FFF),
+ * altering the value of the reference parameter accordingly.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param length the number of samples of each segment - passed by reference
+ * @param segments the number of segments
+ */
+ADCSegmentTable::ADCSegmentTable(ZMODADC1410 *adc, size_t &length, uint32_t segments)
+{
+	if(length > ZMODADC1410_MAX_BUFFER_LEN)
+	{
+		length = ZMODADC1410_MAX_BUFFER_LEN;
+	}
+	this->adc = adc;
+	this->length = length;
+	this->segments = segments;
+	buffer = adc->allocRecordBuffer(length * segments);
+	segmentInfo = (SegmentInfo *)malloc(segments * sizeof(SegmentInfo));
+	if(!segmentInfo)
+	{
+		// freed with the size it was allocated with, before the table is emptied
+		if(buffer)
+		{
+			adc->freeRecordBuffer(buffer, length * segments);
+			buffer = NULL;
+		}
+		this->segments = 0;
+	}
+	memset(&info, 0, sizeof(info));
+	reset();
+}
+
+/**
+ * Segment table destructor.
+ */
+ADCSegmentTable::~ADCSegmentTable()
+{
+	if(buffer)
+	{
+		adc->freeRecordBuffer(buffer, length * segments);
+	}
+	free(segmentInfo);
+}
+
+/**
+ * Check that the table was allocated.
+ *
+ * @return true if the table can be used
+ */
+bool ADCSegmentTable::isValid()
+{
+	return buffer && segmentInfo;
+}
+
+/**
+ * Clear the results of the last acquisition.
+ */
+void ADCSegmentTable::reset()
+{
+	acquired = 0;
+	missedTriggers = 0;
+	timeouts = 0;
+	maxRearmLatencyNs = 0;
+	if(segmentInfo)
+	{
+		memset(segmentInfo, 0, segments * sizeof(SegmentInfo));
+	}
+}
+
+/**
+ * Get the number of samples of each segment.
+ *
+ * @return the segment length
+ */
+size_t ADCSegmentTable::getLength()
+{
+	return length;
+}
+
+/**
+ * Get the number of segments of the table.
+ *
+ * @return the number of segments
+ */
+uint32_t ADCSegmentTable::getSegmentCount()
+{
+	return segments;
+}
+
+/**
+ * Get the number of segments filled by the last acquisition.
+ *
+ * @return the number of acquired segments
+ */
+uint32_t ADCSegmentTable::getAcquiredCount()
+{
+	return acquired;
+}
+
+/**
+ * Get the raw data of a segment.
+ *
+ * @param segment the index of the segment
+ *
+ * @return the raw buffer of getLength() elements, NULL if the index is out of range
+ */
+uint32_t *ADCSegmentTable::getSegment(uint32_t segment)
+{
+	if(!buffer || segment >= segments)
+	{
+		return NULL;
+	}
+	return buffer + segment * length;
+}
+
+/**
+ * Get the metadata of a segment.
+ *
+ * @param segment the index of the segment
+ *
+ * @return the segment metadata, NULL if the segment was not acquired
+ */
+const SegmentInfo *ADCSegmentTable::getSegmentInfo(uint32_t segment)
+{
+	if(segment >= acquired)
+	{
+		return NULL;
+	}
+	return &segmentInfo[segment];
+}
+
+/**
+ * Get the estimated number of triggers missed during the last acquisition.
+ *
+ * @return the number of missed triggers, 0 if the trigger period was not given
+ */
+uint32_t ADCSegmentTable::getMissedTriggers()
+{
+	return missedTriggers;
+}
+
+/**
+ * Get the number of trigger timeouts of the last acquisition (0 or 1, the acquisition stops at the first one).
+ *
+ * @return the number of timeouts
+ */
+uint32_t ADCSegmentTable::getTimeouts()
+{
+	return timeouts;
+}
+
+/**
+ * Get the maximum rearm latency of the last acquisition.
+ *
+ * @return the maximum time from a buffer full to arming the ADC again, in nanoseconds
+ */
+uint64_t ADCSegmentTable::getMaxRearmLatencyNs()
+{
+	return maxRearmLatencyNs;
+}
+
+/**
+ * Get the settings of the last acquisition, and the time it completed.
+ *
+ * @return the acquisition settings
+ */
+const AcquisitionInfo &ADCSegmentTable::getInfo()
+{
+	return info;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file adcsegments.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the segment table used by the ZMOD ADC1410 segmented acquisition.
+ */
+
+#include "zmodadc1410.h"
+#include "acquisitionblock.h"
+
+#ifndef _ADCSEGMENTS_H
+#define  _ADCSEGMENTS_H
+
+/**
+ * Struct containing the metadata of an acquired segment.
+ */
+typedef struct _SegmentInfo {
+	uint32_t index; ///< index of the segment in the table
+	uint64_t timestamp; ///< time the buffer full was detected, in nanoseconds (see fnGetTimeNs)
+	ZMODTimestamps times; ///< times of the acquisition steps of the segment
+	uint64_t rearmLatencyNs; ///< time from the previous buffer full to arming the ADC, 0 for the first segment
+	uint32_t missedTriggers; ///< estimated triggers lost before this segment, 0 if the trigger period is unknown
+	double triggerTime; ///< interpolated position of the trigger crossing in the segment, in samples (see fnInterpolateTrigger)
+} SegmentInfo;
+
+/**
+ * Class holding a preallocated region of consecutive segments, each receiving one
+ * triggered acquisition of ZMODADC1410::acquireSegmentedPolling, with its metadata.
+ */
+class ADCSegmentTable {
+	friend class ZMODADC1410;
+
+private:
+	ZMODADC1410 *adc; ///< the ADC used for acquisition
+	uint32_t *buffer; ///< raw DMA buffer holding all the segments
+	size_t length; ///< number of samples of each segment
+	uint32_t segments; ///< number of segments
+	SegmentInfo *segmentInfo; ///< [segment] metadata
+	uint32_t acquired; ///< number of segments acquired by the last acquisition
+	uint32_t missedTriggers; ///< estimated missed triggers of the last acquisition
+	uint32_t timeouts; ///< number of trigger timeouts of the last acquisition
+	uint64_t maxRearmLatencyNs; ///< maximum rearm latency of the last acquisition
+	AcquisitionInfo info; ///< settings of the last acquisition
+
+public:
+	ADCSegmentTable(ZMODADC1410 *adc, size_t &length, uint32_t segments);
+	~ADCSegmentTable();
+	ADCSegmentTable(const ADCSegmentTable &) = delete; ///< not copyable, owns its buffers
+	ADCSegmentTable &operator=(const ADCSegmentTable &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	void reset();
+
+	size_t getLength();
+	uint32_t getSegmentCount();
+	uint32_t getAcquiredCount();
+	uint32_t *getSegment(uint32_t segment);
+	const SegmentInfo *getSegmentInfo(uint32_t segment);
+	uint32_t getMissedTriggers();
+	uint32_t getTimeouts();
+	uint64_t getMaxRearmLatencyNs();
+	const AcquisitionInfo &getInfo();
+};
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ * @file adcspectrogram.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the continuous spectrogram (STFT) of a streamed ZMOD ADC1410 channel.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "adcspectrogram.h"
+
+#define ADCSPECTROGRAM_MIN_DB	-300.0f	///< magnitude reported for empty bins
+
+/**
+ * Create a spectrogram.
+ *
+ * @param size the FFT size, power of 2
+ * @param hop the number of samples between the starts of consecutive frames,
+ *  smaller than size for overlapping frames, 0 is treated as size
+ * @param rows the number of frames kept in the circular buffer
+ * @param window the window applied to the samples of each frame
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param threads the number of threads computing the frames, including the caller of process,
+ *  limited to ADCSPECTROGRAM_MAX_THREADS; always 1 on baremetal platforms
+ */
+ADCSpectrogram::ADCSpectrogram(size_t size, size_t hop, size_t rows, enum adc_window window, uint8_t channel, uint8_t threads)
+		: fft(size)
+{
+	float windowSum = 0;
+
+	this->size = size;
+	this->hop = hop ? hop : size;
+	this->rows = rows ? rows : 1;
+	this->channel = channel ? 1 : 0;
+#ifdef LINUX_APP
+	this->threads = threads < 1 ? 1 : (threads > ADCSPECTROGRAM_MAX_THREADS ? ADCSPECTROGRAM_MAX_THREADS : threads);
+#else
+	(void)threads;
+	this->threads = 1;
+#endif // LINUX_APP
+
+	windowCoefs = (float *)malloc(size * sizeof(float));
+	waterfall = (float *)malloc(this->rows * (size / 2 + 1) * sizeof(float));
+	carry = (uint32_t *)malloc(size * sizeof(uint32_t));
+	if(windowCoefs)
+	{
+		fnComputeWindow(window, windowCoefs, size);
+		for(size_t i = 0; i < size; i++)
+		{
+			windowSum += windowCoefs[i];
+		}
+	}
+	// dBFS = 10 * log10(|X|^2) + 20 * log10(2 / (8192 * sum(w)))
+	dbOffset = (float)(20.0 * log10(2.0 / ((double)(1<<13) * (windowSum > 0 ? windowSum : 1))));
+
+	memset(workers, 0, sizeof(workers));
+	for(uint8_t i = 0; i < this->threads; i++)
+	{
+		workers[i].spectrogram = this;
+		workers[i].index = i;
+		workers[i].frame = (float *)malloc(size * sizeof(float));
+		workers[i].re = (float *)malloc((size / 2 + 1) * sizeof(float));
+		workers[i].im = (float *)malloc((size / 2 + 1) * sizeof(float));
+	}
+	batchBuffer = NULL;
+	batchFirst = 0;
+	batchCount = 0;
+	batchFrame = 0;
+	reset();
+
+#ifdef LINUX_APP
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&startCond, NULL);
+	pthread_cond_init(&doneCond, NULL);
+	batchGeneration = 0;
+	batchDone = 0;
+	quit = false;
+	for(uint8_t i = 1; i < this->threads; i++)
+	{
+		if(pthread_create(&workers[i].thread, NULL, threadMain, &workers[i]))
+		{
+			// run with the threads created so far
+			this->threads = i;
+			break;
+		}
+	}
+#endif // LINUX_APP
+}
+
+/**
+ * Spectrogram destructor. Stops the worker threads.
+ */
+ADCSpectrogram::~ADCSpectrogram()
+{
+#ifdef LINUX_APP
+	pthread_mutex_lock(&mutex);
+	quit = true;
+	pthread_cond_broadcast(&startCond);
+	pthread_mutex_unlock(&mutex);
+	for(uint8_t i = 1; i < threads; i++)
+	{
+		pthread_join(workers[i].thread, NULL);
+	}
+	pthread_cond_destroy(&doneCond);
+	pthread_cond_destroy(&startCond);
+	pthread_mutex_destroy(&mutex);
+#endif // LINUX_APP
+	for(uint8_t i = 0; i < ADCSPECTROGRAM_MAX_THREADS; i++)
+	{
+		free(workers[i].frame);
+		free(workers[i].re);
+		free(workers[i].im);
+	}
+	free(windowCoefs);
+	free(waterfall);
+	free(carry);
+}
+
+/**
+ * Check that the spectrogram was created successfully.
+ *
+ * @return true if the FFT size is valid and all the buffers are allocated
+ */
+bool ADCSpectrogram::isValid()
+{
+	if(!fft.isValid() || !windowCoefs || !waterfall || !carry)
+	{
+		return false;
+	}
+	for(uint8_t i = 0; i < threads; i++)
+	{
+		if(!workers[i].frame || !workers[i].re || !workers[i].im)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Get the number of bins of a frame, from DC to Nyquist frequency.
+ *
+ * @return size / 2 + 1
+ */
+size_t ADCSpectrogram::getBins()
+{
+	return size / 2 + 1;
+}
+
+/**
+ * Get the number of frames kept in the circular buffer.
+ *
+ * @return the number of rows
+ */
+size_t ADCSpectrogram::getRows()
+{
+	return rows;
+}
+
+/**
+ * Drop the stream history and the computed frames, starting a new stream.
+ */
+void ADCSpectrogram::reset()
+{
+	frames = 0;
+	carryLen = 0;
+	nextStart = 0;
+}
+
+#ifdef LINUX_APP
+/**
+ * Main function of the worker threads: computes its share of the frames of each batch.
+ *
+ * @param data the ADCSpectrogramWorker of the thread
+ *
+ * @return NULL
+ */
+void *ADCSpectrogram::threadMain(void *data)
+{
+	ADCSpectrogramWorker *worker = (ADCSpectrogramWorker *)data;
+	ADCSpectrogram *s = worker->spectrogram;
+	uint32_t seen = 0;
+	bool stopping;
+
+	while(true)
+	{
+		pthread_mutex_lock(&s->mutex);
+		while(!s->quit && s->batchGeneration == seen)
+		{
+			pthread_cond_wait(&s->startCond, &s->mutex);
+		}
+		seen = s->batchGeneration;
+		stopping = s->quit; // read with the mutex held, the destructor writes it
+		pthread_mutex_unlock(&s->mutex);
+		if(stopping)
+		{
+			break;
+		}
+
+		s->computeFrames(worker);
+
+		pthread_mutex_lock(&s->mutex);
+		if(++s->batchDone == s->threads - 1)
+		{
+			pthread_cond_signal(&s->doneCond);
+		}
+		pthread_mutex_unlock(&s->mutex);
+	}
+	return NULL;
+}
+#endif // LINUX_APP
+
+/**
+ * Compute the frames of the current batch assigned to a thread.
+ *
+ * @param worker the data of the thread
+ */
+void ADCSpectrogram::computeFrames(ADCSpectrogramWorker *worker)
+{
+	uint8_t shift = channel ? 16 : 0;
+	size_t bins = size / 2 + 1;
+
+	for(size_t k = worker->index; k < batchCount; k += threads)
+	{
+		size_t start = batchFirst + k * hop;
+		size_t fromCarry = 0, i;
+		float *out = waterfall + ((batchFrame + k) % rows) * bins;
+
+		// conversion and window in one pass, taking the elements from carry then from the buffer
+		if(start < carryLen)
+		{
+			fromCarry = carryLen - start;
+			fromCarry = (fromCarry < size) ? fromCarry : size;
+			for(i = 0; i < fromCarry; i++)
+			{
+				worker->frame[i] = (float)((int32_t)(carry[start + i] << shift) >> 18) * windowCoefs[i];
+			}
+		}
+		const uint32_t *src = batchBuffer + (start + fromCarry - carryLen);
+		for(i = fromCarry; i < size; i++)
+		{
+			worker->frame[i] = (float)((int32_t)(src[i - fromCarry] << shift) >> 18) * windowCoefs[i];
+		}
+
+		fft.forward(worker->frame, worker->re, worker->im);
+
+		for(i = 0; i < bins; i++)
+		{
+			float p = worker->re[i] * worker->re[i] + worker->im[i] * worker->im[i];
+			out[i] = (p > 0) ? 10.0f * log10f(p) + dbOffset : ADCSPECTROGRAM_MIN_DB;
+		}
+		// DC and Nyquist bins are not doubled
+		out[0] -= (out[0] > ADCSPECTROGRAM_MIN_DB) ? 6.0206f : 0;
+		out[bins - 1] -= (out[bins - 1] > ADCSPECTROGRAM_MIN_DB) ? 6.0206f : 0;
+	}
+}
+
+/**
+ * Compute the frames completed by a new buffer of the stream.
+ * When a buffer completes more frames than rows, only the last rows frames are computed,
+ * the older ones being counted as written and overwritten.
+ *
+ * @param buffer the raw buffer, as acquired from the ZMOD ADC1410
+ * @param length the number of elements in the buffer
+ */
+void ADCSpectrogram::process(const uint32_t *buffer, size_t length)
+{
+	size_t total = carryLen + length;
+	size_t first = nextStart, count = 0;
+
+	if(!isValid())
+	{
+		return;
+	}
+	if(first + size <= total)
+	{
+		count = (total - size - first) / hop + 1;
+	}
+	if(count > rows)
+	{
+		first += (count - rows) * hop;
+		frames += count - rows;
+		count = rows;
+	}
+
+	if(count)
+	{
+		batchBuffer = buffer;
+		batchFirst = first;
+		batchCount = count;
+		batchFrame = frames;
+#ifdef LINUX_APP
+		if(threads > 1)
+		{
+			pthread_mutex_lock(&mutex);
+			batchDone = 0;
+			batchGeneration++;
+			pthread_cond_broadcast(&startCond);
+			pthread_mutex_unlock(&mutex);
+		}
+#endif // LINUX_APP
+		computeFrames(&workers[0]);
+#ifdef LINUX_APP
+		if(threads > 1)
+		{
+			pthread_mutex_lock(&mutex);
+			while(batchDone < threads - 1)
+			{
+				pthread_cond_wait(&doneCond, &mutex);
+			}
+			pthread_mutex_unlock(&mutex);
+		}
+#endif // LINUX_APP
+		frames += count;
+	}
+
+	// keep the elements needed by the next frames
+	nextStart = first + count * hop;
+	if(nextStart >= total)
+	{
+		nextStart -= total;
+		carryLen = 0;
+		return;
+	}
+	if(nextStart < carryLen)
+	{
+		memmove(carry, carry + nextStart, (carryLen - nextStart) * sizeof(uint32_t));
+		memcpy(carry + (carryLen - nextStart), buffer, length * sizeof(uint32_t));
+	}
+	else
+	{
+		memcpy(carry, buffer + (nextStart - carryLen), (total - nextStart) * sizeof(uint32_t));
+	}
+	carryLen = total - nextStart;
+	nextStart = 0;
+}
+
+/**
+ * Get the number of frames written since the last reset.
+ *
+ * @return the number of frames, the number of the next frame to be written
+ */
+uint64_t ADCSpectrogram::getFrameCount()
+{
+	return frames;
+}
+
+/**
+ * Get the dBFS magnitudes of a frame (see ADCSpectrum::getMagnitudeDbfs).
+ * Must not be called concurrently with process.
+ *
+ * @param frame the number of the frame, counted from the last reset
+ *
+ * @return the getBins() magnitudes of the frame, NULL if the frame is not yet written
+ *  or was overwritten
+ */
+const float *ADCSpectrogram::getFrame(uint64_t frame)
+{
+	if(frame >= frames || frames - frame > rows)
+	{
+		return NULL;
+	}
+	return waterfall + (frame % rows) * (size / 2 + 1);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file adcspectrogram.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the continuous spectrogram (STFT) of a streamed ZMOD ADC1410 channel.
+ */
+
+#include "zmodadc1410.h"
+#include "adcfft.h"
+#include "adcspectrum.h"
+
+#ifdef LINUX_APP
+#include <pthread.h>
+#endif // LINUX_APP
+
+#ifndef _ADCSPECTROGRAM_H
+#define  _ADCSPECTROGRAM_H
+
+#define ADCSPECTROGRAM_MAX_THREADS	8	///< maximum number of threads computing the frames
+
+class ADCSpectrogram;
+
+/**
+ * Struct containing the data of a thread computing spectrogram frames.
+ */
+typedef struct _ADCSpectrogramWorker {
+	ADCSpectrogram *spectrogram; ///< the spectrogram the thread belongs to
+	uint8_t index; ///< index of the thread, the frames k with k % threads == index are computed by it
+	float *frame; ///< windowed samples of the current frame
+	float *re; ///< real parts of the current frame spectrum
+	float *im; ///< imaginary parts of the current frame spectrum
+#ifdef LINUX_APP
+	pthread_t thread; ///< the thread, unused for index 0 (the caller of process)
+#endif // LINUX_APP
+} ADCSpectrogramWorker;
+
+/**
+ * Class computing a continuous short-time FFT over the stream of buffers of a ZMOD ADC1410 channel.
+ * Frames of fftSize samples start every hop samples of the stream, including frames spanning
+ * two consecutive buffers. The dBFS magnitude of each frame is written into a circular
+ * buffer of rows (a waterfall), frame n going to row n % rows, so the frame order is kept
+ * regardless of which thread computed it.
+ *
+ * On Linux, the frames of each buffer are spread across worker threads; process returns once
+ * all the frames of the buffer are written, so the caller can reuse the buffer.
+ */
+class ADCSpectrogram {
+private:
+	ADCFFT fft; ///< FFT plan, shared by the threads
+	size_t size; ///< FFT size
+	size_t hop; ///< number of samples between the starts of consecutive frames
+	size_t rows; ///< number of rows of the circular buffer
+	uint8_t channel; ///< 0 for channel 1, 1 for channel 2
+	float *windowCoefs; ///< window coefficients
+	float dbOffset; ///< dB value of a full scale sine wave, before normalization
+	float *waterfall; ///< rows x bins dBFS magnitudes
+	uint64_t frames; ///< number of frames written since the last reset
+	uint32_t *carry; ///< stream elements of the previous buffers, needed by the next frames
+	size_t carryLen; ///< number of elements in carry
+	size_t nextStart; ///< start of the next frame, relative to the first element of carry
+	uint8_t threads; ///< number of threads, including the caller of process
+	ADCSpectrogramWorker workers[ADCSPECTROGRAM_MAX_THREADS]; ///< threads data
+
+	// frames of the buffer being processed
+	const uint32_t *batchBuffer; ///< the buffer being processed
+	size_t batchFirst; ///< start of the first frame, relative to the first element of carry
+	size_t batchCount; ///< number of frames to compute
+	uint64_t batchFrame; ///< number of the first frame
+
+#ifdef LINUX_APP
+	pthread_mutex_t mutex; ///< protects the batch synchronization fields
+	pthread_cond_t startCond; ///< signaled when a batch is ready
+	pthread_cond_t doneCond; ///< signaled when all the threads finished the batch
+	uint32_t batchGeneration; ///< incremented for each batch
+	uint8_t batchDone; ///< number of threads that finished the batch
+	bool quit; ///< set to stop the threads
+	static void *threadMain(void *data);
+#endif // LINUX_APP
+
+	void computeFrames(ADCSpectrogramWorker *worker);
+
+public:
+	ADCSpectrogram(size_t size, size_t hop, size_t rows, enum adc_window window, uint8_t channel, uint8_t threads);
+	~ADCSpectrogram();
+	ADCSpectrogram(const ADCSpectrogram &) = delete; ///< not copyable, owns its buffers
+	ADCSpectrogram &operator=(const ADCSpectrogram &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	size_t getBins();
+	size_t getRows();
+	void reset();
+	void process(const uint32_t *buffer, size_t length);
+
+	uint64_t getFrameCount();
+	const float *getFrame(uint64_t frame);
+};
+
+#endif
@@ -0,0 +1,279 @@
+/**
+ * @file adcspectrum.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the spectrum analyzer stage for ZMOD ADC1410 acquisitions.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "adcspectrum.h"
+
+#define ADCSPECTRUM_MIN_DB	-300.0f	///< magnitude reported for empty bins
+
+/**
+ * Compute the coefficients of a periodic window, as used for spectral analysis.
+ *
+ * @param window the window type
+ * @param coefs the array receiving the coefficients
+ * @param size the number of coefficients
+ */
+void fnComputeWindow(enum adc_window window, float *coefs, size_t size)
+{
+	// cosine sum coefficients of each window
+	static const double hann[] = { 0.5, 0.5 };
+	static const double blackmanHarris[] = { 0.35875, 0.48829, 0.14128, 0.01168 };
+	static const double flatTop[] = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 };
+	const double *a;
+	uint8_t terms;
+
+	switch(window)
+	{
+	case ADC_WINDOW_HANN:
+		a = hann;
+		terms = sizeof(hann) / sizeof(hann[0]);
+		break;
+	case ADC_WINDOW_BLACKMAN_HARRIS:
+		a = blackmanHarris;
+		terms = sizeof(blackmanHarris) / sizeof(blackmanHarris[0]);
+		break;
+	case ADC_WINDOW_FLAT_TOP:
+		a = flatTop;
+		terms = sizeof(flatTop) / sizeof(flatTop[0]);
+		break;
+	default:
+		for(size_t i = 0; i < size; i++)
+		{
+			coefs[i] = 1.0f;
+		}
+		return;
+	}
+
+	for(size_t i = 0; i < size; i++)
+	{
+		double w = 0;
+		for(uint8_t t = 0; t < terms; t++)
+		{
+			double c = a[t] * cos(2.0 * M_PI * (double)t * (double)i / (double)size);
+			w += (t & 1) ? -c : c;
+		}
+		coefs[i] = (float)w;
+	}
+}
+
+/**
+ * Create a spectrum analyzer stage.
+ *
+ * @param size the FFT size, power of 2 (for example 16384 for a full ZmodADC1410 buffer)
+ * @param window the window applied to the samples
+ */
+ADCSpectrum::ADCSpectrum(size_t size, enum adc_window window) : fft(size)
+{
+	this->size = size;
+	this->window = window;
+	windowCoefs = (float *)malloc(size * sizeof(float));
+	shortCoefs = (float *)malloc(size * sizeof(float));
+	shortLength = 0;
+	shortSum = 0;
+	frame = (float *)malloc(size * sizeof(float));
+	re = (float *)malloc((size / 2 + 1) * sizeof(float));
+	im = (float *)malloc((size / 2 + 1) * sizeof(float));
+	power = (double *)malloc((size / 2 + 1) * sizeof(double));
+	windowSum = 0;
+	if(windowCoefs)
+	{
+		fnComputeWindow(window, windowCoefs, size);
+		for(size_t i = 0; i < size; i++)
+		{
+			windowSum += windowCoefs[i];
+		}
+	}
+	reset();
+}
+
+/**
+ * Spectrum analyzer stage destructor.
+ */
+ADCSpectrum::~ADCSpectrum()
+{
+	free(windowCoefs);
+	free(shortCoefs);
+	free(frame);
+	free(re);
+	free(im);
+	free(power);
+}
+
+/**
+ * Check that the stage was created successfully.
+ *
+ * @return true if the FFT size is valid and all the buffers are allocated
+ */
+bool ADCSpectrum::isValid()
+{
+	return fft.isValid() && windowCoefs && shortCoefs && frame && re && im && power;
+}
+
+/**
+ * Get the number of bins of the spectrum, from DC to Nyquist frequency.
+ *
+ * @return size / 2 + 1
+ */
+size_t ADCSpectrum::getBins()
+{
+	return size / 2 + 1;
+}
+
+/**
+ * Get the frequency of a bin.
+ *
+ * @param bin the bin index
+ *
+ * @return the frequency in Hz
+ */
+float ADCSpectrum::getBinFrequency(size_t bin)
+{
+	return (float)((double)bin * ZMODADC1410_SAMPLE_RATE / (double)size);
+}
+
+/**
+ * Get the number of segments averaged since the last reset.
+ *
+ * @return the number of averages
+ */
+uint32_t ADCSpectrum::getAverages()
+{
+	return averages;
+}
+
+/**
+ * Clear the averaged spectrum.
+ */
+void ADCSpectrum::reset()
+{
+	if(power)
+	{
+		memset(power, 0, (size / 2 + 1) * sizeof(double));
+	}
+	averages = 0;
+}
+
+/**
+ * Convert, window and transform one segment, then accumulate its squared magnitude.
+ * A segment shorter than the FFT size is windowed over its own length, and its magnitude
+ * is scaled by windowSum over the sum of its coefficients, so that all the segments are
+ * normalized as full ones. The coefficients are kept for the next segment of the same length.
+ *
+ * @param buffer the first raw buffer element of the segment
+ * @param length the number of elements, zero padded up to the FFT size
+ * @param channel 0 for channel 1, 1 for channel 2
+ */
+void ADCSpectrum::processSegment(const uint32_t *buffer, size_t length, uint8_t channel)
+{
+	uint8_t shift = channel ? 16 : 0;
+	const float *coefs = windowCoefs;
+	double scale = 1;
+	size_t i;
+
+	if(length < size)
+	{
+		if(length != shortLength)
+		{
+			fnComputeWindow(window, shortCoefs, length);
+			shortSum = 0;
+			for(i = 0; i < length; i++)
+			{
+				shortSum += shortCoefs[i];
+			}
+			shortLength = length;
+		}
+		coefs = shortCoefs;
+		scale = shortSum > 0 ? ((double)windowSum / shortSum) * ((double)windowSum / shortSum) : 0;
+	}
+
+	// conversion and window in one pass
+	for(i = 0; i < length; i++)
+	{
+		frame[i] = (float)((int32_t)(buffer[i] << shift) >> 18) * coefs[i];
+	}
+	for(; i < size; i++)
+	{
+		frame[i] = 0;
+	}
+
+	fft.forward(frame, re, im);
+
+	for(i = 0; i <= size / 2; i++)
+	{
+		power[i] += ((double)re[i] * re[i] + (double)im[i] * im[i]) * scale;
+	}
+	averages++;
+}
+
+/**
+ * Add the spectrum of a channel of an acquisition to the average.
+ * Acquisitions longer than the FFT size are split in segments overlapping by half of the FFT size,
+ * shorter ones are windowed over their length and zero padded.
+ *
+ * @param buffer the raw buffer, as acquired from the ZMOD ADC1410
+ * @param length the number of elements in the buffer
+ * @param channel 0 for channel 1, 1 for channel 2
+ */
+void ADCSpectrum::process(const uint32_t *buffer, size_t length, uint8_t channel)
+{
+	size_t hop = size / 2;
+
+	if(!isValid() || !length)
+	{
+		return;
+	}
+	if(length <= size)
+	{
+		processSegment(buffer, length, channel);
+		return;
+	}
+	for(size_t start = 0; start + size <= length; start += hop)
+	{
+		processSegment(buffer + start, size, channel);
+	}
+}
+
+/**
+ * Get the averaged magnitude spectrum in dBFS: 0 dBFS is the amplitude
+ * of a full scale sine wave (8192 signed raw units peak).
+ *
+ * @param magnitude the array receiving getBins() values
+ */
+void ADCSpectrum::getMagnitudeDbfs(float *magnitude)
+{
+	// peak amplitude of a bin is 2 * |X| / sum(w), except for DC and Nyquist
+	double fullScale = (double)(1<<13) * windowSum;
+
+	for(size_t i = 0; i <= size / 2; i++)
+	{
+		double p = averages ? power[i] / averages : 0;
+		double amplitude = sqrt(p) * ((i == 0 || i == size / 2) ? 1.0 : 2.0);
+		magnitude[i] = (p > 0) ? (float)(20.0 * log10(amplitude / fullScale)) : ADCSPECTRUM_MIN_DB;
+	}
+}
+
+/**
+ * Get the averaged magnitude spectrum in dBV: 0 dBV is a sine wave of 1 V RMS.
+ *
+ * @param magnitude the array receiving getBins() values
+ * @param gain the gain of the channel during the acquisitions: 0 LOW and 1 HIGH
+ */
+void ADCSpectrum::getMagnitudeDbv(float *magnitude, uint8_t gain)
+{
+	// dBV = dBFS + level of the full scale sine wave, in dBV
+	float fullScaleDbv = (float)(20.0 * log10((double)(1<<13) * ZMODADC1410_VOLT_PER_LSB(gain) / sqrt(2.0)));
+
+	getMagnitudeDbfs(magnitude);
+	for(size_t i = 0; i <= size / 2; i++)
+	{
+		if(magnitude[i] > ADCSPECTRUM_MIN_DB)
+		{
+			magnitude[i] += fullScaleDbv;
+		}
+	}
+}
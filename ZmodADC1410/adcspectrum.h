@@ -0,0 +1,71 @@
+/**
+ * @file adcspectrum.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the spectrum analyzer stage for ZMOD ADC1410 acquisitions.
+ */
+
+#include "zmodadc1410.h"
+#include "adcfft.h"
+
+#ifndef _ADCSPECTRUM_H
+#define  _ADCSPECTRUM_H
+
+/**
+ * Window applied to the samples before the FFT.
+ */
+enum adc_window {
+	ADC_WINDOW_RECTANGULAR, ///< no window
+	ADC_WINDOW_HANN, ///< Hann window
+	ADC_WINDOW_BLACKMAN_HARRIS, ///< 4 terms Blackman-Harris window, for high dynamic range
+	ADC_WINDOW_FLAT_TOP, ///< flat-top window, for accurate amplitudes
+};
+
+void fnComputeWindow(enum adc_window window, float *coefs, size_t size);
+
+/**
+ * Class computing the magnitude spectrum of ZMOD ADC1410 acquisitions.
+ * The FFT plan, window coefficients and work buffers are allocated once, at construction,
+ * so back-to-back acquisitions are processed without allocations.
+ * Successive calls to process are averaged (Welch method) until reset is called;
+ * inside an acquisition longer than the FFT size, segments overlap by half of the FFT size.
+ *
+ * The samples are already calibrated by the ZmodADC1410 IP (see ZMODADC1410::readUserCalib),
+ * so the conversion to Volts only depends on the channel gain.
+ */
+class ADCSpectrum {
+private:
+	ADCFFT fft; ///< FFT plan
+	size_t size; ///< FFT size
+	float *windowCoefs; ///< window coefficients
+	float windowSum; ///< sum of the window coefficients (coherent gain * size)
+	enum adc_window window; ///< window applied to the samples
+	float *shortCoefs; ///< window coefficients of the records shorter than size
+	size_t shortLength; ///< number of coefficients in shortCoefs, 0 before the first short record
+	float shortSum; ///< sum of the coefficients in shortCoefs
+	float *frame; ///< windowed samples of the current segment
+	float *re; ///< real parts of the current segment spectrum
+	float *im; ///< imaginary parts of the current segment spectrum
+	double *power; ///< accumulated squared magnitudes
+	uint32_t averages; ///< number of accumulated segments
+
+	void processSegment(const uint32_t *buffer, size_t length, uint8_t channel);
+
+public:
+	ADCSpectrum(size_t size, enum adc_window window);
+	~ADCSpectrum();
+	ADCSpectrum(const ADCSpectrum &) = delete; ///< not copyable, owns its buffers
+	ADCSpectrum &operator=(const ADCSpectrum &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	size_t getBins();
+	float getBinFrequency(size_t bin);
+	uint32_t getAverages();
+
+	void reset();
+	void process(const uint32_t *buffer, size_t length, uint8_t channel);
+
+	void getMagnitudeDbfs(float *magnitude);
+	void getMagnitudeDbv(float *magnitude, uint8_t gain);
+};
+
+#endif
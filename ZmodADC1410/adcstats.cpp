@@ -0,0 +1,176 @@
+/**
+ * @file adcstats.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the single pass statistics over ZMOD ADC1410 raw buffers.
+ */
+
+#include <math.h>
+#include "adcstats.h"
+
+/**
+ * Number of samples processed with 32 bits accumulators before adding them to the 64 bits ones.
+ * 32 squared 14 bits values fit in 32 bits unsigned.
+ */
+#define ADCSTATS_BLOCK_LEN	32
+
+/**
+ * Create an empty statistics accumulator.
+ */
+ADCStats::ADCStats()
+{
+	reset();
+}
+
+/**
+ * Clear the accumulated statistics.
+ */
+void ADCStats::reset()
+{
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		acc[channel].count = 0;
+		acc[channel].min = INT16_MAX;
+		acc[channel].max = INT16_MIN;
+		acc[channel].sum = 0;
+		acc[channel].sumSq = 0;
+	}
+}
+
+/**
+ * Accumulate the statistics of both channels over a raw buffer, reading it once.
+ * The buffer is processed in blocks, each block using a loop without branches and
+ * with 32 bits accumulators, that is vectorized by the compiler.
+ *
+ * @param buffer the raw buffer, as acquired from the ZMOD ADC1410
+ * @param length the number of elements in the buffer
+ */
+void ADCStats::update(const uint32_t *buffer, size_t length)
+{
+	int16_t min1 = acc[0].min, max1 = acc[0].max;
+	int16_t min2 = acc[1].min, max2 = acc[1].max;
+	int64_t sum1 = 0, sum2 = 0;
+	uint64_t sumSq1 = 0, sumSq2 = 0;
+	size_t i = 0;
+
+	while(i < length)
+	{
+		size_t blockLen = (length - i < ADCSTATS_BLOCK_LEN) ? (length - i) : ADCSTATS_BLOCK_LEN;
+		const uint32_t *block = buffer + i;
+		int32_t bSum1 = 0, bSum2 = 0;
+		uint32_t bSumSq1 = 0, bSumSq2 = 0;
+
+		for(size_t j = 0; j < blockLen; j++)
+		{
+			int16_t v1 = ZMODADC1410_SIGNED_CHANNEL_DATA(0, block[j]);
+			int16_t v2 = ZMODADC1410_SIGNED_CHANNEL_DATA(1, block[j]);
+			min1 = (v1 < min1) ? v1 : min1;
+			max1 = (v1 > max1) ? v1 : max1;
+			min2 = (v2 < min2) ? v2 : min2;
+			max2 = (v2 > max2) ? v2 : max2;
+			bSum1 += v1;
+			bSum2 += v2;
+			bSumSq1 += (uint32_t)(v1 * v1);
+			bSumSq2 += (uint32_t)(v2 * v2);
+		}
+		sum1 += bSum1;
+		sum2 += bSum2;
+		sumSq1 += bSumSq1;
+		sumSq2 += bSumSq2;
+		i += blockLen;
+	}
+
+	acc[0].count += length;
+	acc[0].min = min1;
+	acc[0].max = max1;
+	acc[0].sum += sum1;
+	acc[0].sumSq += sumSq1;
+	acc[1].count += length;
+	acc[1].min = min2;
+	acc[1].max = max2;
+	acc[1].sum += sum2;
+	acc[1].sumSq += sumSq2;
+}
+
+/**
+ * Add the statistics accumulated by another instance, as if its data had been passed to update.
+ *
+ * @param other the statistics to be merged
+ */
+void ADCStats::merge(const ADCStats &other)
+{
+	for(uint8_t channel = 0; channel < 2; channel++)
+	{
+		const ADCChannelAccumulator &o = other.acc[channel];
+		acc[channel].count += o.count;
+		acc[channel].min = (o.min < acc[channel].min) ? o.min : acc[channel].min;
+		acc[channel].max = (o.max > acc[channel].max) ? o.max : acc[channel].max;
+		acc[channel].sum += o.sum;
+		acc[channel].sumSq += o.sumSq;
+	}
+}
+
+/**
+ * Get the accumulated sums of a channel.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ *
+ * @return the accumulated sums, in signed raw units
+ */
+const ADCChannelAccumulator &ADCStats::getAccumulator(uint8_t channel) const
+{
+	return acc[channel ? 1 : 0];
+}
+
+/**
+ * Get the statistics of a channel, in signed raw units.
+ * All values are 0 if no sample was accumulated.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ *
+ * @return the statistics results
+ */
+ADCChannelStats ADCStats::getStats(uint8_t channel) const
+{
+	const ADCChannelAccumulator &a = acc[channel ? 1 : 0];
+	ADCChannelStats stats = { 0, 0, 0, 0, 0, 0, 0 };
+	double mean, meanSq, variance;
+
+	if(a.count == 0)
+	{
+		return stats;
+	}
+	mean = (double)a.sum / (double)a.count;
+	meanSq = (double)a.sumSq / (double)a.count;
+	variance = meanSq - mean * mean;
+
+	stats.count = a.count;
+	stats.min = a.min;
+	stats.max = a.max;
+	stats.peakToPeak = (float)(a.max - a.min);
+	stats.mean = (float)mean;
+	stats.rms = (float)sqrt(meanSq);
+	stats.stdDev = (float)sqrt(variance > 0 ? variance : 0);
+	return stats;
+}
+
+/**
+ * Get the statistics of a channel, in Volts.
+ *
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @param gain the gain of the channel during the acquisition: 0 LOW and 1 HIGH
+ *
+ * @return the statistics results
+ */
+ADCChannelStats ADCStats::getStatsVolt(uint8_t channel, uint8_t gain) const
+{
+	ADCChannelStats stats = getStats(channel);
+	float scale = ZMODADC1410_VOLT_PER_LSB(gain);
+
+	stats.min *= scale;
+	stats.max *= scale;
+	stats.peakToPeak *= scale;
+	stats.mean *= scale;
+	stats.rms *= scale;
+	stats.stdDev *= scale;
+	return stats;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file adcstats.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the single pass statistics over ZMOD ADC1410 raw buffers.
+ */
+
+#include "zmodadc1410.h"
+
+#ifndef _ADCSTATS_H
+#define  _ADCSTATS_H
+
+/**
+ * Struct containing the accumulated statistics of one channel, in signed raw units.
+ * The sums are kept exact, so accumulating buffer by buffer or merging
+ * partial results gives the same values as a single pass over all the data.
+ */
+typedef struct _ADCChannelAccumulator {
+	uint64_t count; ///< number of samples
+	int16_t min; ///< minimum value
+	int16_t max; ///< maximum value
+	int64_t sum; ///< sum of the values
+	uint64_t sumSq; ///< sum of the squared values
+} ADCChannelAccumulator;
+
+/**
+ * Struct containing the statistics results of one channel,
+ * either in signed raw units or in Volts.
+ */
+typedef struct _ADCChannelStats {
+	uint64_t count; ///< number of samples
+	float min; ///< minimum value
+	float max; ///< maximum value
+	float peakToPeak; ///< max - min
+	float mean; ///< mean value
+	float rms; ///< root mean square
+	float stdDev; ///< standard deviation (population)
+} ADCChannelStats;
+
+/**
+ * Class computing min, max, mean, RMS, peak-to-peak and standard deviation of both channels
+ * in one pass over ZMOD ADC1410 raw buffers. Statistics can be accumulated over a stream of
+ * buffers by calling update for each of them, and accumulators filled by different threads
+ * can be combined with merge.
+ */
+class ADCStats {
+private:
+	ADCChannelAccumulator acc[2]; ///< [channel 0:1] accumulated statistics
+
+public:
+	ADCStats();
+
+	void reset();
+	void update(const uint32_t *buffer, size_t length);
+	void merge(const ADCStats &other);
+
+	const ADCChannelAccumulator &getAccumulator(uint8_t channel) const;
+	ADCChannelStats getStats(uint8_t channel) const;
+	ADCChannelStats getStatsVolt(uint8_t channel, uint8_t gain) const;
+};
+
+#endif
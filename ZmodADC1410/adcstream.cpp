@@ -0,0 +1,331 @@
+/**
+ * @file adcstream.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the buffer stream handing ZMOD ADC1410 acquisitions to consumer threads.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "adcstream.h"
+
+#if defined(LINUX_APP) || defined(FAKE_APP)
+#include <sched.h>
+#endif // LINUX_APP || FAKE_APP
+
+/**
+ * Create a stream without consumers, allocating one DMA region for all the buffers,
+ * all initially free. The buffer length is limited to the maximum supported buffer
+ * length (0x3FFF), altering the value of the reference parameter accordingly.
+ * The acquisitions are immediate until setTrigger is called.
+ *
+ * @param adc the ZMOD ADC1410 instance used to acquire the data
+ * @param length the number of samples of each buffer - passed by reference
+ * @param count the number of buffers
+ */
+ADCStream::ADCStream(ZMODADC1410 *adc, size_t &length, uint32_t count)
+{
+	uint32_t *region;
+
+	if(length > ZMODADC1410_MAX_BUFFER_LEN)
+	{
+		length = ZMODADC1410_MAX_BUFFER_LEN;
+	}
+	this->adc = adc;
+	this->length = length;
+	this->count = count;
+	consumerCount = 0;
+	sequence = 0;
+	overruns = 0;
+	memset(&info, 0, sizeof(info));
+	info.trigMode = 1;
+	info.length = length;
+
+	buffers = (ADCStreamBuffer *)malloc(count * sizeof(ADCStreamBuffer));
+	freeBuffers = (ADCStreamBuffer **)malloc(count * sizeof(ADCStreamBuffer *));
+	region = adc->allocRecordBuffer(length * count);
+	if(!buffers || !freeBuffers || !region)
+	{
+		if(region)
+		{
+			adc->freeRecordBuffer(region, length * count);
+		}
+		free(buffers);
+		free(freeBuffers);
+		buffers = NULL;
+		freeBuffers = NULL;
+		freeCount = 0;
+		return;
+	}
+	for(uint32_t i = 0; i < count; i++)
+	{
+		ADCStreamBuffer *streamBuffer = &buffers[i];
+		memset(streamBuffer, 0, sizeof(ADCStreamBuffer));
+		streamBuffer->buffer = region + i * length;
+		freeBuffers[i] = streamBuffer;
+	}
+	freeCount = count;
+}
+
+/**
+ * Stream destructor. The buffers must not be used anymore by the consumer.
+ */
+ADCStream::~ADCStream()
+{
+	if(buffers)
+	{
+		adc->freeRecordBuffer(buffers[0].buffer, length * count);
+	}
+	free(buffers);
+	free(freeBuffers);
+}
+
+/**
+ * Check that the stream was allocated.
+ *
+ * @return true if the stream can be used
+ */
+bool ADCStream::isValid()
+{
+	return buffers != NULL;
+}
+
+/**
+ * Get the number of samples of each buffer.
+ *
+ * @return the buffer length
+ */
+size_t ADCStream::getLength()
+{
+	return length;
+}
+
+/**
+ * Get the number of buffers of the stream.
+ *
+ * @return the number of buffers
+ */
+uint32_t ADCStream::getBufferCount()
+{
+	return count;
+}
+
+/**
+ * Set the trigger parameters of the next acquisitions of the stream (acquisition thread only).
+ *
+ * @param channel the trigger channel, 0 for channel 1, 1 for channel 2
+ * @param mode the trigger mode, 0 for normal trigger, 1 for not trigger
+ * @param level the trigger level, signed raw value
+ * @param edge the trigger edge, 0 for rising edge, 1 for falling edge
+ * @param window the window position (index of the trigger sample in the buffer)
+ */
+void ADCStream::setTrigger(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window)
+{
+	info.trigChannel = channel;
+	info.trigMode = mode;
+	info.trigLevel = level;
+	info.trigEdge = edge;
+	info.window = window;
+}
+
+/**
+ * Set the number of samples of the next acquisitions of the stream (acquisition thread only).
+ * The length is limited to the buffer length, altering the value of the reference parameter
+ * accordingly; the length of each acquisition is in the info of its buffer.
+ *
+ * @param length the number of samples of the acquisitions - passed by reference
+ */
+void ADCStream::setAcquisitionLength(size_t &length)
+{
+	if(length > this->length)
+	{
+		length = this->length;
+	}
+	info.length = length;
+}
+
+/**
+ * Add a consumer, before the streaming starts.
+ * With the ADC_STREAM_BLOCK policy, the acquisitions wait for the consumer, which must
+ * run in another thread.
+ *
+ * @param policy the backpressure policy applied when the queue of the consumer is full
+ * @param depth the number of buffers the queue of the consumer can hold, rounded up to a power of 2
+ *
+ * @return the consumer number, to pass to receive and release, ERR_FAIL on failure
+ */
+int ADCStream::addConsumer(enum adc_stream_policy policy, uint32_t depth)
+{
+	ADCStreamConsumer *consumer;
+
+	if(consumerCount == ADCSTREAM_MAX_CONSUMERS)
+	{
+		return ERR_FAIL;
+	}
+	consumer = &consumers[consumerCount];
+	// the consumer releases last at most all the buffers
+	if(!consumer->ready.init(depth) || !consumer->returned.init(count))
+	{
+		return ERR_FAIL;
+	}
+	consumer->policy = policy;
+	consumer->delivered = 0;
+	consumer->dropped = 0;
+	return consumerCount++;
+}
+
+/**
+ * Take a free buffer for an acquisition (acquisition thread only), collecting first
+ * the buffers released by the consumers if needed.
+ *
+ * @return the buffer, NULL if all the buffers are held
+ */
+ADCStreamBuffer *ADCStream::takeFreeBuffer()
+{
+	if(!freeCount)
+	{
+		for(uint32_t c = 0; c < consumerCount; c++)
+		{
+			freeCount += consumers[c].returned.pop(freeBuffers + freeCount, count - freeCount);
+		}
+		if(!freeCount)
+		{
+			return NULL;
+		}
+	}
+	return freeBuffers[--freeCount];
+}
+
+/**
+ * Drop a reference to a buffer from the acquisition thread, freeing the buffer if it was the last one.
+ *
+ * @param streamBuffer the buffer
+ */
+void ADCStream::dropBuffer(ADCStreamBuffer *streamBuffer)
+{
+	if(__atomic_sub_fetch(&streamBuffer->refs, 1, __ATOMIC_ACQ_REL) == 0)
+	{
+		freeBuffers[freeCount++] = streamBuffer;
+	}
+}
+
+/**
+ * Queue an acquired buffer to every consumer, applying their backpressure policies
+ * (acquisition thread only).
+ *
+ * @param streamBuffer the buffer
+ */
+void ADCStream::publish(ADCStreamBuffer *streamBuffer)
+{
+	// the acquisition thread holds a reference until the buffer is queued to all the consumers
+	__atomic_store_n(&streamBuffer->refs, consumerCount + 1, __ATOMIC_RELAXED);
+	for(uint32_t c = 0; c < consumerCount; c++)
+	{
+		ADCStreamConsumer *consumer = &consumers[c];
+		bool queued = consumer->ready.push(streamBuffer);
+		while(!queued && consumer->policy != ADC_STREAM_SKIP)
+		{
+			ADCStreamBuffer *oldest;
+			if(consumer->policy == ADC_STREAM_DROP_OLDEST && consumer->ready.dropOldest(oldest))
+			{
+				__atomic_fetch_add(&consumer->dropped, 1, __ATOMIC_RELAXED);
+				dropBuffer(oldest);
+			}
+#if defined(LINUX_APP) || defined(FAKE_APP)
+			else
+			{
+				sched_yield();
+			}
+#endif // LINUX_APP || FAKE_APP
+			queued = consumer->ready.push(streamBuffer);
+		}
+		if(queued)
+		{
+			__atomic_fetch_add(&consumer->delivered, 1, __ATOMIC_RELAXED);
+		}
+		else
+		{
+			__atomic_fetch_add(&consumer->dropped, 1, __ATOMIC_RELAXED);
+			dropBuffer(streamBuffer);
+		}
+	}
+	dropBuffer(streamBuffer);
+}
+
+/**
+ * Take the buffers queued to a consumer, oldest first (consumer thread only). Each buffer
+ * stays valid until the consumer gives it back with release, and must only be read.
+ *
+ * @param consumer the consumer number returned by addConsumer
+ * @param received receives the pointers to the buffers
+ * @param maxCount the maximum number of buffers to take
+ *
+ * @return the number of buffers taken, 0 if none is ready
+ */
+size_t ADCStream::receive(int consumer, ADCStreamBuffer **received, size_t maxCount)
+{
+	ADCStreamConsumer *streamConsumer = &consumers[consumer];
+
+	if(streamConsumer->policy == ADC_STREAM_DROP_OLDEST)
+	{
+		return streamConsumer->ready.popShared(received, maxCount);
+	}
+	return streamConsumer->ready.pop(received, maxCount);
+}
+
+/**
+ * Give back buffers taken with receive (consumer thread only). A buffer returns to the
+ * free pool when the last consumer holding it releases it.
+ *
+ * @param consumer the consumer number returned by addConsumer
+ * @param released the pointers to the buffers
+ * @param releasedCount the number of buffers
+ */
+void ADCStream::release(int consumer, ADCStreamBuffer **released, size_t releasedCount)
+{
+	ADCStreamConsumer *streamConsumer = &consumers[consumer];
+
+	for(size_t i = 0; i < releasedCount; i++)
+	{
+		if(__atomic_sub_fetch(&released[i]->refs, 1, __ATOMIC_ACQ_REL) == 0)
+		{
+			// the returned ring holds all the buffers, so there is always room
+			streamConsumer->returned.push(released[i]);
+		}
+	}
+}
+
+/**
+ * Get the number of acquisitions not done because the consumers held all the buffers.
+ * Can be called from any thread.
+ *
+ * @return the number of overruns
+ */
+uint64_t ADCStream::getOverruns()
+{
+	return __atomic_load_n(&overruns, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get the number of buffers queued to a consumer. Can be called from any thread.
+ *
+ * @param consumer the consumer number returned by addConsumer
+ *
+ * @return the number of buffers delivered
+ */
+uint64_t ADCStream::getDelivered(int consumer)
+{
+	return __atomic_load_n(&consumers[consumer].delivered, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get the number of buffers a consumer did not read because of its backpressure policy:
+ * dropped from its queue (drop-oldest) or not queued (skip). Can be called from any thread.
+ *
+ * @param consumer the consumer number returned by addConsumer
+ *
+ * @return the number of buffers dropped
+ */
+uint64_t ADCStream::getDropped(int consumer)
+{
+	return __atomic_load_n(&consumers[consumer].dropped, __ATOMIC_RELAXED);
+}
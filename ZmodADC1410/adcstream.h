@@ -0,0 +1,102 @@
+/**
+ * @file adcstream.h
+ * @date 16 Oct 2026
+ * @brief File containing the definition of the buffer stream handing ZMOD ADC1410 acquisitions to consumer threads.
+ */
+
+#include "zmodadc1410.h"
+#include "acquisitionblock.h"
+#include "../Zmod/spscring.h"
+
+#ifndef _ADCSTREAM_H
+#define  _ADCSTREAM_H
+
+#define ADCSTREAM_MAX_CONSUMERS	8	///< maximum number of consumers of a stream
+
+/**
+ * Backpressure policies, applied to a consumer whose queue of buffers to read is full.
+ */
+enum adc_stream_policy {
+	ADC_STREAM_BLOCK, ///< the acquisition thread waits until the consumer releases a buffer
+	ADC_STREAM_DROP_OLDEST, ///< the oldest buffer queued for the consumer is dropped for the new one
+	ADC_STREAM_SKIP, ///< the new buffer is not given to the consumer
+};
+
+/**
+ * Struct containing a buffer of a stream and the metadata of the acquisition it holds.
+ * The buffer is shared by the consumers, which must only read it.
+ */
+typedef struct _ADCStreamBuffer {
+	uint32_t *buffer; ///< raw DMA buffer
+	uint64_t sequence; ///< number of the acquisition in the stream, gaps show the overruns and drops
+	AcquisitionInfo info; ///< settings and times of the acquisition
+	uint32_t refs; ///< number of consumers (and acquisition thread) holding the buffer
+} ADCStreamBuffer;
+
+/**
+ * Struct containing the queues and counters of a consumer of a stream.
+ */
+typedef struct _ADCStreamConsumer {
+	enum adc_stream_policy policy; ///< backpressure policy
+	SPSCRing<ADCStreamBuffer *> ready; ///< buffers to read, pushed by the acquisition thread
+	SPSCRing<ADCStreamBuffer *> returned; ///< buffers released last by the consumer, pushed by the consumer
+	uint64_t delivered; ///< buffers given to the consumer
+	uint64_t dropped; ///< buffers dropped or skipped by the policy
+} ADCStreamConsumer;
+
+/**
+ * Class holding a pool of DMA buffers circulating, without copies, between the acquisition
+ * thread and consumer threads. ZMODADC1410::acquireStreamPolling takes a free buffer and,
+ * when its DMA transfer completes, queues it to every consumer, according to the consumer
+ * backpressure policy; each consumer takes its buffers with receive, and gives them back
+ * with release. A buffer is reference counted, and returns to the free pool when the last
+ * consumer releases it. Each queue is a wait-free single producer single consumer ring
+ * (lock-free for the drop-oldest policy), so no lock is taken. When no buffer is free, the
+ * acquisition is not done and counted as an overrun; the pool needs at least the sum of the
+ * queue depths, plus the buffers the consumers hold while reading, to avoid overruns.
+ *
+ * The consumers are added before the streaming starts. The acquisition side methods
+ * (acquireStreamPolling, setTrigger, setAcquisitionLength) must be called from one thread,
+ * and receive and release of a consumer from one thread, which can differ between consumers.
+ */
+class ADCStream {
+	friend class ZMODADC1410;
+
+private:
+	ZMODADC1410 *adc; ///< the ADC used for acquisition
+	size_t length; ///< number of samples of each buffer
+	uint32_t count; ///< number of buffers
+	ADCStreamBuffer *buffers; ///< [count] buffers
+	ADCStreamBuffer **freeBuffers; ///< [count] stack of the free buffers, used by the acquisition thread only
+	uint32_t freeCount; ///< number of free buffers in the stack
+	ADCStreamConsumer consumers[ADCSTREAM_MAX_CONSUMERS]; ///< consumers
+	uint32_t consumerCount; ///< number of consumers
+	uint64_t sequence; ///< number of acquisitions attempted, including the overruns
+	uint64_t overruns; ///< number of acquisitions not done because no buffer was free
+	AcquisitionInfo info; ///< trigger settings of the acquisitions
+
+	ADCStreamBuffer *takeFreeBuffer();
+	void dropBuffer(ADCStreamBuffer *streamBuffer);
+	void publish(ADCStreamBuffer *streamBuffer);
+
+public:
+	ADCStream(ZMODADC1410 *adc, size_t &length, uint32_t count);
+	~ADCStream();
+	ADCStream(const ADCStream &) = delete; ///< not copyable, owns its buffers
+	ADCStream &operator=(const ADCStream &) = delete; ///< not copyable, owns its buffers
+
+	bool isValid();
+	size_t getLength();
+	uint32_t getBufferCount();
+	void setTrigger(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window);
+	void setAcquisitionLength(size_t &length);
+	int addConsumer(enum adc_stream_policy policy, uint32_t depth);
+
+	size_t receive(int consumer, ADCStreamBuffer **received, size_t maxCount);
+	void release(int consumer, ADCStreamBuffer **released, size_t releasedCount);
+	uint64_t getOverruns();
+	uint64_t getDelivered(int consumer);
+	uint64_t getDropped(int consumer);
+};
+
+#endif
@@ -0,0 +1,557 @@
+/**
+ * @file adctrigger.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the software trigger detection on ZMOD ADC1410 buffers.
+ */
+
+#include "adctrigger.h"
+
+#define ADCTRIGGER_BLOCK_LEN 64 ///< number of samples tested together before looking for the exact index
+
+/**
+ * Find the first level crossing of a channel in a raw buffer, as the hardware trigger would.
+ * The buffer is processed in blocks of ADCTRIGGER_BLOCK_LEN samples, tested with
+ * branch-free comparisons the compiler vectorizes; only the block containing the
+ * crossing is searched sample by sample.
+ *
+ * @param buffer the raw buffer, as acquired from the DMA
+ * @param length the number of samples in the buffer
+ * @param channel the channel to test: 0 for channel 1, 1 for channel 2
+ * @param level the trigger level, as a signed 14 bits raw value
+ * @param edge the trigger edge: 0 for rising edge (previous sample below the level,
+ *  sample at or above it), 1 for falling edge (previous sample above the level, sample
+ *  at or below it)
+ * @param previous the signed raw value of the sample preceding the buffer, to detect
+ *  a crossing on the first sample; use the level to ignore the first sample
+ *
+ * @return the index of the first sample after the crossing, length if there is none
+ */
+size_t fnFindEdge(const uint32_t *buffer, size_t length, uint8_t channel, int16_t level, uint32_t edge, int16_t previous)
+{
+	// a falling edge is a rising edge of the negated signal
+	int32_t sign = edge ? -1 : 1;
+	int32_t lvl = sign * level;
+	uint32_t shift = channel ? 16 : 0;
+	int32_t prev = sign * previous;
+
+	if(length == 0)
+	{
+		return 0;
+	}
+	if(prev < lvl && sign * ((int32_t)(buffer[0] << shift) >> 18) >= lvl)
+	{
+		return 0;
+	}
+
+	for(size_t block = 1; block < length; block += ADCTRIGGER_BLOCK_LEN)
+	{
+		size_t end = block + ADCTRIGGER_BLOCK_LEN < length ? block + ADCTRIGGER_BLOCK_LEN : length;
+		int32_t hit = 0;
+
+		for(size_t i = block; i < end; i++)
+		{
+			int32_t a = sign * ((int32_t)(buffer[i - 1] << shift) >> 18);
+			int32_t b = sign * ((int32_t)(buffer[i] << shift) >> 18);
+			hit |= (a < lvl) & (b >= lvl);
+		}
+		if(hit)
+		{
+			for(size_t i = block; i < end; i++)
+			{
+				int32_t a = sign * ((int32_t)(buffer[i - 1] << shift) >> 18);
+				int32_t b = sign * ((int32_t)(buffer[i] << shift) >> 18);
+				if(a < lvl && b >= lvl)
+				{
+					return i;
+				}
+			}
+		}
+	}
+
+	return length;
+}
+
+#define ADCTRIGGER_INTERP_SEARCH 2 ///< distance from the expected trigger index searched for the crossing, in samples
+
+/**
+ * Evaluate the Catmull-Rom cubic through four consecutive samples, between the second and the third.
+ *
+ * @param p the four samples
+ * @param t the position between the second (0) and the third (1) sample
+ *
+ * @return the interpolated value
+ */
+static inline double fnCubic(const double *p, double t)
+{
+	return p[1] + 0.5 * t * ((p[2] - p[0]) + t * ((2 * p[0] - 5 * p[1] + 4 * p[2] - p[3]) + t * (3 * (p[1] - p[2]) + p[3] - p[0])));
+}
+
+/**
+ * Compute the position of the trigger crossing with a sub-sample resolution. The crossing
+ * of the level nearest to the expected index (within ADCTRIGGER_INTERP_SEARCH samples) is
+ * located as the hardware trigger would (see fnFindEdge), then interpolated between the samples
+ * around it.
+ *
+ * @param buffer the raw buffer, as acquired from the DMA
+ * @param length the number of samples in the buffer
+ * @param channel the trigger channel: 0 for channel 1, 1 for channel 2
+ * @param level the trigger level, as a signed 14 bits raw value
+ * @param edge the trigger edge: 0 for rising edge, 1 for falling edge
+ * @param index the expected index of the trigger sample, the window of the acquisition
+ * @param interpolation the interpolation, see adc_interpolation
+ *
+ * @return the position where the interpolated signal crosses the level, in samples from the start of
+ *  the buffer (index - 1 < position <= index for a crossing at the expected index); index if no crossing is found
+ */
+double fnInterpolateTrigger(const uint32_t *buffer, size_t length, uint8_t channel, int16_t level, uint32_t edge,
+		size_t index, uint8_t interpolation)
+{
+	double sign = edge ? -1 : 1;
+	double lvl = sign * level;
+	double p[4];
+	double a = 0, b = 1, t;
+	size_t k = 0;
+
+	// nearest crossing between the samples k - 1 and k
+	for(size_t d = 0; d <= ADCTRIGGER_INTERP_SEARCH && !k; d++)
+	{
+		size_t candidates[2] = {index - d, index + d};
+		for(int c = 0; c < (d ? 2 : 1) && !k; c++)
+		{
+			size_t i = candidates[c];
+			if(i >= 1 && i < length && i <= index + ADCTRIGGER_INTERP_SEARCH &&
+					fnFindEdge(buffer + i, 1, channel, level, edge,
+							(int16_t)((int32_t)(buffer[i - 1] << (channel ? 16 : 0)) >> 18)) == 0)
+			{
+				k = i;
+			}
+		}
+	}
+	if(!k)
+	{
+		return (double)index;
+	}
+
+	// samples k - 2 .. k + 1, of the signal negated for the falling edge, repeated at the buffer ends
+	for(int j = 0; j < 4; j++)
+	{
+		size_t i = k + j < 2 ? 0 : k + j - 2;
+		if(i >= length)
+		{
+			i = length - 1;
+		}
+		p[j] = sign * ((int32_t)(buffer[i] << (channel ? 16 : 0)) >> 18);
+	}
+
+	// linear crossing, p[1] < lvl <= p[2]
+	t = (lvl - p[1]) / (p[2] - p[1]);
+	if(interpolation == ADC_INTERPOLATION_CUBIC)
+	{
+		// Newton iterations on the cubic, kept in the bracket [a, b] by bisection
+		for(int it = 0; it < 8; it++)
+		{
+			double f = fnCubic(p, t) - lvl;
+			double df = 0.5 * ((p[2] - p[0]) + t * (2 * (2 * p[0] - 5 * p[1] + 4 * p[2] - p[3]) + t * 3 * (3 * (p[1] - p[2]) + p[3] - p[0])));
+			double next;
+
+			if(f == 0)
+			{
+				break;
+			}
+			if(f < 0)
+			{
+				a = t;
+			}
+			else
+			{
+				b = t;
+			}
+			next = df != 0 ? t - f / df : (a + b) / 2;
+			if(next <= a || next >= b)
+			{
+				next = (a + b) / 2;
+			}
+			if(next - t < 1e-6 && t - next < 1e-6)
+			{
+				t = next;
+				break;
+			}
+			t = next;
+		}
+	}
+
+	return (double)(k - 1) + t;
+}
+
+/**
+ * Resample a signal shifted by a fraction of a sample, so that out[i] = in(i + shift).
+ * To align acquisitions on their interpolated trigger (see fnInterpolateTrigger),
+ * use the trigger position minus the window as shift: the crossing then lands on the window sample.
+ * The samples beyond the ends of the input repeat the first and last sample.
+ * The interior samples are computed with a 2 or 4 taps filter the compiler vectorizes.
+ *
+ * @param in the input signal
+ * @param out the shifted signal, must not overlap the input
+ * @param length the number of samples of the signals
+ * @param shift the shift, in samples
+ * @param interpolation the interpolation, see adc_interpolation
+ */
+void fnShiftSamples(const float *in, float *out, size_t length, double shift, uint8_t interpolation)
+{
+	double whole = shift >= 0 ? (double)(int64_t)shift : -(double)(int64_t)(-shift);
+	if(whole > shift)
+	{
+		whole -= 1;
+	}
+	int64_t n = (int64_t)whole;
+	float t = (float)(shift - whole);
+	float c[4];
+	int64_t len = (int64_t)length;
+	int64_t first, last;
+
+	if(length == 0)
+	{
+		return;
+	}
+	if(interpolation == ADC_INTERPOLATION_CUBIC)
+	{
+		c[0] = 0.5f * t * (-1 + t * (2 - t));
+		c[1] = 1 + 0.5f * t * t * (-5 + 3 * t);
+		c[2] = 0.5f * t * (1 + t * (4 - 3 * t));
+		c[3] = 0.5f * t * t * (t - 1);
+	}
+	else
+	{
+		c[0] = 0;
+		c[1] = 1 - t;
+		c[2] = t;
+		c[3] = 0;
+	}
+
+	// interior: the taps in[i + n - 1] .. in[i + n + 2] are all in the input
+	first = 1 - n;
+	last = len - 2 - n;
+	first = first < 0 ? 0 : (first > len ? len : first);
+	last = last > len ? len : (last < first ? first : last);
+	for(int64_t i = first; i < last; i++)
+	{
+		const float *src = in + (i + n - 1);
+		out[i] = c[0] * src[0] + c[1] * src[1] + c[2] * src[2] + c[3] * src[3];
+	}
+
+	// ends: the taps beyond the input repeat the first and last sample
+	for(int64_t i = first ? 0 : last; i < len; i = (i + 1 == first ? last : i + 1))
+	{
+		float v = 0;
+		for(int64_t j = 0; j < 4; j++)
+		{
+			int64_t k = i + n - 1 + j;
+			v += c[j] * in[k < 0 ? 0 : (k >= len ? len - 1 : k)];
+		}
+		out[i] = v;
+	}
+}
+
+/**
+ * Create a trigger engine with no condition on either channel.
+ */
+ADCTriggerEngine::ADCTriggerEngine()
+{
+	ADCTriggerCondition none = {};
+
+	none.type = ADC_TRIGGER_NONE;
+	setCondition(0, none);
+	setCondition(1, none);
+	setCombine(ADC_TRIGGER_OR, 0);
+	reset();
+}
+
+/**
+ * Set the trigger condition of a channel, and reset the state of the engine.
+ *
+ * @param channel the channel: 0 for channel 1, 1 for channel 2
+ * @param condition the condition, ADC_TRIGGER_NONE to exclude the channel from the trigger
+ */
+void ADCTriggerEngine::setCondition(uint8_t channel, const ADCTriggerCondition &condition)
+{
+	ADCTriggerChannelState *st = &state[channel];
+	int32_t hysteresis = condition.hysteresis < 0 ? -condition.hysteresis : condition.hysteresis;
+
+	this->condition[channel] = condition;
+	// the negative polarity conditions are evaluated on the negated signal
+	st->sign = (condition.polarity && condition.type != ADC_TRIGGER_WINDOW) ? -1 : 1;
+	switch(condition.type)
+	{
+	case ADC_TRIGGER_EDGE:
+	case ADC_TRIGGER_PULSE_WIDTH:
+		st->threshold[0] = st->sign * condition.level - hysteresis;
+		st->threshold[1] = st->sign * condition.level;
+		break;
+	case ADC_TRIGGER_RUNT:
+	case ADC_TRIGGER_SLEW_RATE:
+		st->threshold[0] = st->sign > 0 ? condition.low : -condition.high;
+		st->threshold[1] = st->sign > 0 ? condition.high : -condition.low;
+		break;
+	case ADC_TRIGGER_WINDOW:
+		// zone 1 is the inside of the band
+		st->threshold[0] = condition.low;
+		st->threshold[1] = condition.high + 1;
+		break;
+	default:
+		st->threshold[0] = 0;
+		st->threshold[1] = 0;
+		break;
+	}
+	reset();
+}
+
+/**
+ * Set the combination of the channel conditions, and reset the state of the engine.
+ * When only one channel has a condition, the combination has no effect.
+ *
+ * @param combine the combination, see adc_trigger_combine
+ * @param coincidence the maximum distance between the events of the two channels
+ *  for the AND combination, in samples
+ */
+void ADCTriggerEngine::setCombine(uint8_t combine, uint32_t coincidence)
+{
+	this->combine = combine;
+	this->coincidence = coincidence;
+	reset();
+}
+
+/**
+ * Reset the state of the conditions, and the position in the stream.
+ * The zones are unknown until the first sample of the next buffer.
+ */
+void ADCTriggerEngine::reset()
+{
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		state[ch].zone = 0xFF;
+		state[ch].armed = false;
+		state[ch].qualified = false;
+		state[ch].start = 0;
+		state[ch].lastEvent = 0;
+	}
+	position = 0;
+	triggerPosition = 0;
+}
+
+/**
+ * Run the state machine of a channel condition for one sample.
+ *
+ * @param channel the channel: 0 for channel 1, 1 for channel 2
+ * @param value the signed raw value of the sample
+ * @param position the position of the sample in the stream
+ *
+ * @return true if the condition of the channel has an event on this sample
+ */
+bool ADCTriggerEngine::step(uint8_t channel, int32_t value, uint64_t position)
+{
+	ADCTriggerChannelState *st = &state[channel];
+	const ADCTriggerCondition *cond = &condition[channel];
+	int32_t v = st->sign * value;
+	uint8_t zone = (v >= st->threshold[0]) + (v >= st->threshold[1]);
+	uint8_t prev = st->zone;
+	bool event = false;
+
+	if(zone == prev)
+	{
+		return false;
+	}
+	st->zone = zone;
+	if(prev == 0xFF)
+	{
+		// first sample: only arm, the conditions need a transition
+		st->armed = (zone == 0) && (cond->type == ADC_TRIGGER_EDGE || cond->type == ADC_TRIGGER_PULSE_WIDTH);
+		return false;
+	}
+
+	switch(cond->type)
+	{
+	case ADC_TRIGGER_EDGE:
+		if(zone == 0)
+		{
+			st->armed = true;
+		}
+		else if(zone == 2 && st->armed)
+		{
+			st->armed = false;
+			event = true;
+		}
+		break;
+	case ADC_TRIGGER_PULSE_WIDTH:
+		// qualified: pulse in progress, started at the crossing of the level
+		if(zone == 2 && st->armed)
+		{
+			st->armed = false;
+			st->qualified = true;
+			st->start = position;
+		}
+		else if(zone == 0)
+		{
+			if(st->qualified)
+			{
+				uint64_t width = position - st->start;
+				event = cond->less ? width < cond->time : width > cond->time;
+			}
+			st->armed = true;
+			st->qualified = false;
+		}
+		break;
+	case ADC_TRIGGER_RUNT:
+		// armed: pulse in progress, started from below the low level; qualified: it reached the high level
+		if(zone == 0)
+		{
+			event = st->armed && !st->qualified;
+			st->armed = false;
+			st->qualified = false;
+		}
+		else
+		{
+			if(prev == 0)
+			{
+				st->armed = true;
+			}
+			if(zone == 2)
+			{
+				st->qualified = true;
+			}
+		}
+		break;
+	case ADC_TRIGGER_WINDOW:
+		event = cond->polarity ? (prev == 1) : (zone == 1);
+		break;
+	case ADC_TRIGGER_SLEW_RATE:
+		// armed: transition in progress, started at the crossing of the low level
+		if(zone == 0)
+		{
+			st->armed = false;
+		}
+		else
+		{
+			if(prev == 0)
+			{
+				st->armed = true;
+				st->start = position;
+			}
+			if(zone == 2 && st->armed)
+			{
+				uint64_t duration = position - st->start;
+				event = cond->less ? duration < cond->time : duration > cond->time;
+				st->armed = false;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+	if(event)
+	{
+		st->lastEvent = position + 1;
+	}
+
+	return event;
+}
+
+/**
+ * Process the next buffer of the stream, until the first trigger.
+ * To look for the next triggers, call again with the rest of the buffer, from the sample
+ * following the trigger.
+ *
+ * @param buffer the raw buffer, as acquired from the DMA
+ * @param length the number of samples in the buffer
+ *
+ * @return the index of the trigger sample in the buffer, length if there is none
+ */
+size_t ADCTriggerEngine::process(const uint32_t *buffer, size_t length)
+{
+	bool enabled[2] = {condition[0].type != ADC_TRIGGER_NONE, condition[1].type != ADC_TRIGGER_NONE};
+	bool both = enabled[0] && enabled[1] && combine == ADC_TRIGGER_AND;
+
+	for(size_t block = 0; block < length; block += ADCTRIGGER_SCAN_BLOCK_LEN)
+	{
+		size_t end = block + ADCTRIGGER_SCAN_BLOCK_LEN < length ? block + ADCTRIGGER_SCAN_BLOCK_LEN : length;
+		int32_t min0 = INT32_MAX, max0 = INT32_MIN, min1 = INT32_MAX, max1 = INT32_MIN;
+		bool active[2];
+
+		for(size_t i = block; i < end; i++)
+		{
+			int32_t s0 = (int32_t)buffer[i] >> 18;
+			int32_t s1 = (int32_t)(buffer[i] << 16) >> 18;
+			min0 = s0 < min0 ? s0 : min0;
+			max0 = s0 > max0 ? s0 : max0;
+			min1 = s1 < min1 ? s1 : min1;
+			max1 = s1 > max1 ? s1 : max1;
+		}
+
+		// a block staying in the zone of the previous sample cannot change the state
+		for(uint8_t ch = 0; ch < 2; ch++)
+		{
+			ADCTriggerChannelState *st = &state[ch];
+			int32_t lo = st->sign > 0 ? (ch ? min1 : min0) : -(ch ? max1 : max0);
+			int32_t hi = st->sign > 0 ? (ch ? max1 : max0) : -(ch ? min1 : min0);
+			uint8_t zoneLo = (lo >= st->threshold[0]) + (lo >= st->threshold[1]);
+			uint8_t zoneHi = (hi >= st->threshold[0]) + (hi >= st->threshold[1]);
+			active[ch] = enabled[ch] && !(zoneLo == st->zone && zoneHi == st->zone);
+		}
+		if(!active[0] && !active[1])
+		{
+			continue;
+		}
+
+		for(size_t i = block; i < end; i++)
+		{
+			uint64_t pos = position + i;
+			bool event0 = active[0] && step(0, (int32_t)buffer[i] >> 18, pos);
+			bool event1 = active[1] && step(1, (int32_t)(buffer[i] << 16) >> 18, pos);
+			bool trigger;
+
+			if(!event0 && !event1)
+			{
+				continue;
+			}
+			if(both)
+			{
+				// the other channel had an event within the coincidence time, up to this sample
+				uint64_t other = event0 ? state[1].lastEvent : state[0].lastEvent;
+				trigger = (event0 && event1) || (other && pos - (other - 1) <= coincidence);
+			}
+			else
+			{
+				trigger = true;
+			}
+			if(trigger)
+			{
+				triggerPosition = pos;
+				position += i + 1;
+				return i;
+			}
+		}
+	}
+	position += length;
+
+	return length;
+}
+
+/**
+ * Get the position in the stream of the next sample to process,
+ * the number of samples processed since the last reset.
+ *
+ * @return the stream position
+ */
+uint64_t ADCTriggerEngine::getPosition()
+{
+	return position;
+}
+
+/**
+ * Get the position in the stream of the last trigger.
+ *
+ * @return the stream position of the trigger sample
+ */
+uint64_t ADCTriggerEngine::getTriggerPosition()
+{
+	return triggerPosition;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file adctrigger.h
+ * @date 16 Oct 2026
+ * @brief File containing the definitions of the software trigger detection on ZMOD ADC1410 buffers.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef _ADCTRIGGER_H
+#define  _ADCTRIGGER_H
+
+/**
+ * Interpolation used between samples.
+ */
+enum adc_interpolation {
+	ADC_INTERPOLATION_LINEAR, ///< linear, between the two samples around the position
+	ADC_INTERPOLATION_CUBIC, ///< cubic (Catmull-Rom), through the four samples around the position
+};
+
+size_t fnFindEdge(const uint32_t *buffer, size_t length, uint8_t channel, int16_t level, uint32_t edge, int16_t previous);
+double fnInterpolateTrigger(const uint32_t *buffer, size_t length, uint8_t channel, int16_t level, uint32_t edge,
+		size_t index, uint8_t interpolation);
+void fnShiftSamples(const float *in, float *out, size_t length, double shift, uint8_t interpolation);
+
+#define ADCTRIGGER_SCAN_BLOCK_LEN 64 ///< number of samples of the blocks skipped by ADCTriggerEngine when they cannot trigger
+
+/**
+ * Type of a software trigger condition.
+ */
+enum adc_trigger_type {
+	ADC_TRIGGER_NONE, ///< the channel does not take part in the trigger
+	ADC_TRIGGER_EDGE, ///< level crossing, after leaving the hysteresis band
+	ADC_TRIGGER_PULSE_WIDTH, ///< pulse above (below for negative polarity) the level, qualified by its width, at its trailing edge
+	ADC_TRIGGER_RUNT, ///< pulse crossing the low level and returning without reaching the high level, at its trailing edge
+	ADC_TRIGGER_WINDOW, ///< entering (positive polarity) or exiting (negative polarity) the [low, high] band
+	ADC_TRIGGER_SLEW_RATE, ///< transition from the low to the high level (high to low for negative polarity), qualified by its duration
+};
+
+/**
+ * Combination of the conditions of the two channels.
+ */
+enum adc_trigger_combine {
+	ADC_TRIGGER_OR, ///< any channel condition triggers
+	ADC_TRIGGER_AND, ///< both channel conditions, within the coincidence time of each other
+};
+
+/**
+ * Struct describing the software trigger condition of a channel.
+ * Levels are signed 14 bits raw values (see ZMODADC1410_VOLT_PER_LSB), times are in samples.
+ */
+typedef struct _ADCTriggerCondition {
+	uint8_t type; ///< condition type, see adc_trigger_type
+	uint8_t polarity; ///< 0 for positive (rising edge, pulse above the level), 1 for negative
+	int16_t level; ///< level of the edge and pulse width conditions
+	int16_t low; ///< low level of the runt, window and slew rate conditions
+	int16_t high; ///< high level of the runt, window and slew rate conditions
+	int16_t hysteresis; ///< distance the signal must go back from the level to arm the edge and pulse width conditions again
+	uint32_t time; ///< width of the pulse width condition, duration of the slew rate condition
+	uint8_t less; ///< 0 to trigger on a width (duration) greater than time, 1 on less than time
+} ADCTriggerCondition;
+
+/**
+ * Struct holding the state of the condition of a channel between samples.
+ */
+typedef struct _ADCTriggerChannelState {
+	int32_t sign; ///< 1 for positive polarity, -1 to process the negated signal
+	int32_t threshold[2]; ///< thresholds delimiting the zones of the (negated) signal
+	uint8_t zone; ///< zone of the last sample: number of thresholds at or below it
+	bool armed; ///< condition armed
+	bool qualified; ///< runt: the pulse reached the high level
+	uint64_t start; ///< position of the start of the pulse or transition
+	uint64_t lastEvent; ///< position of the last event of the channel, plus 1 (0 for none)
+} ADCTriggerChannelState;
+
+/**
+ * Class evaluating software trigger conditions on a stream of raw ZMOD ADC1410 buffers.
+ * Each channel condition is a state machine driven by the zone of the samples relative to its
+ * two thresholds, evaluated directly on the packed raw words. The buffers are scanned in blocks of
+ * ADCTRIGGER_SCAN_BLOCK_LEN samples, whose minimum and maximum are computed with branch-free loops
+ * the compiler vectorizes; a block whose samples all stay in the zone of the previous sample
+ * cannot change the state, and is skipped without running the state machines.
+ *
+ * The state is kept between calls to process, so a stream can be passed in any number of buffers.
+ */
+class ADCTriggerEngine {
+private:
+	ADCTriggerCondition condition[2]; ///< [channel 0:1] conditions
+	ADCTriggerChannelState state[2]; ///< [channel 0:1] condition states
+	uint8_t combine; ///< combination of the channel conditions, see adc_trigger_combine
+	uint32_t coincidence; ///< maximum distance of the channel events for the AND combination, in samples
+	uint64_t position; ///< position in the stream of the next sample
+	uint64_t triggerPosition; ///< position in the stream of the last trigger
+
+	bool step(uint8_t channel, int32_t value, uint64_t position);
+
+public:
+	ADCTriggerEngine();
+
+	void setCondition(uint8_t channel, const ADCTriggerCondition &condition);
+	void setCombine(uint8_t combine, uint32_t coincidence);
+	void reset();
+
+	size_t process(const uint32_t *buffer, size_t length);
+	uint64_t getPosition();
+	uint64_t getTriggerPosition();
+};
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file adcview.h
+ * @date 16 Oct 2026
+ * @brief File containing the lazy views over the channel data of ZMOD ADC1410 raw buffers.
+ *
+ * A view converts the raw buffer elements only when they are accessed, without allocating memory,
+ * so a single scan (for example std::max_element or std::count_if) compiles to a loop over
+ * the raw buffer. Views are combined with adaptors:
+ *
+ *     adc.channel(buffer, length, 0) | stride(4) | volts(gain)
+ */
+
+#include <stddef.h>
+#include <iterator>
+
+#include "zmodadc1410.h"
+
+#ifndef _ADCVIEW_H
+#define  _ADCVIEW_H
+
+/**
+ * Conversion of a raw buffer element to the signed raw channel data.
+ */
+struct ADCRawConv {
+	typedef int16_t value_type; ///< type of the converted data
+
+	/**
+	 * Convert a buffer element.
+	 * @param data the buffer element
+	 * @param shift 0 for channel 1, 16 for channel 2
+	 * @return the signed channel data (14 bits)
+	 */
+	int16_t operator()(uint32_t data, uint8_t shift) const {
+		return (int16_t)((int32_t)(data << shift) >> 18);
+	}
+};
+
+/**
+ * Conversion of a raw buffer element to the channel data in Volts.
+ */
+struct ADCVoltConv {
+	typedef float value_type; ///< type of the converted data
+	float scale; ///< Volts per unit of signed raw data, see ZMODADC1410_VOLT_PER_LSB
+
+	/**
+	 * Convert a buffer element.
+	 * @param data the buffer element
+	 * @param shift 0 for channel 1, 16 for channel 2
+	 * @return the channel data in Volts
+	 */
+	float operator()(uint32_t data, uint8_t shift) const {
+		return (float)((int32_t)(data << shift) >> 18) * scale;
+	}
+};
+
+/**
+ * Lazy view over the data of one channel of a ZMOD ADC1410 raw buffer.
+ * Holds only a pointer to the raw buffer, so it is cheap to copy and must not outlive the buffer.
+ */
+template<typename Conv>
+class ADCChannelView {
+public:
+	typedef typename Conv::value_type value_type; ///< type of the converted data
+
+	/**
+	 * Random access iterator over the channel data, converting on dereference.
+	 */
+	class iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category; ///< iterator category
+		typedef typename Conv::value_type value_type; ///< type of the converted data
+		typedef ptrdiff_t difference_type; ///< iterator difference type
+		typedef const value_type *pointer; ///< not used, views do not store converted data
+		typedef value_type reference; ///< dereference returns the converted data by value
+
+		iterator() : data(NULL), index(0), step(1), shift(0), conv() {}
+		iterator(const uint32_t *data, ptrdiff_t index, size_t step, uint8_t shift, Conv conv) :
+			data(data), index(index), step(step), shift(shift), conv(conv) {}
+
+		value_type operator*() const { return conv(data[index * (ptrdiff_t)step], shift); } ///< converted data
+		value_type operator[](difference_type n) const { return conv(data[(index + n) * (ptrdiff_t)step], shift); } ///< converted data at offset
+		iterator &operator++() { index++; return *this; } ///< pre-increment
+		iterator operator++(int) { iterator it = *this; index++; return it; } ///< post-increment
+		iterator &operator--() { index--; return *this; } ///< pre-decrement
+		iterator operator--(int) { iterator it = *this; index--; return it; } ///< post-decrement
+		iterator &operator+=(difference_type n) { index += n; return *this; } ///< advance
+		iterator &operator-=(difference_type n) { index -= n; return *this; } ///< advance back
+		iterator operator+(difference_type n) const { iterator it = *this; return it += n; } ///< advanced copy
+		iterator operator-(difference_type n) const { iterator it = *this; return it -= n; } ///< advanced back copy
+		difference_type operator-(const iterator &other) const { return index - other.index; } ///< distance
+		bool operator==(const iterator &other) const { return index == other.index; } ///< equality
+		bool operator!=(const iterator &other) const { return index != other.index; } ///< inequality
+		bool operator<(const iterator &other) const { return index < other.index; } ///< ordering
+		bool operator>(const iterator &other) const { return index > other.index; } ///< ordering
+		bool operator<=(const iterator &other) const { return index <= other.index; } ///< ordering
+		bool operator>=(const iterator &other) const { return index >= other.index; } ///< ordering
+
+		/**
+		 * Get the position of the iterator in the raw buffer. Must not be called on end():
+		 * with a stride, the position after the last element can be beyond the raw buffer.
+		 * @return a pointer to the raw buffer element
+		 */
+		const uint32_t *raw() const { return data + index * (ptrdiff_t)step; }
+
+	private:
+		// positions are kept as indexes, a pointer to the end of a strided view would be past the raw buffer
+		const uint32_t *data; ///< first raw buffer element of the view
+		ptrdiff_t index; ///< index of the current element in the view
+		size_t step; ///< distance between consecutive elements of the view
+		uint8_t shift; ///< 0 for channel 1, 16 for channel 2
+		Conv conv; ///< conversion of the raw buffer elements
+	};
+	typedef iterator const_iterator; ///< views are read only
+
+	/**
+	 * Create a view.
+	 * @param buffer the raw buffer
+	 * @param length the number of elements in the view
+	 * @param step the distance between consecutive elements of the view, in raw buffer elements
+	 * @param channel 0 for channel 1, 1 for channel 2
+	 * @param conv the conversion applied to the raw buffer elements
+	 */
+	ADCChannelView(const uint32_t *buffer, size_t length, size_t step, uint8_t channel, Conv conv) :
+		buffer(buffer), length(length), step(step), channel(channel ? 1 : 0), conv(conv) {}
+
+	iterator begin() const { return iterator(buffer, 0, step, channel ? 16 : 0, conv); } ///< first element
+	iterator end() const { return iterator(buffer, (ptrdiff_t)length, step, channel ? 16 : 0, conv); } ///< past the last element
+	size_t size() const { return length; } ///< number of elements
+	bool empty() const { return length == 0; } ///< whether the view has no elements
+	value_type operator[](size_t i) const { return conv(buffer[i * step], channel ? 16 : 0); } ///< converted element i
+
+	const uint32_t *getBuffer() const { return buffer; } ///< the raw buffer
+	size_t getStep() const { return step; } ///< distance between consecutive elements of the view
+	uint8_t getChannel() const { return channel; } ///< 0 for channel 1, 1 for channel 2
+	const Conv &getConv() const { return conv; } ///< the conversion applied to the raw buffer elements
+
+private:
+	const uint32_t *buffer; ///< first raw buffer element of the view
+	size_t length; ///< number of elements in the view
+	size_t step; ///< distance between consecutive elements of the view
+	uint8_t channel; ///< 0 for channel 1, 1 for channel 2
+	Conv conv; ///< conversion of the raw buffer elements
+};
+
+/**
+ * Adaptor converting a signed raw view into a Volts view. Created by volts().
+ */
+struct ADCVoltsAdaptor {
+	float scale; ///< Volts per unit of signed raw data
+};
+
+/**
+ * Adaptor keeping one element out of n. Created by stride().
+ */
+struct ADCStrideAdaptor {
+	size_t n; ///< distance between the kept elements
+};
+
+/**
+ * Create an adaptor converting a signed raw view into a Volts view,
+ * with the same results as ZMODADC1410::getVoltFromSignedRaw.
+ * @param gain 0 LOW and 1 HIGH
+ * @return the adaptor
+ */
+inline ADCVoltsAdaptor volts(uint8_t gain)
+{
+	ADCVoltsAdaptor adaptor = { ZMODADC1410_VOLT_PER_LSB(gain) };
+	return adaptor;
+}
+
+/**
+ * Create an adaptor keeping the first element out of each n elements of a view.
+ * @param n the distance between the kept elements, 0 is treated as 1
+ * @return the adaptor
+ */
+inline ADCStrideAdaptor stride(size_t n)
+{
+	ADCStrideAdaptor adaptor = { n ? n : 1 };
+	return adaptor;
+}
+
+/**
+ * Apply the Volts adaptor to a signed raw view.
+ * @param view the signed raw view
+ * @param adaptor the adaptor created by volts()
+ * @return the Volts view over the same elements
+ */
+inline ADCChannelView<ADCVoltConv> operator|(const ADCChannelView<ADCRawConv> &view, ADCVoltsAdaptor adaptor)
+{
+	ADCVoltConv conv = { adaptor.scale };
+	return ADCChannelView<ADCVoltConv>(view.getBuffer(), view.size(), view.getStep(), view.getChannel(), conv);
+}
+
+/**
+ * Apply the stride adaptor to a view.
+ * @param view the view
+ * @param adaptor the adaptor created by stride()
+ * @return the view keeping the first element out of each adaptor.n elements
+ */
+template<typename Conv>
+inline ADCChannelView<Conv> operator|(const ADCChannelView<Conv> &view, ADCStrideAdaptor adaptor)
+{
+	return ADCChannelView<Conv>(view.getBuffer(), (view.size() + adaptor.n - 1) / adaptor.n,
+			view.getStep() * adaptor.n, view.getChannel(), view.getConv());
+}
+
+/**
+ * Create a lazy view over the signed raw data of a channel of a raw buffer (see adcview.h).
+ * @param buffer the raw buffer, normally allocated using allocChannelsBuffer
+ * @param length the number of elements in the buffer
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @return the view, valid as long as the buffer
+ */
+inline ADCChannelView<ADCRawConv> ZMODADC1410::channel(const uint32_t *buffer, size_t length, uint8_t channel)
+{
+	return ADCChannelView<ADCRawConv>(buffer, length, 1, channel, ADCRawConv());
+}
+
+#endif
@@ -11,6 +11,14 @@
 #include <string.h>
 #include <unistd.h>
 #include "zmodadc1410.h"
+#include "adcsegments.h"
+#include "adclongrecord.h"
+#include "adcstream.h"
+#include "adctrigger.h"
+#include "../Zmod/timer.h"
+#include "../Zmod/perf.h"
+#include "../Zmod/regtrace.h"
+#include "../Zmod/trace.h"
 
 /**
  * Initialize a ZMOD ADC1410 instance.
@@ -72,6 +80,31 @@ uint32_t* ZMODADC1410::allocChannelsBuffer(size_t &length) {
 void ZMODADC1410::freeChannelsBuffer(uint32_t *buf, size_t length) {
 	ZMOD::freeDMABuffer(buf, length * sizeof(uint32_t));
 }
+
+/**
+* Allocates a data buffer used for AXI DMA transfers, 4 bytes for each element (sample),
+* for records spanning several acquisitions (for example a segment table or a long record).
+* Unlike allocChannelsBuffer, the length is not limited to the maximum supported buffer length.
+*
+* @param length the number of elements (samples) in the buffer
+*
+* @return the pointer to the allocated buffer, NULL on failure
+*
+*/
+uint32_t* ZMODADC1410::allocRecordBuffer(size_t length) {
+	return (uint32_t *)ZMOD::allocDMABuffer(length * sizeof(uint32_t));
+}
+
+/**
+* Free a data buffer allocated by allocRecordBuffer.
+*
+* @param buf the address of the DMA buffer
+* @param length the number of samples in the buffer.
+*
+*/
+void ZMODADC1410::freeRecordBuffer(uint32_t *buf, size_t length) {
+	ZMOD::freeDMABuffer(buf, length * sizeof(uint32_t));
+}
 /**
  * Set the trigger parameters of the data acquisition.
  *
@@ -89,12 +122,14 @@ void ZMODADC1410::freeChannelsBuffer(uint32_t *buf, size_t length) {
  */
 void ZMODADC1410::setTrigger(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window)
 {
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_SET_TRIGGER, baseAddr);
 	writeRegFld(ZMODADC1410_REGFLD_TRIG_CHANNEL, channel);
 	writeRegFld(ZMODADC1410_REGFLD_TRIG_MODE, mode);
 	writeSignedRegFld(ZMODADC1410_REGFLD_TRIG_LEVEL, level);
 	writeRegFld(ZMODADC1410_REGFLD_TRIG_EDGE, edge);
     // Set Window position
     writeRegFld(ZMODADC1410_REGFLD_WINDOW_WND, window);
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_SET_TRIGGER, baseAddr);
 }
 
 /**
@@ -141,6 +176,24 @@ int16_t ZMODADC1410::signedChannelData(uint8_t channel, uint32_t data) {
 	return toSigned(channelData(channel, data), 14);
 }
 
+/**
+ * Extract the signed channel data from all the elements of a buffer.
+ * The loop does not contain branches, so it is vectorized by the compiler.
+ *
+ * @param channel the channel to extract  0 for channel 1, 1 for channel 2
+ * @param buffer the buffer from which to extract the channel data
+ * @param data the array to receive the signed channel data (14 bits)
+ * @param length the number of elements to extract
+ */
+void ZMODADC1410::signedChannelsData(uint8_t channel, const uint32_t *buffer, int16_t *data, size_t length)
+{
+	uint8_t shift = channel ? 16 : 0;
+	for(size_t i = 0; i < length; i++)
+	{
+		data[i] = (int16_t)((int32_t)(buffer[i] << shift) >> 18);
+	}
+}
+
 /**
  * Acquire data using a polling method, will block until the acquisition
  * completes.
@@ -166,6 +219,8 @@ uint8_t ZMODADC1410::acquirePolling(uint32_t* buffer, uint8_t channel, uint8_t m
 		uint32_t edge, uint32_t window, size_t length)
 {
 	int rc;
+	ZMOD_PERF_BEGIN(perfStart);
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_ADC_ACQUIRE, baseAddr);
 
 	// Set trigger data
     setTrigger(channel, mode, level, edge, window);
@@ -185,11 +240,14 @@ uint8_t ZMODADC1410::acquirePolling(uint32_t* buffer, uint8_t channel, uint8_t m
     // Start DMA Transfer
 	rc = startDMATransfer(buffer);
 	if (rc) {
+		ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_ADC_ACQUIRE, baseAddr);
 		return ERR_FAIL;
 	}
 
     // Wait for DMA to Complete transfer
     while(!isDMATransferComplete()) {}
+    ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_ADC_ACQUIRE, baseAddr);
+    ZMOD_PERF_END(ZMOD_PERF_ADC_ACQUIRE, perfStart);
 
     return ERR_SUCCESS;
 }
@@ -197,12 +255,22 @@ uint8_t ZMODADC1410::acquirePolling(uint32_t* buffer, uint8_t channel, uint8_t m
 
 /**
  * Check if the ZMODADC1410 buffer is full by reading the Buffer Full bit in Status Register.
+ * The first time the bit is seen set after start, its time is recorded (see getTimestamps).
  *
  * @return true if the DMA transfer completed, false if it is still running
  */
 uint8_t ZMODADC1410::isBufferFull()
 {
-	return readRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL);
+	uint8_t full = readRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL);
+
+	if(full && !__atomic_load_n(&timestamps.bufferFull, __ATOMIC_RELAXED))
+	{
+		uint64_t bufferFull = fnGetTimeNs();
+		__atomic_store_n(&timestamps.bufferFull, bufferFull, __ATOMIC_RELAXED);
+		ZMOD_PERF_RECORD(ZMOD_PERF_WAIT_BUFFER_FULL, bufferFull - timestamps.arm);
+		ZMOD_TRACE2(adc_buffer_full, deviceAddr, bufferFull - timestamps.arm);
+	}
+	return full;
 }
 
 /**
@@ -240,8 +308,15 @@ void ZMODADC1410::start()
     // Clear Status Bit
     writeRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL, 1);
 
+	// before RunStop, the buffer full interrupt can come as soon as it is set
+	timestamps.arm = fnGetTimeNs();
+	__atomic_store_n(&timestamps.bufferFull, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&timestamps.dmaStart, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&timestamps.dmaComplete, 0, __ATOMIC_RELAXED);
+
     // Set RunStop Bit
 	writeRegFld(ZMODADC1410_REGFLD_CR_RUNSTOP, 1);
+	ZMOD_TRACE1(adc_start, deviceAddr);
 }
 
 /**
@@ -251,6 +326,7 @@ void ZMODADC1410::start()
 void ZMODADC1410::stop()
 {
 	writeRegFld(ZMODADC1410_REGFLD_CR_RUNSTOP, 0);
+	ZMOD_TRACE1(adc_stop, deviceAddr);
 }
 /**
  * Acquire data using a polling method, will block until the acquisition
@@ -293,6 +369,281 @@ uint8_t ZMODADC1410::acquireImmediatePolling(uint32_t* buffer, size_t &length)
 	return acquirePolling(buffer, 0, 1, 0, 0, 0, length);
 }
 
+/**
+ * Acquire the next triggers into the consecutive segments of a segment table, using
+ * a polling method, will block until all the segments are acquired or a trigger does not
+ * come in time. The trigger and transfer length are configured once for all the segments;
+ * between segments only the ADC is armed again, as soon as the previous segment is
+ * transferred, and the DMA target moves to the next segment.
+ *
+ * For each segment, the table records the time the buffer full was detected and the rearm
+ * latency (the time from the previous buffer full to arming the ADC again, during which
+ * triggers are lost). The hardware does not count triggers, so the missed triggers are
+ * estimated from the time between consecutive segments, when the trigger period is known.
+ *
+ * @param table the segment table receiving the data, its segment length is the acquisition length
+ * @param channel the channel for which trigger is set: 0 for channel 1,
+ *  1 for channel 2
+ * @param level the level on which to run the data acquisition,
+ *  can be any valid 14bit unsigned number
+ * @param edge the trigger edge at which to run the data acquisition,
+ *  0 for rising edge, 1 for falling edge
+ * @param window the window position at which to run the data acquisition,
+ *  can be any unsigned number smaller than length
+ * @param timeoutNs the maximum time to wait for each trigger, in nanoseconds,
+ *  0 to wait forever
+ * @param expectedPeriodNs the expected period of the triggers, in nanoseconds,
+ *  used to estimate the missed triggers, 0 if unknown
+ *
+ * @return 0 on success, any other number on failure; a trigger timeout is not a failure,
+ *  the number of acquired segments is given by table.getAcquiredCount()
+ */
+uint8_t ZMODADC1410::acquireSegmentedPolling(ADCSegmentTable &table, uint8_t channel, uint32_t level,
+		uint32_t edge, uint32_t window, uint64_t timeoutNs, uint64_t expectedPeriodNs)
+{
+	size_t length = table.length;
+	uint64_t armTime, fullTime, prevFullTime = 0;
+
+	table.reset();
+	if(!table.buffer)
+	{
+		return ERR_FAIL;
+	}
+
+	// Set trigger data and DMA RX transfer length, once for all segments
+	setTrigger(channel, 0, level, edge, window);
+	setTransferLength(length);
+	enableBufferFullInterrupt(0);
+
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		table.info.gain[ch] = getGain(ch);
+		table.info.coupling[ch] = getCoupling(ch);
+	}
+	table.info.trigChannel = channel;
+	table.info.trigMode = 0;
+	table.info.trigLevel = (int16_t)level;
+	table.info.trigEdge = edge;
+	table.info.window = window;
+	table.info.length = length;
+
+	for(uint32_t k = 0; k < table.segments; k++)
+	{
+		SegmentInfo *segment = &table.segmentInfo[k];
+
+		// RunStop bit = 1, rearm
+		start();
+		armTime = timestamps.arm;
+
+		// waits until buffer full bit is set by the ZMODADC1410 IP, or timeout
+		while(!isBufferFull())
+		{
+			if(timeoutNs && fnGetTimeNs() - armTime > timeoutNs)
+			{
+				// RunStop bit = 0, not left armed for the next acquisition
+				stop();
+				table.timeouts++;
+				countTimeout();
+				return ERR_SUCCESS;
+			}
+		}
+		fullTime = __atomic_load_n(&timestamps.bufferFull, __ATOMIC_RELAXED);
+		writeRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL, 1);
+
+		// Start DMA Transfer into the segment
+		if(startDMATransfer(table.buffer + k * length))
+		{
+			return ERR_FAIL;
+		}
+		while(!isDMATransferComplete()) {}
+
+		segment->index = k;
+		segment->timestamp = fullTime;
+		segment->times = getTimestamps();
+		segment->rearmLatencyNs = k ? armTime - prevFullTime : 0;
+		segment->triggerTime = fnInterpolateTrigger(table.buffer + k * length, length, channel, (int16_t)level,
+				edge, window, ADC_INTERPOLATION_CUBIC);
+		segment->missedTriggers = 0;
+		if(k && expectedPeriodNs)
+		{
+			// number of periods between the two segments, rounded, minus the captured one
+			uint64_t periods = (fullTime - prevFullTime + expectedPeriodNs / 2) / expectedPeriodNs;
+			segment->missedTriggers = periods > 1 ? (uint32_t)(periods - 1) : 0;
+		}
+		table.missedTriggers += segment->missedTriggers;
+		fnMetricsAdd(&metrics.missedTriggers, segment->missedTriggers);
+		if(segment->rearmLatencyNs > table.maxRearmLatencyNs)
+		{
+			table.maxRearmLatencyNs = segment->rearmLatencyNs;
+		}
+		table.acquired = k + 1;
+		prevFullTime = fullTime;
+	}
+	table.info.times = getTimestamps();
+	table.info.timestamp = fnGetTimeNs();
+
+	return ERR_SUCCESS;
+}
+
+/**
+ * Acquire a record longer than the maximum buffer length supported by the IP, using
+ * a polling method, will block until the whole record is acquired. The record is
+ * acquired as consecutive immediate acquisitions (windows) of the record window length,
+ * each one transferred by DMA right after the previous one in the record buffer.
+ *
+ * The ADC does not acquire between the buffer full of a window and the arming of
+ * the next one, so the record is not continuous at the window boundaries. For each
+ * boundary, the record gets a gap with the index of the first sample following it, and the
+ * time not acquired, estimated from the arming times of the two windows and the duration
+ * of the first one.
+ *
+ * @param record the long record receiving the data
+ *
+ * @return 0 on success, any other number on failure
+ */
+uint8_t ZMODADC1410::acquireLongRecordPolling(ADCLongRecord &record)
+{
+	uint64_t armTime, prevArmTime = 0, prevDurationNs = 0;
+	size_t offset = 0;
+
+	record.reset();
+	if(!record.isValid())
+	{
+		return ERR_FAIL;
+	}
+
+	// Set immediate trigger, the transfer length is set for each window
+	setTrigger(0, 1, 0, 0, 0);
+	enableBufferFullInterrupt(0);
+
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		record.info.gain[ch] = getGain(ch);
+		record.info.coupling[ch] = getCoupling(ch);
+	}
+	record.info.trigMode = 1;
+	record.info.length = record.length;
+
+	for(uint32_t k = 0; k < record.windows; k++)
+	{
+		size_t length = record.length - offset;
+		if(length > record.windowLength)
+		{
+			length = record.windowLength;
+		}
+		if(k == 0 || length != record.windowLength)
+		{
+			setTransferLength(length);
+		}
+
+		// RunStop bit = 1
+		start();
+		armTime = timestamps.arm;
+
+		if(k)
+		{
+			// time between the end of the previous window and the start of this one
+			RecordGap *gap = &record.gaps[k - 1];
+			uint64_t elapsed = armTime - prevArmTime;
+			gap->index = offset;
+			gap->gapNs = elapsed > prevDurationNs ? elapsed - prevDurationNs : 0;
+			gap->gapSamples = gap->gapNs / ZMODADC1410_SAMPLE_PERIOD_NS;
+			if(k == 1 || gap->gapNs < record.minGapNs)
+			{
+				record.minGapNs = gap->gapNs;
+			}
+			if(gap->gapNs > record.maxGapNs)
+			{
+				record.maxGapNs = gap->gapNs;
+			}
+			record.totalGapNs += gap->gapNs;
+			record.gapCount = k;
+		}
+
+		// waits until buffer full bit is set by the ZMODADC1410 IP
+		while(!isBufferFull()) {}
+		writeRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL, 1);
+
+		// Start DMA Transfer into the record
+		if(startDMATransfer(record.buffer + offset))
+		{
+			return ERR_FAIL;
+		}
+		while(!isDMATransferComplete()) {}
+
+		prevArmTime = armTime;
+		prevDurationNs = (uint64_t)length * ZMODADC1410_SAMPLE_PERIOD_NS;
+		offset += length;
+	}
+	record.info.times = getTimestamps();
+	record.info.timestamp = fnGetTimeNs();
+
+	return ERR_SUCCESS;
+}
+
+/**
+ * Acquire one buffer of a stream using a polling method, will block until the acquisition
+ * completes. A buffer is taken from the free buffers of the stream and, as soon as its DMA
+ * transfer completes, queued without copy to the consumers of the stream (see ADCStream),
+ * without locks.
+ * The trigger settings and the length are the ones set with ADCStream::setTrigger and
+ * ADCStream::setAcquisitionLength. The trigger crossing is not interpolated (triggerTime
+ * is 0), to keep the acquisition thread short.
+ *
+ * @param stream the stream receiving the data
+ *
+ * @return 0 on success, any other number on failure, including no free buffer (overrun)
+ */
+uint8_t ZMODADC1410::acquireStreamPolling(ADCStream &stream)
+{
+	ADCStreamBuffer *streamBuffer;
+	AcquisitionInfo *info;
+	size_t length = stream.info.length;
+
+	streamBuffer = stream.takeFreeBuffer();
+	if(!streamBuffer)
+	{
+		__atomic_fetch_add(&stream.overruns, 1, __ATOMIC_RELAXED);
+		stream.sequence++;
+		return ERR_FAIL;
+	}
+	info = &streamBuffer->info;
+	*info = stream.info;
+
+	setTrigger(info->trigChannel, info->trigMode, info->trigLevel, info->trigEdge, info->window);
+	setTransferLength(length);
+	enableBufferFullInterrupt(0);
+
+	// RunStop bit = 1
+	start();
+
+	// read the settings while the buffer fills
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		info->gain[ch] = getGain(ch);
+		info->coupling[ch] = getCoupling(ch);
+	}
+
+	waitForBufferFullPolling();
+
+	if(startDMATransfer(streamBuffer->buffer))
+	{
+		// give the buffer back, the stream stays usable
+		stream.freeBuffers[stream.freeCount++] = streamBuffer;
+		stream.sequence++;
+		return ERR_FAIL;
+	}
+	while(!isDMATransferComplete()) {}
+
+	// publish the buffer
+	info->times = getTimestamps();
+	info->timestamp = info->times.dmaComplete;
+	streamBuffer->sequence = stream.sequence++;
+	stream.publish(streamBuffer);
+
+	return ERR_SUCCESS;
+}
+
 #ifndef LINUX_APP
 /**
  * (Baremetal only)
@@ -397,6 +748,11 @@ void ZMODADC1410::processInterrupt()
 {
 	if (readRegFld(ZMODADC1410_REGFLD_SR_BUF_FULL) == 1 &&
 			readRegFld(ZMODADC1410_REGFLD_IER_BUF_FULL) == 1) {
+		uint64_t bufferFull = fnGetTimeNs();
+		__atomic_store_n(&timestamps.bufferFull, bufferFull, __ATOMIC_RELAXED);
+		ZMOD_PERF_RECORD(ZMOD_PERF_WAIT_BUFFER_FULL, bufferFull - timestamps.arm);
+		ZMOD_TRACE2(adc_buffer_full, deviceAddr, bufferFull - timestamps.arm);
+
 	    // Start DMA Transfer
 		startDMATransfer(interruptBuffer);
 
@@ -422,6 +778,7 @@ int ZMODADC1410::readUserCalib()
 	{
 		return ERR_FAIL;
 	}
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_READ_USER_CALIB, baseAddr);
 	// read the user calibration data as an array of bytes, into the area pointed by calib base class member
 	status = ZMOD::readUserCalib();
 	if (status == ERR_SUCCESS)
@@ -442,6 +799,7 @@ int ZMODADC1410::readUserCalib()
 		writeRegFld(ZMODADC1410_REGFLD_SC2LGADDCOEF_VAL,   computeCoefAdd(pCalib->cal[1][0][1], 0));
 
 	}
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_READ_USER_CALIB, baseAddr);
 
 	return ERR_SUCCESS;
 }
@@ -535,6 +893,7 @@ uint8_t ZMODADC1410::autoTestRamp(uint8_t channel, uint32_t level, uint32_t edge
 */
 void ZMODADC1410::setGain(uint8_t channel, uint8_t gain)
 {
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_SET_GAIN, baseAddr);
 	if(channel)
 	{
 		writeRegFld(ZMODADC1410_REGFLD_TRIG_SC2_HG_LG, gain);
@@ -543,6 +902,8 @@ void ZMODADC1410::setGain(uint8_t channel, uint8_t gain)
 	{
 		writeRegFld(ZMODADC1410_REGFLD_TRIG_SC1_HG_LG, gain);
 	}
+	fnMetricsSet(&metrics.gain[channel ? 1 : 0], gain);
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_SET_GAIN, baseAddr);
 }
 
 /**
@@ -552,6 +913,7 @@ void ZMODADC1410::setGain(uint8_t channel, uint8_t gain)
  */
 void ZMODADC1410::setCoupling(uint8_t channel, uint8_t coupling)
 {
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_SET_COUPLING, baseAddr);
 	if(channel)
 	{
 		writeRegFld(ZMODADC1410_REGFLD_TRIG_SC2_AC_DC, coupling);
@@ -560,6 +922,36 @@ void ZMODADC1410::setCoupling(uint8_t channel, uint8_t coupling)
 	{
 		writeRegFld(ZMODADC1410_REGFLD_TRIG_SC1_AC_DC, coupling);
 	}
+	fnMetricsSet(&metrics.coupling[channel ? 1 : 0], coupling);
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_SET_COUPLING, baseAddr);
+}
+
+/**
+ * Get the gain of a channel, as previously set by setGain.
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @return the gain : 0 for LOW gain, 1 for HIGH gain
+ */
+uint8_t ZMODADC1410::getGain(uint8_t channel)
+{
+	if(channel)
+	{
+		return readRegFld(ZMODADC1410_REGFLD_TRIG_SC2_HG_LG);
+	}
+	return readRegFld(ZMODADC1410_REGFLD_TRIG_SC1_HG_LG);
+}
+
+/**
+ * Get the coupling of a channel, as previously set by setCoupling.
+ * @param channel 0 for channel 1, 1 for channel 2
+ * @return the coupling : 0 for DC Coupling, 1 for AC Coupling
+ */
+uint8_t ZMODADC1410::getCoupling(uint8_t channel)
+{
+	if(channel)
+	{
+		return readRegFld(ZMODADC1410_REGFLD_TRIG_SC2_AC_DC);
+	}
+	return readRegFld(ZMODADC1410_REGFLD_TRIG_SC1_AC_DC);
 }
 
 /**
@@ -582,11 +974,6 @@ void ZMODADC1410::setCalibValues(uint8_t channel, uint8_t gain, float valG, floa
 	}
 }
 
-#define IDEAL_RANGE_ADC_HIGH 1.0 ///< Ideal range ADC LOW
-#define IDEAL_RANGE_ADC_LOW 25.0 ///< Ideal range ADC HIGH
-#define REAL_RANGE_ADC_HIGH 1.086 ///< Real range ADC HIGH
-#define REAL_RANGE_ADC_LOW 26.25 ///< Real range ADC LOW
-
 /**
  * Computes the Multiplicative calibration coefficient.
  * @param cg gain coefficient as it is stored in Flash
@@ -595,7 +982,7 @@ void ZMODADC1410::setCalibValues(uint8_t channel, uint8_t gain, float valG, floa
  */
 int32_t ZMODADC1410::computeCoefMult(float cg, uint8_t gain)
 {
-	float fval = (gain ? (REAL_RANGE_ADC_HIGH/IDEAL_RANGE_ADC_HIGH):(REAL_RANGE_ADC_LOW/IDEAL_RANGE_ADC_LOW))*(1 + cg)*(float)(1<<16);
+	float fval = (gain ? (ZMODADC1410_REAL_RANGE_HIGH/ZMODADC1410_IDEAL_RANGE_HIGH):(ZMODADC1410_REAL_RANGE_LOW/ZMODADC1410_IDEAL_RANGE_LOW))*(1 + cg)*(float)(1<<16);
 	int32_t ival = (int32_t) (fval + 0.5);	// round
 	ival &= (1<<18) - 1; // keep only 18 bits
 	return ival;
@@ -609,7 +996,7 @@ int32_t ZMODADC1410::computeCoefMult(float cg, uint8_t gain)
  */
 int32_t ZMODADC1410::computeCoefAdd(float ca, uint8_t gain)
 {
-	float fval = ca / (gain ? IDEAL_RANGE_ADC_HIGH:IDEAL_RANGE_ADC_LOW)*(float)(1<<17);
+	float fval = ca / (gain ? ZMODADC1410_IDEAL_RANGE_HIGH:ZMODADC1410_IDEAL_RANGE_LOW)*(float)(1<<17);
 	int32_t ival = (int32_t) (fval + 0.5);	// round
 	ival &= (1<<18) - 1; // keep only 18 bits
 	return ival;
@@ -623,9 +1010,24 @@ int32_t ZMODADC1410::computeCoefAdd(float ca, uint8_t gain)
  */
 float ZMODADC1410::getVoltFromSignedRaw(int32_t raw, uint8_t gain)
 {
-	float vMax = gain ? IDEAL_RANGE_ADC_HIGH:IDEAL_RANGE_ADC_LOW;
+	float vMax = gain ? ZMODADC1410_IDEAL_RANGE_HIGH:ZMODADC1410_IDEAL_RANGE_LOW;
 	float fval = (float)raw * vMax / (float)(1<<13);
 	return fval;
 }
 
-
+/**
+ * Converts an array of signed raw values (provided by ZmodADC1410 IP core) to values in Volts measure unit.
+ * Gives the same results as getVoltFromSignedRaw, in a loop vectorized by the compiler.
+ * @param raw the array of signed raw values
+ * @param voltValues the array to receive the values in Volts
+ * @param length the number of values to convert
+ * @param gain 0 LOW and 1 HIGH
+ */
+void ZMODADC1410::getVoltsFromSignedRaw(const int16_t *raw, float *voltValues, size_t length, uint8_t gain)
+{
+	float scale = ZMODADC1410_VOLT_PER_LSB(gain);
+	for(size_t i = 0; i < length; i++)
+	{
+		voltValues[i] = (float)raw[i] * scale;
+	}
+}
@@ -12,6 +12,8 @@
 #define  _ZMODADC1410_H
 
 #define ZMODADC1410_MAX_BUFFER_LEN	0x3FFF	// maximum buffer length supported by ZmodADC1410 IP
+#define ZMODADC1410_SAMPLE_RATE		100000000	// sampling rate of the ZmodADC1410, in samples per second
+#define ZMODADC1410_SAMPLE_PERIOD_NS	(1000000000 / ZMODADC1410_SAMPLE_RATE)	// sampling period of the ZmodADC1410, in nanoseconds
 
 
 /**
@@ -63,6 +65,28 @@
 #define ZMODADC1410_CALIB_FACT_ADDR 0x8100 ///< Address in flash for factory calibration area
 #define ZMODADC1410_CALIB_ID	0xAD ///< Calibration ID
 
+/**
+ * ZMODADC1410 ranges
+ */
+#define ZMODADC1410_IDEAL_RANGE_HIGH 1.0 ///< Ideal range ADC LOW
+#define ZMODADC1410_IDEAL_RANGE_LOW 25.0 ///< Ideal range ADC HIGH
+#define ZMODADC1410_REAL_RANGE_HIGH 1.086 ///< Real range ADC HIGH
+#define ZMODADC1410_REAL_RANGE_LOW 26.25 ///< Real range ADC LOW
+
+/**
+ * Volts corresponding to one unit of signed raw data, for the gain 0 LOW and 1 HIGH.
+ * Multiplying by it gives the same result as getVoltFromSignedRaw.
+ */
+#define ZMODADC1410_VOLT_PER_LSB(gain)	((float)((gain) ? ZMODADC1410_IDEAL_RANGE_HIGH : ZMODADC1410_IDEAL_RANGE_LOW) / (float)(1<<13))
+
+/**
+ * Extract the signed channel data (14 bits) from a buffer element, without branches,
+ * so that it can be used in loops vectorized by the compiler.
+ * Gives the same result as signedChannelData: 0 for channel 1, 1 for channel 2.
+ */
+#define ZMODADC1410_SIGNED_CHANNEL_DATA(channel, data) \
+	((int16_t)((int32_t)((uint32_t)(data) << ((channel) ? 16 : 0)) >> 18))
+
 /**
  * Struct that maps the calibration data stored in the ZMODDAC1411 flash.
  * 128 bytes in size.
@@ -76,6 +100,12 @@ typedef struct _CALIBECLYPSEADC {
     unsigned char   crc; ///< to generate: init 0 and -= 127 bytes; the checksum of the structure should be 0
 } __attribute__((__packed__)) CALIBECLYPSEADC;
 
+struct ADCRawConv;
+template<typename Conv> class ADCChannelView;
+class ADCSegmentTable;
+class ADCLongRecord;
+class ADCStream;
+
 /**
  * Class containing functionality for ZMODADC1410.
  */
@@ -94,8 +124,12 @@ public:
 	ZMODADC1410(uintptr_t baseAddress, uintptr_t dmaAddress, uintptr_t iicAddress, uintptr_t flashAddress, int zmodInterrupt, int dmaInterrupt);
 	uint32_t* allocChannelsBuffer(size_t &length);
 	void freeChannelsBuffer(uint32_t *buf, size_t length);
+	uint32_t* allocRecordBuffer(size_t length);
+	void freeRecordBuffer(uint32_t *buf, size_t length);
 	uint16_t channelData(uint8_t channel, uint32_t data);
 	int16_t signedChannelData(uint8_t channel, uint32_t data);
+	void signedChannelsData(uint8_t channel, const uint32_t *buffer, int16_t *data, size_t length);
+	ADCChannelView<ADCRawConv> channel(const uint32_t *buffer, size_t length, uint8_t channel);
 
 	void setTransferLength(size_t &length);
 	void setTrigger(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window);
@@ -108,6 +142,10 @@ public:
 
 	uint8_t acquireTriggeredPolling(uint32_t* buffer, uint8_t channel, uint32_t level, uint32_t edge, uint32_t window, size_t length);
 	uint8_t acquireImmediatePolling(uint32_t* buffer, size_t &length);
+	uint8_t acquireSegmentedPolling(ADCSegmentTable &table, uint8_t channel, uint32_t level, uint32_t edge, uint32_t window,
+			uint64_t timeoutNs, uint64_t expectedPeriodNs);
+	uint8_t acquireLongRecordPolling(ADCLongRecord &record);
+	uint8_t acquireStreamPolling(ADCStream &stream);
 #ifndef LINUX_APP
 	uint8_t acquireTriggeredInterrupt(uint32_t* buffer, uint8_t channel, uint32_t level, uint32_t edge, uint32_t window, size_t length);
 	uint8_t acquireImmediateInterrupt(uint32_t* buffer, uint8_t channel, size_t length);
@@ -119,6 +157,8 @@ public:
 
 	void setGain(uint8_t channel, uint8_t gain);
 	void setCoupling(uint8_t channel, uint8_t coupling);
+	uint8_t getGain(uint8_t channel);
+	uint8_t getCoupling(uint8_t channel);
 	int32_t computeCoefMult(float cg, uint8_t gain);
 	int32_t computeCoefAdd(float ca, uint8_t gain);
 
@@ -126,6 +166,10 @@ public:
 	void setCalibValues(uint8_t channel, uint8_t gain, float valG, float valA);
 
 	float getVoltFromSignedRaw(int32_t raw, uint8_t gain);
+	void getVoltsFromSignedRaw(const int16_t *raw, float *voltValues, size_t length, uint8_t gain);
 };
 
+// the views returned by channel(), after the class they need
+#include "adcview.h"
+
 #endif
@@ -9,8 +9,20 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "zmoddac1411.h"
+#include "../Zmod/timer.h"
+#include "../Zmod/perf.h"
+#include "../Zmod/regtrace.h"
+#include "../Zmod/trace.h"
+
+/**
+ * Position the signed channel data of both channels in a 32 bits value to be sent to IP.
+ * Equivalent to OR-ing the results of arrangeSignedChannelData for the two channels.
+ */
+#define ARRANGE_SIGNED_CHANNELS(data1, data2) \
+	((((uint32_t)(data1) & 0x3FFF) << 18) | (((uint32_t)(data2) & 0x3FFF) << 2))
 
 /**
  * Initialize a ZMOD DAC1411 instance.
@@ -100,6 +112,46 @@ uint32_t ZMODDAC1411::arrangeSignedChannelData(uint8_t channel, int16_t data)
 	return arrangeChannelData(channel, (uint32_t)data);
 }
 
+/**
+ * Fill a buffer with the 32 bits values to be sent to IP, from the signed data of both channels.
+ * The loops do not contain branches, so they are vectorized by the compiler.
+ *
+ * @param buffer the buffer to be filled, normally allocated using allocChannelsBuffer
+ * @param data1 the signed data (14 bits) for channel 1, or NULL to output 0 on channel 1
+ * @param data2 the signed data (14 bits) for channel 2, or NULL to output 0 on channel 2
+ * @param length the number of values to be filled
+ *
+ */
+void ZMODDAC1411::arrangeSignedChannelsData(uint32_t *buffer, const int16_t *data1, const int16_t *data2, size_t length)
+{
+	size_t i;
+	if(data1 && data2)
+	{
+		for(i = 0; i < length; i++)
+		{
+			buffer[i] = ARRANGE_SIGNED_CHANNELS(data1[i], data2[i]);
+		}
+	}
+	else if(data1)
+	{
+		for(i = 0; i < length; i++)
+		{
+			buffer[i] = ARRANGE_SIGNED_CHANNELS(data1[i], 0);
+		}
+	}
+	else if(data2)
+	{
+		for(i = 0; i < length; i++)
+		{
+			buffer[i] = ARRANGE_SIGNED_CHANNELS(0, data2[i]);
+		}
+	}
+	else
+	{
+		memset(buffer, 0, length * sizeof(uint32_t));
+	}
+}
+
 /**
  * Reset the output counter so that the next time the instrument is started the first value from the buffer will be sent to DAC.
  *
@@ -125,6 +177,8 @@ void ZMODDAC1411::resetOutputCounter()
 uint8_t ZMODDAC1411::setData(uint32_t* buffer, size_t &length)
 {
 	uint8_t Status;
+	ZMOD_PERF_BEGIN(perfStart);
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_DAC_SET_DATA, baseAddr);
 	if(length > ZmodDAC1411_MAX_BUFFER_LEN)
 	{
 		length = ZmodDAC1411_MAX_BUFFER_LEN;
@@ -136,10 +190,13 @@ uint8_t ZMODDAC1411::setData(uint32_t* buffer, size_t &length)
 	// Start DMA Transfer
 	Status = startDMATransfer(buffer);
 	if (Status) {
+		ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_DAC_SET_DATA, baseAddr);
 		return ERR_FAIL;
 	}
 	// Wait for DMA to Complete transfer
 	while(!isDMATransferComplete()) {}
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_DAC_SET_DATA, baseAddr);
+	ZMOD_PERF_END(ZMOD_PERF_DAC_SET_DATA, perfStart);
 	return Status;
 }
 
@@ -151,6 +208,8 @@ uint8_t ZMODDAC1411::setData(uint32_t* buffer, size_t &length)
 void ZMODDAC1411::start()
 {
 	writeRegFld(ZMODDAC1411_REGFLD_CR_DAC_EN, 1);
+	timestamps.arm = fnGetTimeNs();
+	ZMOD_TRACE1(dac_start, deviceAddr);
 }
 
 /**
@@ -160,6 +219,7 @@ void ZMODDAC1411::start()
 void ZMODDAC1411::stop()
 {
 	writeRegFld(ZMODDAC1411_REGFLD_CR_DAC_EN, 0);
+	ZMOD_TRACE1(dac_stop, deviceAddr);
 }
 
 /**
@@ -191,6 +251,7 @@ int ZMODDAC1411::readUserCalib()
 	int status;
 	CALIBECLYPSEDAC *pCalib;
 
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_READ_USER_CALIB, baseAddr);
 	// read the user calibration data as an array of bytes, into the area pointed by calib base class member
 	status = ZMOD::readUserCalib();
 	if(status == ERR_SUCCESS)
@@ -210,6 +271,7 @@ int ZMODDAC1411::readUserCalib()
 		writeRegFld(ZMODDAC1411_REGFLD_SC2LGMULTCOEF_VAL, computeCoefMult(pCalib->cal[1][0][0], 0));
 		writeRegFld(ZMODDAC1411_REGFLD_SC2LGADDCOEF_VAL,   computeCoefAdd(pCalib->cal[1][0][0], pCalib->cal[1][0][1], 0));
 	}
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_READ_USER_CALIB, baseAddr);
 
 	return ERR_SUCCESS;
 }
@@ -221,6 +283,7 @@ int ZMODDAC1411::readUserCalib()
 */
 void ZMODDAC1411::setGain(uint8_t channel, uint8_t gain)
 {
+	ZMOD_REGTRACE_BEGIN(ZMOD_REGTRACE_API_SET_GAIN, baseAddr);
 	if(channel)
 	{
 		writeRegFld(ZMODDAC1411_REGFLD_TRIG_SC2_HG_LG, gain);
@@ -229,6 +292,8 @@ void ZMODDAC1411::setGain(uint8_t channel, uint8_t gain)
 	{
 		writeRegFld(ZMODDAC1411_REGFLD_TRIG_SC1_HG_LG, gain);
 	}
+	fnMetricsSet(&metrics.gain[channel ? 1 : 0], gain);
+	ZMOD_REGTRACE_END(ZMOD_REGTRACE_API_SET_GAIN, baseAddr);
 }
 
 /**
@@ -314,3 +379,84 @@ int32_t ZMODDAC1411::getSignedRawFromVolt(float voltValue, uint8_t gain)
 	}
 	return raw;
 }
+
+
+/**
+ * Converts a value in Volts into a signed raw value, limiting it to the range of the raw values.
+ * It does not contain branches, so that loops calling it are vectorized by the compiler.
+ * @param voltValue the value in Volts
+ * @param scale the number of raw units in one Volt, (1<<13)/vMax
+ * @return the signed RAW value.
+ */
+static inline int32_t clampedRawFromVolt(float voltValue, float scale)
+{
+	float fval = voltValue * scale;
+	fval = (fval > (float)((1<<13) - 1)) ? (float)((1<<13) - 1) : fval;
+	fval = (fval < (float)(-(1<<13))) ? (float)(-(1<<13)) : fval;
+	return (int32_t)fval;
+}
+
+/**
+ * Converts an array of values in Volts measure unit into signed raw values (to be provided to the ZmodDAC1411 IP core).
+ * Values outside the range corresponding to the specified gain are limited to the nearest range limit,
+ * as in getSignedRawFromVolt. The scaling uses a multiplication by the precomputed reciprocal of the range,
+ * so values lying exactly on a raw unit boundary may differ by 1 LSB from getSignedRawFromVolt.
+ * @param raw the array to receive the signed raw values
+ * @param voltValues the array of values in Volts
+ * @param length the number of values to convert
+ * @param gain 0 LOW and 1 HIGH
+ */
+void ZMODDAC1411::getSignedRawFromVolts(int16_t *raw, const float *voltValues, size_t length, uint8_t gain)
+{
+	float scale = (float)(1<<13) / (gain ? IDEAL_RANGE_DAC_HIGH:IDEAL_RANGE_DAC_LOW);
+	for(size_t i = 0; i < length; i++)
+	{
+		raw[i] = (int16_t)clampedRawFromVolt(voltValues[i], scale);
+	}
+}
+
+/**
+ * Fill a buffer with the 32 bits values to be sent to IP, from values in Volts for both channels.
+ * The conversion is performed as in getSignedRawFromVolts and the result is positioned as in
+ * arrangeSignedChannelData, in a single pass over the data.
+ *
+ * @param buffer the buffer to be filled, normally allocated using allocChannelsBuffer
+ * @param volt1 the values in Volts for channel 1, or NULL to output 0 on channel 1
+ * @param gain1 the gain of channel 1: 0 LOW and 1 HIGH
+ * @param volt2 the values in Volts for channel 2, or NULL to output 0 on channel 2
+ * @param gain2 the gain of channel 2: 0 LOW and 1 HIGH
+ * @param length the number of values to be filled
+ */
+void ZMODDAC1411::arrangeChannelsDataFromVolt(uint32_t *buffer, const float *volt1, uint8_t gain1,
+		const float *volt2, uint8_t gain2, size_t length)
+{
+	float scale1 = (float)(1<<13) / (gain1 ? IDEAL_RANGE_DAC_HIGH:IDEAL_RANGE_DAC_LOW);
+	float scale2 = (float)(1<<13) / (gain2 ? IDEAL_RANGE_DAC_HIGH:IDEAL_RANGE_DAC_LOW);
+	size_t i;
+	if(volt1 && volt2)
+	{
+		for(i = 0; i < length; i++)
+		{
+			buffer[i] = ARRANGE_SIGNED_CHANNELS(clampedRawFromVolt(volt1[i], scale1),
+					clampedRawFromVolt(volt2[i], scale2));
+		}
+	}
+	else if(volt1)
+	{
+		for(i = 0; i < length; i++)
+		{
+			buffer[i] = ARRANGE_SIGNED_CHANNELS(clampedRawFromVolt(volt1[i], scale1), 0);
+		}
+	}
+	else if(volt2)
+	{
+		for(i = 0; i < length; i++)
+		{
+			buffer[i] = ARRANGE_SIGNED_CHANNELS(0, clampedRawFromVolt(volt2[i], scale2));
+		}
+	}
+	else
+	{
+		memset(buffer, 0, length * sizeof(uint32_t));
+	}
+}
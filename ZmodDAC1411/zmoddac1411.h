@@ -81,6 +81,9 @@ public:
 	void freeChannelsBuffer(uint32_t *buf, size_t length);
 	uint32_t arrangeChannelData(uint8_t channel, uint16_t data);
 	uint32_t arrangeSignedChannelData(uint8_t channel, int16_t data);
+	void arrangeSignedChannelsData(uint32_t *buffer, const int16_t *data1, const int16_t *data2, size_t length);
+	void arrangeChannelsDataFromVolt(uint32_t *buffer, const float *volt1, uint8_t gain1,
+			const float *volt2, uint8_t gain2, size_t length);
 
 	void setOutputSampleFrequencyDivider(uint16_t val);
 	uint8_t setData(uint32_t* buffer, size_t &length);
@@ -98,6 +101,7 @@ public:
 	void setCalibValues(uint8_t channel, uint8_t gain, float valG, float valA);
 
 	int32_t getSignedRawFromVolt(float voltValue, uint8_t gain);
+	void getSignedRawFromVolts(int16_t *raw, const float *voltValues, size_t length, uint8_t gain);
 };
 
 #endif
@@ -0,0 +1,678 @@
+/**
+ * @file acqbench.cpp
+ * @date 16 Oct 2026
+ * @brief End-to-end acquisition throughput and latency benchmark of the Zmod library.
+ *
+ * The benchmark drives ZMODADC1410 and ZMODDAC1411 through their public methods, exactly as
+ * applications do, for each acquisition mode and buffer length, and reports as one JSON
+ * document on the standard output:
+ *  - the sustained acquisitions per second and the DMA throughput, in MB/s
+ *  - the CPU utilization of the process (polling keeps it close to 1)
+ *  - the distributions (min, mean, p50, p90, p99, p99.9, max) of the arm to buffer full
+ *    latency, of the buffer full to DMA complete latency and of the dead time, the time
+ *    between a buffer full and the next arm, during which the ADC does not acquire
+ *  - for the DAC, the distributions of the DMA transfer time and of the dead time, the time
+ *    the output is stopped to load new data
+ *  - the worst-case jitter of the loop period, and the heap calls, page faults and context
+ *    switches of the steady state (see Zmod/rt.h), which should all be 0 with --rt
+ *
+ * The modes are "immediate" (acquireImmediatePolling), "triggered" (acquireTriggeredPolling,
+ * which needs a signal crossing the trigger level on real hardware) and "dac" (setData).
+ *
+ * Built for the Linux platform, to run on the hardware:
+ *
+ *   g++ -std=c++11 -O2 -DLINUX_APP -o acqbench bench/acqbench.cpp Zmod/zmod.cpp Zmod/perf.cpp Zmod/regtrace.cpp Zmod/metrics.cpp Zmod/rt.cpp \
+ *       Zmod/linux/utils.c Zmod/linux/reg/reg.c Zmod/linux/dma/dma.c Zmod/linux/dma/libaxidma.c \
+ *       Zmod/linux/flash/flash.c Zmod/linux/timer/timer.c Zmod/linux/mem/mem.c \
+ *       ZmodADC1410/[a-z]*.cpp ZmodDAC1411/[a-z]*.cpp
+ *
+ * or for the fake platform, to run anywhere (CI); the buffer fill time and the DMA bandwidth
+ * are then simulated (see --sample-ns and --dma-mbps):
+ *
+ *   g++ -std=c++11 -O2 -DFAKE_APP -o acqbench bench/acqbench.cpp Zmod/zmod.cpp Zmod/perf.cpp Zmod/regtrace.cpp Zmod/metrics.cpp Zmod/rt.cpp \
+ *       Zmod/fake/reg/reg.c Zmod/fake/dma/dma.c Zmod/fake/flash/flash.c Zmod/fake/timer/timer.c \
+ *       Zmod/fake/mem/mem.c ZmodADC1410/[a-z]*.cpp ZmodDAC1411/[a-z]*.cpp
+ *
+ * With -DZMOD_REGTRACE, --regtrace saves the device accesses of the run to a trace file,
+ * to be analyzed with tools/regreplay.cpp (add Zmod/regtrace.cpp to the sources).
+ *
+ * --metrics writes the metrics of the devices at the end of the run, in the Prometheus text format.
+ *
+ * --rt runs in the real-time mode (see fnRtEnter), which usually needs root. Build with
+ * -DZMOD_ALLOC_CHECK -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free to count
+ * the heap calls.
+ *
+ * Run ./acqbench --help for the options.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <algorithm>
+
+#include "../Zmod/zmod.h"
+#include "../Zmod/timer.h"
+#include "../Zmod/regtrace.h"
+#include "../Zmod/metrics.h"
+#include "../Zmod/rt.h"
+#include "../ZmodADC1410/zmodadc1410.h"
+#include "../ZmodDAC1411/zmoddac1411.h"
+#ifdef FAKE_APP
+#include "../Zmod/fake/fake.h"
+#endif // FAKE_APP
+
+#define BENCH_DEF_ITERATIONS	1000	///< default number of acquisitions of each run
+#define BENCH_MAX_LENGTHS		16		///< maximum number of buffer lengths
+#define BENCH_REGTRACE_CAPACITY	(1 << 22)	///< maximum number of records of the device access trace
+
+#define BENCH_MODE_IMMEDIATE	(1 << 0)	///< immediate acquisitions
+#define BENCH_MODE_TRIGGERED	(1 << 1)	///< triggered acquisitions
+#define BENCH_MODE_DAC			(1 << 2)	///< DAC generations
+
+/**
+ * Struct containing the configuration of the benchmark.
+ */
+typedef struct _bench_config {
+	uintptr_t adcAddr; ///< ZmodADC1410 IP address
+	uintptr_t adcDmaAddr; ///< ZmodADC1410 DMA address
+	uintptr_t adcFlashAddr; ///< ZmodADC1410 flash address
+	int adcIrq; ///< ZmodADC1410 IP interrupt
+	int adcDmaIrq; ///< ZmodADC1410 DMA interrupt
+	uintptr_t dacAddr; ///< ZmodDAC1411 IP address
+	uintptr_t dacDmaAddr; ///< ZmodDAC1411 DMA address
+	uintptr_t dacFlashAddr; ///< ZmodDAC1411 flash address
+	int dacDmaIrq; ///< ZmodDAC1411 DMA interrupt
+	uintptr_t iicAddr; ///< IIC address of the flashes
+	uint32_t modes; ///< BENCH_MODE_* flags of the modes to run
+	size_t lengths[BENCH_MAX_LENGTHS]; ///< buffer lengths, in samples
+	uint32_t lengthCount; ///< number of buffer lengths
+	uint32_t iterations; ///< number of acquisitions of each run
+	uint32_t samplePeriodNs; ///< simulated sampling period (fake platform)
+	uint32_t dmaBytesPerUs; ///< simulated DMA bandwidth (fake platform)
+	const char *regTracePath; ///< file receiving the device access trace, NULL for none
+	const char *metricsPath; ///< file receiving the metrics of the devices, NULL for none
+	bool rt; ///< whether to run in the real-time mode
+	ZMODRtConfig rtConfig; ///< configuration of the real-time mode
+} BenchConfig;
+
+/**
+ * Struct containing a series of measured durations.
+ */
+typedef struct _bench_series {
+	uint64_t *values; ///< the durations, in nanoseconds
+	uint32_t count; ///< the number of durations
+} BenchSeries;
+
+static bool fFirstResult = true; ///< whether the next result is the first one
+
+/**
+ * Read the CPU time used by the process.
+ *
+ * @return the CPU time in nanoseconds
+ */
+static uint64_t fnGetCpuTimeNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Allocate a series of durations.
+ *
+ * @param series the series
+ * @param capacity the maximum number of durations
+ *
+ * @return true on success, false if the memory could not be allocated
+ */
+static bool fnAllocSeries(BenchSeries &series, uint32_t capacity)
+{
+	series.values = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+	series.count = 0;
+	fnRtPrefault(series.values, capacity * sizeof(uint64_t));
+	return series.values != NULL;
+}
+
+/**
+ * Get a percentile of a sorted series, by the nearest rank.
+ *
+ * @param series the sorted series, not empty
+ * @param percent the percentile, between 0 and 100
+ *
+ * @return the duration at the percentile
+ */
+static uint64_t fnPercentile(const BenchSeries &series, double percent)
+{
+	uint32_t rank = (uint32_t)(percent / 100.0 * series.count + 0.5);
+	if(rank < 1)
+	{
+		rank = 1;
+	}
+	if(rank > series.count)
+	{
+		rank = series.count;
+	}
+	return series.values[rank - 1];
+}
+
+/**
+ * Print the distribution of a series as a JSON member, and sort the series.
+ *
+ * @param name the name of the member
+ * @param series the series
+ */
+static void fnPrintSeries(const char *name, BenchSeries &series)
+{
+	double sum = 0;
+
+	if(!series.count)
+	{
+		printf(",\"%s\":null", name);
+		return;
+	}
+	std::sort(series.values, series.values + series.count);
+	for(uint32_t i = 0; i < series.count; i++)
+	{
+		sum += series.values[i];
+	}
+	printf(",\"%s\":{\"count\":%u,\"min\":%llu,\"mean\":%.1f,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu}",
+			name, series.count, (unsigned long long)series.values[0], sum / series.count,
+			(unsigned long long)fnPercentile(series, 50), (unsigned long long)fnPercentile(series, 90),
+			(unsigned long long)fnPercentile(series, 99), (unsigned long long)fnPercentile(series, 99.9),
+			(unsigned long long)series.values[series.count - 1]);
+}
+
+/**
+ * Print the loop jitter and the resource usage of a steady state as JSON members.
+ *
+ * @param jitter the period statistics of the loop
+ * @param before the resource usage before the steady state
+ * @param after the resource usage after the steady state
+ */
+static void fnPrintSteadyState(const ZMODRtJitter &jitter, const ZMODRtUsage &before, const ZMODRtUsage &after)
+{
+	printf(",\"loop_jitter_ns\":%llu,\"steady_state\":{\"heap_calls\":%llu,\"minor_faults\":%llu,"
+			"\"major_faults\":%llu,\"voluntary_switches\":%llu,\"involuntary_switches\":%llu}",
+			(unsigned long long)fnRtJitterWorstNs(&jitter),
+			(unsigned long long)(after.heapCalls - before.heapCalls),
+			(unsigned long long)(after.minorFaults - before.minorFaults),
+			(unsigned long long)(after.majorFaults - before.majorFaults),
+			(unsigned long long)(after.voluntarySwitches - before.voluntarySwitches),
+			(unsigned long long)(after.involuntarySwitches - before.involuntarySwitches));
+}
+
+/**
+ * Print the throughput members common to all the modes, opening the JSON result object.
+ *
+ * @param mode the name of the mode
+ * @param length the buffer length, in samples
+ * @param iterations the number of acquisitions
+ * @param errors the number of failed acquisitions
+ * @param wallNs the elapsed time of the run
+ * @param cpuNs the CPU time used by the run
+ * @param deadNs the total dead time of the run
+ */
+static void fnPrintResultHeader(const char *mode, size_t length, uint32_t iterations, uint32_t errors,
+		uint64_t wallNs, uint64_t cpuNs, uint64_t deadNs)
+{
+	double seconds = wallNs / 1e9;
+	size_t bytes = length * sizeof(uint32_t);
+
+	printf("%s\n    {\"mode\":\"%s\",\"length\":%zu,\"bytes\":%zu,\"iterations\":%u,\"errors\":%u,"
+			"\"acquisitions_per_s\":%.1f,\"mb_per_s\":%.3f,\"cpu_utilization\":%.3f,\"dead_time_fraction\":%.4f",
+			fFirstResult ? "" : ",", mode, length, bytes, iterations, errors,
+			iterations / seconds, (double)bytes * iterations / seconds / 1e6,
+			(double)cpuNs / wallNs, (double)deadNs / wallNs);
+	fFirstResult = false;
+}
+
+/**
+ * Run the acquisitions of one ADC mode and buffer length, and print the result.
+ *
+ * @param adc the ADC
+ * @param config the configuration of the benchmark
+ * @param mode BENCH_MODE_IMMEDIATE or BENCH_MODE_TRIGGERED
+ * @param length the buffer length, in samples
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnBenchAdc(ZMODADC1410 &adc, const BenchConfig &config, uint32_t mode, size_t length)
+{
+	BenchSeries armToFull, fullToDma, dead;
+	ZMODRtJitter jitter;
+	ZMODRtUsage usageBefore, usageAfter;
+	uint32_t *buffer;
+	uint32_t errors = 0;
+	uint64_t deadNs = 0, previousFull = 0;
+
+	buffer = adc.allocChannelsBuffer(length);
+	if(!buffer || !fnAllocSeries(armToFull, config.iterations) ||
+			!fnAllocSeries(fullToDma, config.iterations) || !fnAllocSeries(dead, config.iterations))
+	{
+		fprintf(stderr, "cannot allocate the buffers\n");
+		return ERR_FAIL;
+	}
+
+	// warm up the caches and the DMA buffer mapping
+	if(mode == BENCH_MODE_IMMEDIATE)
+	{
+		adc.acquireImmediatePolling(buffer, length);
+	}
+	else
+	{
+		adc.acquireTriggeredPolling(buffer, 0, 0, 0, 0, length);
+	}
+
+	fnRtJitterReset(&jitter);
+	fnRtGetUsage(&usageBefore);
+	uint64_t wallStart = fnGetTimeNs();
+	uint64_t cpuStart = fnGetCpuTimeNs();
+	for(uint32_t i = 0; i < config.iterations; i++)
+	{
+		uint8_t rc;
+		fnRtJitterTick(&jitter);
+		if(mode == BENCH_MODE_IMMEDIATE)
+		{
+			rc = adc.acquireImmediatePolling(buffer, length);
+		}
+		else
+		{
+			rc = adc.acquireTriggeredPolling(buffer, 0, 0, 0, 0, length);
+		}
+		if(rc != ERR_SUCCESS)
+		{
+			errors++;
+			previousFull = 0;
+			continue;
+		}
+
+		const ZMODTimestamps &times = adc.getTimestamps();
+		armToFull.values[armToFull.count++] = times.bufferFull - times.arm;
+		fullToDma.values[fullToDma.count++] = times.dmaComplete - times.bufferFull;
+		if(previousFull)
+		{
+			dead.values[dead.count++] = times.arm - previousFull;
+			deadNs += times.arm - previousFull;
+		}
+		previousFull = times.bufferFull;
+	}
+	uint64_t cpuNs = fnGetCpuTimeNs() - cpuStart;
+	uint64_t wallNs = fnGetTimeNs() - wallStart;
+	fnRtGetUsage(&usageAfter);
+
+	fnPrintResultHeader(mode == BENCH_MODE_IMMEDIATE ? "immediate" : "triggered", length,
+			config.iterations, errors, wallNs, cpuNs, deadNs);
+	fnPrintSeries("arm_to_buffer_full_ns", armToFull);
+	fnPrintSeries("buffer_full_to_dma_complete_ns", fullToDma);
+	fnPrintSeries("dead_time_ns", dead);
+	fnPrintSteadyState(jitter, usageBefore, usageAfter);
+	printf("}");
+
+	free(armToFull.values);
+	free(fullToDma.values);
+	free(dead.values);
+	adc.freeChannelsBuffer(buffer, length);
+	return ERR_SUCCESS;
+}
+
+/**
+ * Run the generations of the DAC for one buffer length, and print the result.
+ * Each generation stops the output, loads new data with setData and starts the output.
+ *
+ * @param dac the DAC
+ * @param config the configuration of the benchmark
+ * @param length the buffer length, in samples
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnBenchDac(ZMODDAC1411 &dac, const BenchConfig &config, size_t length)
+{
+	BenchSeries dma, dead;
+	ZMODRtJitter jitter;
+	ZMODRtUsage usageBefore, usageAfter;
+	uint32_t *buffer;
+	uint32_t errors = 0;
+	uint64_t deadNs = 0;
+
+	buffer = dac.allocChannelsBuffer(length);
+	if(!buffer || !fnAllocSeries(dma, config.iterations) || !fnAllocSeries(dead, config.iterations))
+	{
+		fprintf(stderr, "cannot allocate the buffers\n");
+		return ERR_FAIL;
+	}
+	for(size_t i = 0; i < length; i++)
+	{
+		buffer[i] = dac.arrangeChannelData(0, (uint16_t)(i << 2)) | dac.arrangeChannelData(1, (uint16_t)(i << 2));
+	}
+
+	// warm up the caches and the DMA buffer mapping
+	dac.setData(buffer, length);
+	dac.start();
+
+	fnRtJitterReset(&jitter);
+	fnRtGetUsage(&usageBefore);
+	uint64_t wallStart = fnGetTimeNs();
+	uint64_t cpuStart = fnGetCpuTimeNs();
+	for(uint32_t i = 0; i < config.iterations; i++)
+	{
+		fnRtJitterTick(&jitter);
+		uint64_t stopTime = fnGetTimeNs();
+		dac.stop();
+		if(dac.setData(buffer, length) != ERR_SUCCESS)
+		{
+			errors++;
+			continue;
+		}
+		dac.start();
+
+		const ZMODTimestamps &times = dac.getTimestamps();
+		dma.values[dma.count++] = times.dmaComplete - times.dmaStart;
+		dead.values[dead.count++] = times.arm - stopTime;
+		deadNs += times.arm - stopTime;
+	}
+	uint64_t cpuNs = fnGetCpuTimeNs() - cpuStart;
+	uint64_t wallNs = fnGetTimeNs() - wallStart;
+	fnRtGetUsage(&usageAfter);
+	dac.stop();
+
+	fnPrintResultHeader("dac", length, config.iterations, errors, wallNs, cpuNs, deadNs);
+	fnPrintSeries("dma_transfer_ns", dma);
+	fnPrintSeries("dead_time_ns", dead);
+	fnPrintSteadyState(jitter, usageBefore, usageAfter);
+	printf("}");
+
+	free(dma.values);
+	free(dead.values);
+	dac.freeChannelsBuffer(buffer, length);
+	return ERR_SUCCESS;
+}
+
+/**
+ * Print the usage of the benchmark.
+ *
+ * @param name the name of the executable
+ */
+static void fnUsage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  -m, --modes LIST       modes to run, among immediate,triggered,dac (default: all)\n"
+			"  -l, --lengths LIST     buffer lengths in samples (default: 256,1024,4096,16383)\n"
+			"  -n, --iterations N     acquisitions of each run (default: %d)\n"
+			"      --adc ADDR,DMA,FLASH,IRQ,DMAIRQ   ZmodADC1410 addresses and interrupts\n"
+			"      --dac ADDR,DMA,FLASH,DMAIRQ       ZmodDAC1411 addresses and interrupt\n"
+			"      --iic ADDR         IIC address of the flashes\n"
+			"      --sample-ns NS     simulated sampling period (fake platform, default: 10)\n"
+			"      --dma-mbps MBPS    simulated DMA bandwidth (fake platform, default: 400)\n"
+			"      --regtrace FILE    save the device access trace (built with ZMOD_REGTRACE)\n"
+			"      --metrics FILE     save the metrics of the devices, in the Prometheus text format\n"
+			"      --rt CPU[,PRIO]    real-time mode, pinned to CPU (-1 for any), under SCHED_FIFO if PRIO\n",
+			name, BENCH_DEF_ITERATIONS);
+}
+
+/**
+ * Parse a comma separated list of numbers.
+ *
+ * @param list the list
+ * @param values receives the numbers
+ * @param maxCount the maximum number of numbers
+ *
+ * @return the number of numbers, 0 on error
+ */
+static uint32_t fnParseList(const char *list, uint64_t *values, uint32_t maxCount)
+{
+	uint32_t count = 0;
+	char *end;
+
+	while(*list && count < maxCount)
+	{
+		values[count++] = strtoull(list, &end, 0);
+		if(end == list || (*end && *end != ','))
+		{
+			return 0;
+		}
+		list = *end ? end + 1 : end;
+	}
+	return *list ? 0 : count;
+}
+
+/**
+ * Parse the command line into the configuration.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @param config receives the configuration
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnParseArgs(int argc, char **argv, BenchConfig &config)
+{
+	static const struct option options[] = {
+		{"modes", required_argument, NULL, 'm'},
+		{"lengths", required_argument, NULL, 'l'},
+		{"iterations", required_argument, NULL, 'n'},
+		{"adc", required_argument, NULL, 'a'},
+		{"dac", required_argument, NULL, 'd'},
+		{"iic", required_argument, NULL, 'i'},
+		{"sample-ns", required_argument, NULL, 's'},
+		{"dma-mbps", required_argument, NULL, 'b'},
+		{"regtrace", required_argument, NULL, 't'},
+		{"metrics", required_argument, NULL, 'p'},
+		{"rt", required_argument, NULL, 'r'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+	uint64_t values[BENCH_MAX_LENGTHS];
+	int opt;
+
+	while((opt = getopt_long(argc, argv, "m:l:n:h", options, NULL)) != -1)
+	{
+		switch(opt)
+		{
+		case 'm':
+		{
+			char modes[64];
+			strncpy(modes, optarg, sizeof(modes) - 1);
+			modes[sizeof(modes) - 1] = 0;
+			config.modes = 0;
+			for(char *mode = strtok(modes, ","); mode; mode = strtok(NULL, ","))
+			{
+				if(!strcmp(mode, "immediate"))
+				{
+					config.modes |= BENCH_MODE_IMMEDIATE;
+				}
+				else if(!strcmp(mode, "triggered"))
+				{
+					config.modes |= BENCH_MODE_TRIGGERED;
+				}
+				else if(!strcmp(mode, "dac"))
+				{
+					config.modes |= BENCH_MODE_DAC;
+				}
+				else
+				{
+					return ERR_FAIL;
+				}
+			}
+			break;
+		}
+		case 'l':
+			config.lengthCount = fnParseList(optarg, values, BENCH_MAX_LENGTHS);
+			for(uint32_t i = 0; i < config.lengthCount; i++)
+			{
+				if(!values[i])
+				{
+					return ERR_FAIL;
+				}
+				config.lengths[i] = values[i];
+			}
+			if(!config.lengthCount)
+			{
+				return ERR_FAIL;
+			}
+			break;
+		case 'n':
+			config.iterations = strtoul(optarg, NULL, 0);
+			if(!config.iterations)
+			{
+				return ERR_FAIL;
+			}
+			break;
+		case 'a':
+			if(fnParseList(optarg, values, 5) != 5)
+			{
+				return ERR_FAIL;
+			}
+			config.adcAddr = values[0];
+			config.adcDmaAddr = values[1];
+			config.adcFlashAddr = values[2];
+			config.adcIrq = (int)values[3];
+			config.adcDmaIrq = (int)values[4];
+			break;
+		case 'd':
+			if(fnParseList(optarg, values, 4) != 4)
+			{
+				return ERR_FAIL;
+			}
+			config.dacAddr = values[0];
+			config.dacDmaAddr = values[1];
+			config.dacFlashAddr = values[2];
+			config.dacDmaIrq = (int)values[3];
+			break;
+		case 'i':
+			config.iicAddr = strtoull(optarg, NULL, 0);
+			break;
+		case 's':
+			config.samplePeriodNs = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			config.dmaBytesPerUs = strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			config.regTracePath = optarg;
+			break;
+		case 'p':
+			config.metricsPath = optarg;
+			break;
+		case 'r':
+		{
+			char *end;
+			config.rt = true;
+			config.rtConfig.cpu = (int)strtol(optarg, &end, 0);
+			if(end == optarg || (*end && *end != ','))
+			{
+				return ERR_FAIL;
+			}
+			if(*end)
+			{
+				config.rtConfig.priority = (int)strtol(end + 1, NULL, 0);
+			}
+			break;
+		}
+		default:
+			return ERR_FAIL;
+		}
+	}
+	return optind == argc ? ERR_SUCCESS : ERR_FAIL;
+}
+
+int main(int argc, char **argv)
+{
+	// the addresses of the Eclypse Z7 reference design
+	BenchConfig config = {
+		0x43C00000, 0x40400000, 0x30, 61, 62,
+		0x43C10000, 0x40410000, 0x31, 63,
+		0xE0005000,
+		BENCH_MODE_IMMEDIATE | BENCH_MODE_TRIGGERED | BENCH_MODE_DAC,
+		{256, 1024, 4096, 16383}, 4,
+		BENCH_DEF_ITERATIONS,
+		ZMODADC1410_SAMPLE_PERIOD_NS, 400,
+		NULL, NULL,
+		false, {ZMOD_RT_CPU_ANY, 0}
+	};
+	const char *metricsNames[2];
+	ZMODMetrics metrics[2];
+	uint32_t metricsCount = 0;
+
+	if(fnParseArgs(argc, argv, config) != ERR_SUCCESS)
+	{
+		fnUsage(argv[0]);
+		return 1;
+	}
+
+#ifdef FAKE_APP
+	fnFakeSetSamplePeriod(config.samplePeriodNs);
+	fnFakeSetDMABandwidth(config.dmaBytesPerUs);
+	const char *platform = "fake";
+#else
+	const char *platform = "linux";
+#endif // FAKE_APP
+
+	if(config.rt && fnRtEnter(&config.rtConfig) != ERR_SUCCESS)
+	{
+		fprintf(stderr, "cannot enter the real-time mode, check the privileges\n");
+		return 1;
+	}
+	if(config.regTracePath && fnRegTraceStart(BENCH_REGTRACE_CAPACITY) != ERR_SUCCESS)
+	{
+		fprintf(stderr, "cannot record the device accesses, build with ZMOD_REGTRACE\n");
+		return 1;
+	}
+
+	printf("{\"suite\":\"zmodlib-e2e\",\"platform\":\"%s\",\"results\":[", platform);
+	if(config.modes & (BENCH_MODE_IMMEDIATE | BENCH_MODE_TRIGGERED))
+	{
+		ZMODADC1410 adc(config.adcAddr, config.adcDmaAddr, config.iicAddr, config.adcFlashAddr,
+				config.adcIrq, config.adcDmaIrq);
+		for(uint32_t i = 0; i < config.lengthCount; i++)
+		{
+			if(config.modes & BENCH_MODE_IMMEDIATE)
+			{
+				fnBenchAdc(adc, config, BENCH_MODE_IMMEDIATE, config.lengths[i]);
+			}
+			if(config.modes & BENCH_MODE_TRIGGERED)
+			{
+				fnBenchAdc(adc, config, BENCH_MODE_TRIGGERED, config.lengths[i]);
+			}
+		}
+		metricsNames[metricsCount] = "adc";
+		adc.getMetrics(metrics[metricsCount++]);
+	}
+	if(config.modes & BENCH_MODE_DAC)
+	{
+		ZMODDAC1411 dac(config.dacAddr, config.dacDmaAddr, config.iicAddr, config.dacFlashAddr,
+				config.dacDmaIrq);
+		for(uint32_t i = 0; i < config.lengthCount; i++)
+		{
+			fnBenchDac(dac, config, config.lengths[i]);
+		}
+		metricsNames[metricsCount] = "dac";
+		dac.getMetrics(metrics[metricsCount++]);
+	}
+	printf("\n]}\n");
+
+	if(config.metricsPath)
+	{
+		char text[4096];
+		int length = fnMetricsFormatPrometheus(text, sizeof(text), metricsNames, metrics, metricsCount);
+		if(length < 0 || fnMetricsWriteFile(config.metricsPath, text, length) != ERR_SUCCESS)
+		{
+			fprintf(stderr, "cannot save the metrics to %s\n", config.metricsPath);
+			return 1;
+		}
+	}
+	if(config.regTracePath)
+	{
+		fnRegTraceStop();
+		if(fnRegTraceSave(config.regTracePath) != ERR_SUCCESS)
+		{
+			fprintf(stderr, "cannot save the device access trace to %s\n", config.regTracePath);
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file microbench.cpp
+ * @date 16 Oct 2026
+ * @brief Micro-benchmarks of the CPU-side kernels of the Zmod library.
+ *
+ * Each benchmark runs a kernel over a batch of inputs for a number of repetitions and reports
+ * the median time per operation, as one JSON document on the standard output:
+ *
+ *   {"suite":"zmodlib-micro","results":[{"name":"adc.channel_data","ns_per_op":1.23,
+ *     "ns_per_op_min":1.20,"ops":4096,"repetitions":101}, ...]}
+ *
+ * The benchmark names are stable, so results can be compared between revisions.
+ * The registers are accessed through the fake platform (an in-memory register file), so the
+ * register benchmarks measure the cost of the field arithmetic and of the platform call,
+ * without the bus access. Built on the host (or the target) with:
+ *
+ *   g++ -std=c++11 -O2 -DFAKE_APP -o microbench bench/microbench.cpp Zmod/zmod.cpp Zmod/perf.cpp Zmod/regtrace.cpp \
+ *       Zmod/metrics.cpp Zmod/rt.cpp \
+ *       Zmod/fake/reg/reg.c Zmod/fake/dma/dma.c Zmod/fake/flash/flash.c Zmod/fake/timer/timer.c \
+ *       Zmod/fake/mem/mem.c ZmodADC1410/[a-z]*.cpp ZmodDAC1411/[a-z]*.cpp
+ *
+ * Run with an optional number of repetitions: ./microbench [repetitions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#include "../Zmod/zmod.h"
+#include "../Zmod/timer.h"
+#include "../ZmodADC1410/zmodadc1410.h"
+#include "../ZmodDAC1411/zmoddac1411.h"
+
+#define BENCH_OPS		4096	///< number of operations of one repetition
+#define BENCH_DEF_REPS	101		///< default number of repetitions
+#define BENCH_MAX_REPS	10001	///< maximum number of repetitions
+
+#define BENCH_BASE_ADDR		0x43C00000	///< address of the fake ZMOD device
+#define BENCH_DMA_ADDR		0x40400000	///< address of the fake DMA device
+#define BENCH_IIC_ADDR		0xE0005000	///< address of the fake IIC device
+#define BENCH_FLASH_ADDR	0x30		///< address of the fake flash
+
+/**
+ * Prevent the compiler from optimizing away the computation of a value.
+ *
+ * @param value the value to keep
+ */
+template<typename T> static inline void fnDoNotOptimize(const T &value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Make the protected helpers of ZMOD reachable from the benchmarks.
+ */
+class BenchZMOD: public ZMODADC1410 {
+public:
+	BenchZMOD(): ZMODADC1410(BENCH_BASE_ADDR, BENCH_DMA_ADDR, BENCH_IIC_ADDR, BENCH_FLASH_ADDR, 0, 0) {}
+	using ZMOD::toSigned;
+	using ZMOD::computeCRC;
+};
+
+static uint32_t rgRaw[BENCH_OPS];		///< raw ADC/DAC buffer words
+static int16_t rgSigned[BENCH_OPS];		///< signed 14 bits samples
+static float rgVolts[BENCH_OPS];		///< voltages
+static uint8_t rgBytes[BENCH_OPS];		///< bytes for the CRC
+static char szValue[32];				///< formatted value
+static uint64_t rgSamples[BENCH_MAX_REPS];	///< duration of each repetition
+static unsigned int cReps = BENCH_DEF_REPS;	///< number of repetitions
+static bool fFirst = true;				///< whether the next result is the first one
+
+static BenchZMOD *pAdc;		///< ADC used by the benchmarks
+static ZMODDAC1411 *pDac;	///< DAC used by the benchmarks
+
+/**
+ * Run a benchmark and print its result.
+ *
+ * @param name the stable name of the benchmark
+ * @param ops the number of operations done by one call of fn
+ * @param fn the kernel, called once per repetition
+ */
+template<typename F> static void fnRun(const char *name, uint32_t ops, F fn)
+{
+	// warm up the caches and the branch predictors
+	fn();
+	for(unsigned int i = 0; i < cReps; i++)
+	{
+		uint64_t start = fnGetTimeNs();
+		fn();
+		rgSamples[i] = fnGetTimeNs() - start;
+	}
+	std::sort(rgSamples, rgSamples + cReps);
+	printf("%s\n    {\"name\":\"%s\",\"ns_per_op\":%.4f,\"ns_per_op_min\":%.4f,\"ops\":%u,\"repetitions\":%u}",
+			fFirst ? "" : ",", name, (double)rgSamples[cReps / 2] / ops, (double)rgSamples[0] / ops, ops, cReps);
+	fFirst = false;
+}
+
+/**
+ * Fill the inputs of the benchmarks with deterministic pseudo-random values.
+ */
+static void fnInitInputs()
+{
+	uint32_t seed = 0x12345678;
+	for(uint32_t i = 0; i < BENCH_OPS; i++)
+	{
+		seed = seed * 1664525 + 1013904223;
+		rgRaw[i] = seed;
+		rgSigned[i] = (int16_t)((int32_t)(seed >> 18) - 0x2000);
+		rgVolts[i] = ((float)(seed >> 8) / (float)(1 << 24)) * 2.0f - 1.0f;
+		rgBytes[i] = (uint8_t)(seed >> 24);
+	}
+}
+
+/**
+ * Run the benchmarks of the ADC conversions.
+ */
+static void fnBenchAdc()
+{
+	fnRun("adc.channel_data", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pAdc->channelData(i & 1, rgRaw[i]));
+		}
+	});
+	fnRun("adc.signed_channel_data", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pAdc->signedChannelData(i & 1, rgRaw[i]));
+		}
+	});
+	fnRun("adc.signed_channels_data", BENCH_OPS, [] {
+		pAdc->signedChannelsData(0, rgRaw, rgSigned, BENCH_OPS);
+		fnDoNotOptimize(rgSigned[0]);
+	});
+	fnRun("adc.get_volt_from_signed_raw", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pAdc->getVoltFromSignedRaw(rgSigned[i], i & 1));
+		}
+	});
+	fnRun("adc.get_volts_from_signed_raw", BENCH_OPS, [] {
+		pAdc->getVoltsFromSignedRaw(rgSigned, rgVolts, BENCH_OPS, 0);
+		fnDoNotOptimize(rgVolts[0]);
+	});
+}
+
+/**
+ * Run the benchmarks of the DAC conversions.
+ */
+static void fnBenchDac()
+{
+	fnRun("dac.arrange_channel_data", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pDac->arrangeChannelData(i & 1, (uint16_t)rgRaw[i]));
+		}
+	});
+	fnRun("dac.arrange_signed_channels_data", BENCH_OPS, [] {
+		pDac->arrangeSignedChannelsData(rgRaw, rgSigned, rgSigned, BENCH_OPS);
+		fnDoNotOptimize(rgRaw[0]);
+	});
+	fnRun("dac.get_signed_raw_from_volt", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pDac->getSignedRawFromVolt(rgVolts[i], i & 1));
+		}
+	});
+	fnRun("dac.get_signed_raw_from_volts", BENCH_OPS, [] {
+		pDac->getSignedRawFromVolts(rgSigned, rgVolts, BENCH_OPS, 0);
+		fnDoNotOptimize(rgSigned[0]);
+	});
+}
+
+/**
+ * Run the benchmarks of the common ZMOD helpers.
+ */
+static void fnBenchZmod()
+{
+	fnRun("zmod.to_signed", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pAdc->toSigned(rgRaw[i] & 0x3FFF, 14));
+		}
+	});
+	fnRun("zmod.compute_crc", BENCH_OPS, [] {
+		fnDoNotOptimize(pAdc->computeCRC(rgBytes, BENCH_OPS));
+	});
+	fnRun("zmod.format_value", 256, [] {
+		for(uint32_t i = 0; i < 256; i++)
+		{
+			pAdc->formatValue(szValue, rgVolts[i] * 10.0f, "V");
+			fnDoNotOptimize(szValue[0]);
+		}
+	});
+	fnRun("zmod.write_reg_fld", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			pAdc->writeRegFld(ZMODADC1410_REG_ADDR_WINDOW, 8, 14, rgRaw[i]);
+		}
+	});
+	fnRun("zmod.read_reg_fld", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pAdc->readRegFld(ZMODADC1410_REG_ADDR_WINDOW, i & 15, 14));
+		}
+	});
+	fnRun("zmod.write_signed_reg_fld", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			pAdc->writeSignedRegFld(ZMODADC1410_REG_ADDR_TRIG, 2, 14, rgSigned[i]);
+		}
+	});
+	fnRun("zmod.read_signed_reg_fld", BENCH_OPS, [] {
+		for(uint32_t i = 0; i < BENCH_OPS; i++)
+		{
+			fnDoNotOptimize(pAdc->readSignedRegFld(ZMODADC1410_REG_ADDR_TRIG, 2, 14));
+		}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	if(argc > 1)
+	{
+		cReps = (unsigned int)strtoul(argv[1], NULL, 0);
+		if(cReps < 1 || cReps > BENCH_MAX_REPS)
+		{
+			fprintf(stderr, "repetitions must be between 1 and %d\n", BENCH_MAX_REPS);
+			return 1;
+		}
+	}
+
+	fnInitInputs();
+	pAdc = new BenchZMOD();
+	pDac = new ZMODDAC1411(BENCH_BASE_ADDR + 0x10000, BENCH_DMA_ADDR + 0x10000, BENCH_IIC_ADDR, BENCH_FLASH_ADDR + 1, 0);
+
+	printf("{\"suite\":\"zmodlib-micro\",\"results\":[");
+	fnBenchAdc();
+	fnBenchDac();
+	fnBenchZmod();
+	printf("\n]}\n");
+
+	delete pDac;
+	delete pAdc;
+	return 0;
+}
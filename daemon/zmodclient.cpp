@@ -0,0 +1,555 @@
+/**
+ * @file zmodclient.cpp
+ * @date 16 Oct 2026
+ * @brief File containing implementations of the client of the Zmod access daemon.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "zmodclient.h"
+
+#define ZMODCLIENT_POLL_NS		20000	///< sleep of readNext while no acquisition is ready
+
+/**
+ * Create a closed client.
+ */
+ZMODClient::ZMODClient()
+{
+	fd = -1;
+	memset(&info, 0, sizeof(info));
+	ring = NULL;
+	header = NULL;
+	lost = 0;
+}
+
+/**
+ * Client destructor, closing the client.
+ */
+ZMODClient::~ZMODClient()
+{
+	close();
+}
+
+/**
+ * Connect to the daemon, and map its ring when it owns an ADC.
+ *
+ * @param socketPath the path of the control socket of the daemon, ZMODD_DEF_SOCKET by default
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::open(const char *socketPath)
+{
+	struct sockaddr_un addr;
+	int32_t version = ZMODD_VERSION;
+
+	close();
+	if(strlen(socketPath) >= sizeof(addr.sun_path))
+	{
+		return ERR_FAIL;
+	}
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0)
+	{
+		return ERR_FAIL;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socketPath);
+	if(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+			command(ZMODD_CMD_HELLO, &version, 1, NULL, 0, &info, sizeof(info)) != ERR_SUCCESS)
+	{
+		close();
+		return ERR_FAIL;
+	}
+	if(info.hasAdc)
+	{
+		int shmFd = shm_open(info.shmName, O_RDONLY, 0);
+		if(shmFd < 0)
+		{
+			close();
+			return ERR_FAIL;
+		}
+		void *map = mmap(NULL, info.shmSize, PROT_READ, MAP_SHARED, shmFd, 0);
+		::close(shmFd);
+		if(map == MAP_FAILED)
+		{
+			close();
+			return ERR_FAIL;
+		}
+		ring = (const uint8_t *)map;
+		header = (const ZMODDRingHeader *)ring;
+		if(__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != ZMODD_RING_MAGIC || header->version != ZMODD_VERSION ||
+				fnZmoddAlign(sizeof(ZMODDRingHeader)) + (uint64_t)header->slotCount * header->slotSize > info.shmSize)
+		{
+			close();
+			return ERR_FAIL;
+		}
+	}
+	lost = 0;
+	return ERR_SUCCESS;
+}
+
+/**
+ * Disconnect from the daemon, and unmap its ring.
+ */
+void ZMODClient::close()
+{
+	if(ring)
+	{
+		munmap((void *)ring, info.shmSize);
+		ring = NULL;
+		header = NULL;
+	}
+	if(fd >= 0)
+	{
+		::close(fd);
+		fd = -1;
+	}
+}
+
+/**
+ * Check that the client is connected.
+ *
+ * @return true if the client is connected
+ */
+bool ZMODClient::isOpen()
+{
+	return fd >= 0;
+}
+
+/**
+ * Check that the daemon owns a ZMOD ADC1410, and the client can read its acquisitions.
+ *
+ * @return true if the ADC commands and the ring can be used
+ */
+bool ZMODClient::hasAdc()
+{
+	return ring != NULL;
+}
+
+/**
+ * Check that the daemon owns a ZMOD DAC1411.
+ *
+ * @return true if the DAC commands can be used
+ */
+bool ZMODClient::hasDac()
+{
+	return fd >= 0 && info.hasDac;
+}
+
+/**
+ * Send a request to the daemon, and receive its response.
+ *
+ * @param command the zmodd_command
+ * @param args the arguments of the command
+ * @param argCount the number of arguments
+ * @param payload the payload of the request, NULL for none
+ * @param length the size of the payload
+ * @param response receives the payload of the response, NULL for none
+ * @param responseLength the size of the payload of the response
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::command(uint32_t command, const int32_t *args, uint32_t argCount,
+		const void *payload, uint32_t length, void *response, uint32_t responseLength)
+{
+	ZMODDRequest request;
+	ZMODDResponse status;
+	size_t received = 0;
+
+	if(fd < 0)
+	{
+		return ERR_FAIL;
+	}
+	memset(&request, 0, sizeof(request));
+	request.command = command;
+	request.length = length;
+	memcpy(request.args, args, argCount * sizeof(int32_t));
+	if(send(fd, &request, sizeof(request), MSG_NOSIGNAL) != sizeof(request) ||
+			(length && send(fd, payload, length, MSG_NOSIGNAL) != (ssize_t)length) ||
+			recv(fd, &status, sizeof(status), MSG_WAITALL) != sizeof(status))
+	{
+		return ERR_FAIL;
+	}
+	if(status.status != ERR_SUCCESS)
+	{
+		return ERR_FAIL;
+	}
+	if(status.length != responseLength)
+	{
+		// protocol mismatch, the connection cannot be used anymore
+		close();
+		return ERR_FAIL;
+	}
+	while(received < responseLength)
+	{
+		ssize_t rc = recv(fd, (uint8_t *)response + received, responseLength - received, 0);
+		if(rc <= 0)
+		{
+			return ERR_FAIL;
+		}
+		received += rc;
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Get the state of the daemon: settings, number of acquisitions, clients.
+ *
+ * @param status receives the state
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::getStatus(ZMODDStatus &status)
+{
+	return command(ZMODD_CMD_GET_STATUS, NULL, 0, NULL, 0, &status, sizeof(status));
+}
+
+/**
+ * Start the acquisitions of the daemon.
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::start()
+{
+	return command(ZMODD_CMD_START, NULL, 0, NULL, 0, NULL, 0);
+}
+
+/**
+ * Stop the acquisitions of the daemon, after the current one.
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::stop()
+{
+	return command(ZMODD_CMD_STOP, NULL, 0, NULL, 0, NULL, 0);
+}
+
+/**
+ * Set the number of samples of the next acquisitions.
+ *
+ * @param length the number of samples, at most getMaxLength and at least the trigger window
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setLength(size_t length)
+{
+	int32_t args[1] = {(int32_t)length};
+
+	if(length > getMaxLength())
+	{
+		return ERR_FAIL;
+	}
+	return command(ZMODD_CMD_SET_LENGTH, args, 1, NULL, 0, NULL, 0);
+}
+
+/**
+ * Set the trigger of the next acquisitions.
+ *
+ * @param channel the trigger channel, 0 for channel 1, 1 for channel 2
+ * @param mode the trigger mode, 0 for normal trigger, 1 for not trigger
+ * @param level the trigger level, signed raw value
+ * @param edge the trigger edge, 0 for rising edge, 1 for falling edge
+ * @param window the window position (index of the trigger sample in the buffer)
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setTrigger(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window)
+{
+	int32_t args[5] = {channel, mode, level, edge, (int32_t)window};
+
+	return command(ZMODD_CMD_SET_TRIGGER, args, 5, NULL, 0, NULL, 0);
+}
+
+/**
+ * Set the gain of an ADC channel, for the next acquisitions.
+ *
+ * @param channel the channel, 0 for channel 1, 1 for channel 2
+ * @param gain the gain, 0 for LOW gain, 1 for HIGH gain
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setGain(uint8_t channel, uint8_t gain)
+{
+	int32_t args[2] = {channel, gain};
+
+	return command(ZMODD_CMD_SET_GAIN, args, 2, NULL, 0, NULL, 0);
+}
+
+/**
+ * Set the coupling of an ADC channel, for the next acquisitions.
+ *
+ * @param channel the channel, 0 for channel 1, 1 for channel 2
+ * @param coupling the coupling, 0 for DC Coupling, 1 for AC Coupling
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setCoupling(uint8_t channel, uint8_t coupling)
+{
+	int32_t args[2] = {channel, coupling};
+
+	return command(ZMODD_CMD_SET_COUPLING, args, 2, NULL, 0, NULL, 0);
+}
+
+/**
+ * Set the gain of a DAC channel.
+ *
+ * @param channel the channel, 0 for channel 1, 1 for channel 2
+ * @param gain the gain, 0 for LOW gain, 1 for HIGH gain
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setDacGain(uint8_t channel, uint8_t gain)
+{
+	int32_t args[2] = {channel, gain};
+
+	return command(ZMODD_CMD_DAC_SET_GAIN, args, 2, NULL, 0, NULL, 0);
+}
+
+/**
+ * Set the DAC output sample frequency divider.
+ *
+ * @param divider the divider
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setDacDivider(uint16_t divider)
+{
+	int32_t args[1] = {divider};
+
+	return command(ZMODD_CMD_DAC_SET_DIVIDER, args, 1, NULL, 0, NULL, 0);
+}
+
+/**
+ * Load the samples of the DAC output, restarting the output if it runs.
+ *
+ * @param data1 the signed raw values of channel 1
+ * @param data2 the signed raw values of channel 2
+ * @param length the number of samples of each channel, at most ZmodDAC1411_MAX_BUFFER_LEN
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::setDacData(const int16_t *data1, const int16_t *data2, size_t length)
+{
+	int32_t args[1] = {(int32_t)length};
+	int16_t *payload;
+	int status;
+
+	if(!length || length > ZmodDAC1411_MAX_BUFFER_LEN)
+	{
+		return ERR_FAIL;
+	}
+	payload = (int16_t *)malloc(2 * length * sizeof(int16_t));
+	if(!payload)
+	{
+		return ERR_FAIL;
+	}
+	memcpy(payload, data1, length * sizeof(int16_t));
+	memcpy(payload + length, data2, length * sizeof(int16_t));
+	status = command(ZMODD_CMD_DAC_SET_DATA, args, 1, payload, 2 * length * sizeof(int16_t), NULL, 0);
+	free(payload);
+	return status;
+}
+
+/**
+ * Start the DAC output, once samples are loaded.
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::startDac()
+{
+	return command(ZMODD_CMD_DAC_START, NULL, 0, NULL, 0, NULL, 0);
+}
+
+/**
+ * Stop the DAC output.
+ *
+ * @return 0 on success, any other number on failure
+ */
+int ZMODClient::stopDac()
+{
+	return command(ZMODD_CMD_DAC_STOP, NULL, 0, NULL, 0, NULL, 0);
+}
+
+/**
+ * Get the number of slots of the ring.
+ *
+ * @return the number of slots, 0 without ADC
+ */
+uint32_t ZMODClient::getSlotCount()
+{
+	return header ? header->slotCount : 0;
+}
+
+/**
+ * Get the maximum number of samples of an acquisition.
+ *
+ * @return the maximum length, 0 without ADC
+ */
+size_t ZMODClient::getMaxLength()
+{
+	return header ? header->maxLength : 0;
+}
+
+/**
+ * Get the number of acquisitions published to the ring, the sequence of the next one.
+ *
+ * @return the number of acquisitions, 0 without ADC
+ */
+uint64_t ZMODClient::getHead()
+{
+	return header ? __atomic_load_n(&header->head, __ATOMIC_ACQUIRE) : 0;
+}
+
+/**
+ * Get the slot holding an acquisition.
+ *
+ * @param sequence the number of the acquisition
+ *
+ * @return the slot
+ */
+const ZMODDSlot *ZMODClient::getSlot(uint64_t sequence)
+{
+	return (const ZMODDSlot *)(ring + fnZmoddAlign(sizeof(ZMODDRingHeader)) +
+			(sequence % header->slotCount) * header->slotSize);
+}
+
+/**
+ * Start reading an acquisition in place, without copy. The samples and acqInfo are only
+ * valid if endRead then succeeds: the daemon can overwrite the slot at any time.
+ *
+ * @param sequence the number of the acquisition
+ * @param acqInfo receives the settings and times of the acquisition, acqInfo.length is the number of samples
+ * @param token receives the token to pass to endRead
+ *
+ * @return the samples of the acquisition, NULL if the acquisition is not in the ring
+ */
+const uint32_t *ZMODClient::beginRead(uint64_t sequence, AcquisitionInfo &acqInfo, uint64_t &token)
+{
+	const ZMODDSlot *slot;
+
+	if(!ring || sequence >= getHead())
+	{
+		return NULL;
+	}
+	slot = getSlot(sequence);
+	token = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE);
+	if((token & 1) || slot->sequence != sequence)
+	{
+		return NULL;
+	}
+	acqInfo = slot->info;
+	if(acqInfo.length > header->maxLength)
+	{
+		// torn read, endRead fails
+		acqInfo.length = 0;
+	}
+	return (const uint32_t *)((const uint8_t *)slot + header->dataOffset);
+}
+
+/**
+ * Finish reading an acquisition started with beginRead.
+ *
+ * @param sequence the number of the acquisition
+ * @param token the token returned by beginRead
+ *
+ * @return true if the slot was not overwritten during the read, and the data read is valid
+ */
+bool ZMODClient::endRead(uint64_t sequence, uint64_t token)
+{
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return __atomic_load_n(&getSlot(sequence)->lock, __ATOMIC_RELAXED) == token;
+}
+
+/**
+ * Copy an acquisition from the ring.
+ *
+ * @param sequence the number of the acquisition
+ * @param buffer receives the samples
+ * @param maxLength the number of samples buffer can hold, at least getMaxLength to receive all the acquisitions
+ * @param acqInfo receives the settings and times of the acquisition, acqInfo.length is the number of samples
+ *
+ * @return 0 on success, any other number if the acquisition is not in the ring, was overwritten
+ * during the copy, or is longer than maxLength
+ */
+int ZMODClient::read(uint64_t sequence, uint32_t *buffer, size_t maxLength, AcquisitionInfo &acqInfo)
+{
+	uint64_t token;
+	const uint32_t *data = beginRead(sequence, acqInfo, token);
+
+	if(!data || acqInfo.length > maxLength)
+	{
+		return ERR_FAIL;
+	}
+	memcpy(buffer, data, acqInfo.length * sizeof(uint32_t));
+	return endRead(sequence, token) ? ERR_SUCCESS : ERR_FAIL;
+}
+
+/**
+ * Copy the next acquisition from the ring, waiting for it if needed. When the reader is
+ * late, the acquisitions overwritten in the ring are skipped, and counted by getLost.
+ * Start with cursor at getHead to read the live stream.
+ *
+ * @param cursor the number of the acquisition to read, advanced past the acquisition read - passed by reference
+ * @param buffer receives the samples, getMaxLength long
+ * @param maxLength the number of samples buffer can hold, at least getMaxLength
+ * @param acqInfo receives the settings and times of the acquisition, acqInfo.length is the number of samples
+ * @param timeoutNs the maximum time to wait for the acquisition, 0 to return at once
+ *
+ * @return true if an acquisition was read, false on timeout
+ */
+bool ZMODClient::readNext(uint64_t &cursor, uint32_t *buffer, size_t maxLength, AcquisitionInfo &acqInfo, uint64_t timeoutNs)
+{
+	struct timespec start, now;
+	struct timespec pause = {0, ZMODCLIENT_POLL_NS};
+
+	if(!ring || maxLength < header->maxLength)
+	{
+		return false;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(;;)
+	{
+		uint64_t head = getHead();
+		if(cursor < head)
+		{
+			// the slot of head is the next one written, only the slotCount - 1 previous ones are stable
+			uint64_t oldest = head >= header->slotCount ? head - header->slotCount + 1 : 0;
+			if(cursor < oldest)
+			{
+				lost += oldest - cursor;
+				cursor = oldest;
+			}
+			if(read(cursor, buffer, maxLength, acqInfo) == ERR_SUCCESS)
+			{
+				cursor++;
+				return true;
+			}
+			// overwritten during the copy, skip to the new oldest acquisition
+			continue;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec - start.tv_nsec >= timeoutNs)
+		{
+			return false;
+		}
+		nanosleep(&pause, NULL);
+	}
+}
+
+/**
+ * Get the number of acquisitions skipped by readNext because the reader was late.
+ *
+ * @return the number of acquisitions lost
+ */
+uint64_t ZMODClient::getLost()
+{
+	return lost;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file zmodclient.h
+ * @date 16 Oct 2026
+ * @brief Client library of the Zmod access daemon.
+ *
+ * The client connects to the control socket of the daemon (zmodd.cpp), sends its commands,
+ * and maps the shared memory ring read-only to read the acquisitions. Any number of clients
+ * read the same ring: the daemon writes each acquisition once, and a client reading costs
+ * the daemon nothing.
+ *
+ * Built with the sources of the application, without the rest of the library:
+ *
+ *   g++ -std=c++11 -O2 -DLINUX_APP -o app app.cpp daemon/zmodclient.cpp -lrt
+ */
+
+#ifndef ZMODCLIENT_H_
+#define ZMODCLIENT_H_
+
+#include "zmodd.h"
+
+/**
+ * Class connecting to the Zmod access daemon. The commands apply to the devices owned by
+ * the daemon, shared by all the clients. The acquisitions published to the ring are
+ * numbered from 0; the ring holds the last ones, getSlotCount - 1 of them being readable
+ * at any time. A read fails when the daemon overwrites the slot during the read.
+ *
+ * The methods of a client must be called from one thread.
+ */
+class ZMODClient {
+private:
+	int fd; ///< the control socket, -1 when closed
+	ZMODDInfo info; ///< description of the ring
+	const uint8_t *ring; ///< the shared memory ring, mapped read-only, NULL without ADC
+	const ZMODDRingHeader *header; ///< header of the ring
+	uint64_t lost; ///< number of acquisitions missed by readNext
+
+	int command(uint32_t command, const int32_t *args, uint32_t argCount,
+			const void *payload, uint32_t length, void *response, uint32_t responseLength);
+	const ZMODDSlot *getSlot(uint64_t sequence);
+
+public:
+	ZMODClient();
+	~ZMODClient();
+
+	int open(const char *socketPath);
+	void close();
+	bool isOpen();
+	bool hasAdc();
+	bool hasDac();
+	int getStatus(ZMODDStatus &status);
+
+	int start();
+	int stop();
+	int setLength(size_t length);
+	int setTrigger(uint8_t channel, uint8_t mode, int16_t level, uint8_t edge, uint32_t window);
+	int setGain(uint8_t channel, uint8_t gain);
+	int setCoupling(uint8_t channel, uint8_t coupling);
+
+	int setDacGain(uint8_t channel, uint8_t gain);
+	int setDacDivider(uint16_t divider);
+	int setDacData(const int16_t *data1, const int16_t *data2, size_t length);
+	int startDac();
+	int stopDac();
+
+	uint32_t getSlotCount();
+	size_t getMaxLength();
+	uint64_t getHead();
+	const uint32_t *beginRead(uint64_t sequence, AcquisitionInfo &acqInfo, uint64_t &token);
+	bool endRead(uint64_t sequence, uint64_t token);
+	int read(uint64_t sequence, uint32_t *buffer, size_t maxLength, AcquisitionInfo &acqInfo);
+	bool readNext(uint64_t &cursor, uint32_t *buffer, size_t maxLength, AcquisitionInfo &acqInfo, uint64_t timeoutNs);
+	uint64_t getLost();
+};
+
+#endif /* ZMODCLIENT_H_ */
@@ -0,0 +1,1036 @@
+/**
+ * @file zmodd.cpp
+ * @date 16 Oct 2026
+ * @brief Zmod access daemon, sharing the ZmodADC1410 and ZmodDAC1411 between local processes.
+ *
+ * Only one process can open the DMA devices of a Zmod. The daemon owns the ZMODADC1410 and
+ * ZMODDAC1411 instances, and exposes them to several local clients (see zmodclient.h):
+ *  - a control API on a Unix stream socket: ADC acquisition settings, start and stop of the
+ *    acquisitions, DAC settings and samples (see zmodd.h for the protocol). The settings are
+ *    shared by all the clients, the last command wins.
+ *  - a POSIX shared memory ring holding the last acquisitions, which the clients map
+ *    read-only. The ring is written once, whatever the number of clients, and the daemon
+ *    never waits for them: a client reading too slowly loses acquisitions, detected by the
+ *    sequence lock of the ring slots.
+ *
+ * The acquisition thread runs ZMODADC1410::acquireStreamPolling on an ADCStream, and the
+ * ring writer thread copies each buffer of the stream into the ring, so the copy overlaps the
+ * next acquisition. The DMA buffers cannot be shared with the clients, hence this one copy.
+ * The main thread serves the control socket and owns the DAC. The new settings are applied
+ * by the acquisition thread before its next acquisition: while it waits for a trigger that
+ * never comes, the settings, stop and exit wait too.
+ *
+ * Built for the Linux platform, to run on the hardware:
+ *
+ *   g++ -std=c++11 -O2 -DLINUX_APP -pthread -o zmodd daemon/zmodd.cpp Zmod/zmod.cpp Zmod/perf.cpp Zmod/regtrace.cpp Zmod/metrics.cpp Zmod/rt.cpp \
+ *       Zmod/linux/utils.c Zmod/linux/reg/reg.c Zmod/linux/dma/dma.c Zmod/linux/dma/libaxidma.c \
+ *       Zmod/linux/flash/flash.c Zmod/linux/timer/timer.c Zmod/linux/mem/mem.c \
+ *       ZmodADC1410/[a-z]*.cpp ZmodDAC1411/[a-z]*.cpp -lrt
+ *
+ * or for the fake platform, to run anywhere:
+ *
+ *   g++ -std=c++11 -O2 -DFAKE_APP -pthread -o zmodd daemon/zmodd.cpp Zmod/zmod.cpp Zmod/perf.cpp Zmod/regtrace.cpp Zmod/metrics.cpp Zmod/rt.cpp \
+ *       Zmod/fake/reg/reg.c Zmod/fake/dma/dma.c Zmod/fake/flash/flash.c Zmod/fake/timer/timer.c \
+ *       Zmod/fake/mem/mem.c ZmodADC1410/[a-z]*.cpp ZmodDAC1411/[a-z]*.cpp -lrt
+ *
+ * Run ./zmodd --help for the options. SIGINT or SIGTERM stops the daemon, which removes
+ * the socket and the ring.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../Zmod/zmod.h"
+#include "../Zmod/metrics.h"
+#include "../Zmod/rt.h"
+#include "../ZmodADC1410/zmodadc1410.h"
+#include "../ZmodADC1410/adcstream.h"
+#include "../ZmodDAC1411/zmoddac1411.h"
+#include "zmodd.h"
+
+#define ZMODD_MAX_CLIENTS		16		///< maximum number of connected clients
+#define ZMODD_DEF_SLOTS			16		///< default number of slots of the ring
+#define ZMODD_STREAM_BUFFERS	4		///< number of DMA buffers of the acquisition stream
+#define ZMODD_IDLE_US			1000	///< sleep of the acquisition thread while stopped
+#define ZMODD_WRITER_POLL_US	20		///< sleep of the ring writer while no buffer is ready
+#define ZMODD_POLL_MS			100		///< maximum time between two checks of the stop signal
+#define ZMODD_CLIENT_TIMEOUT_MS	1000	///< maximum time to receive a request once it started
+#define ZMODD_EXIT_TIMEOUT_MS	1000	///< maximum time to wait for the acquisition thread on exit
+
+/**
+ * Struct containing the configuration of the daemon.
+ */
+typedef struct _zmodd_config {
+	uintptr_t adcAddr; ///< ZmodADC1410 IP address
+	uintptr_t adcDmaAddr; ///< ZmodADC1410 DMA address
+	uintptr_t adcFlashAddr; ///< ZmodADC1410 flash address
+	int adcIrq; ///< ZmodADC1410 IP interrupt
+	int adcDmaIrq; ///< ZmodADC1410 DMA interrupt
+	uintptr_t dacAddr; ///< ZmodDAC1411 IP address
+	uintptr_t dacDmaAddr; ///< ZmodDAC1411 DMA address
+	uintptr_t dacFlashAddr; ///< ZmodDAC1411 flash address
+	int dacDmaIrq; ///< ZmodDAC1411 DMA interrupt
+	uintptr_t iicAddr; ///< IIC address of the flashes
+	bool adc; ///< whether to own the ZmodADC1410
+	bool dac; ///< whether to own the ZmodDAC1411
+	const char *socketPath; ///< path of the control socket
+	const char *shmName; ///< name of the shared memory ring
+	uint32_t slots; ///< number of slots of the ring
+	const char *metricsPath; ///< path of the socket serving the metrics, NULL for none
+	bool rt; ///< whether to run the acquisition thread in the real-time mode
+	ZMODRtConfig rtConfig; ///< configuration of the real-time mode
+} ZmoddConfig;
+
+/**
+ * Struct containing a connected client.
+ */
+typedef struct _zmodd_client {
+	int fd; ///< the socket of the client
+} ZmoddClient;
+
+static ZmoddConfig config = {
+	// the addresses of the Eclypse Z7 reference design
+	0x43C00000, 0x40400000, 0x30, 61, 62,
+	0x43C10000, 0x40410000, 0x31, 63,
+	0xE0005000,
+	true, true,
+	ZMODD_DEF_SOCKET, ZMODD_DEF_SHM, ZMODD_DEF_SLOTS,
+	NULL,
+	false, {ZMOD_RT_CPU_ANY, 0}
+}; ///< configuration of the daemon
+
+static volatile sig_atomic_t fQuit = 0; ///< set by the signals to stop the daemon
+static uint32_t fStop = 0; ///< set to stop the threads
+static ZMODADC1410 *pAdc = NULL; ///< the ADC, used by the acquisition thread only
+static ZMODDAC1411 *pDac = NULL; ///< the DAC, used by the main thread only
+static ADCStream *pStream = NULL; ///< stream of the acquisitions, from the acquisition thread to the ring writer
+static int iConsumer = 0; ///< consumer number of the ring writer in the stream
+static uint8_t *pRing = NULL; ///< the shared memory ring
+static size_t cbRing = 0; ///< size of the ring, in bytes
+
+static pthread_mutex_t mtxSettings = PTHREAD_MUTEX_INITIALIZER; ///< protects settings
+static AcquisitionInfo settings; ///< settings of the next acquisitions, written by the main thread
+static uint32_t iSettings = 0; ///< incremented at each change of settings
+static uint32_t fRunning = 0; ///< whether the acquisitions are running
+static uint32_t fAcquisitionDone = 0; ///< set when the acquisition thread exits
+static uint64_t cFailures = 0; ///< number of failed acquisitions
+
+static uint32_t *pDacBuffer = NULL; ///< DAC samples, ZmodDAC1411_MAX_BUFFER_LEN long
+static size_t cDacSamples = 0; ///< number of DAC samples loaded
+static bool fDacRunning = false; ///< whether the DAC output is running
+
+static ZmoddClient rgClients[ZMODD_MAX_CLIENTS]; ///< connected clients
+static uint32_t cClients = 0; ///< number of connected clients
+static uint8_t rgPayload[ZMODD_MAX_PAYLOAD]; ///< payload of the request being served
+
+/**
+ * Stop the daemon on a signal.
+ */
+static void fnOnSignal(int)
+{
+	fQuit = 1;
+}
+
+/**
+ * Create the shared memory ring, replacing a stale one.
+ *
+ * @param name the name of the ring
+ * @param slotCount the number of slots
+ * @param maxLength the maximum number of samples of a slot
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnRingCreate(const char *name, uint32_t slotCount, size_t maxLength)
+{
+	ZMODDRingHeader *header;
+	size_t dataOffset = fnZmoddAlign(sizeof(ZMODDSlot));
+	size_t slotSize = dataOffset + fnZmoddAlign(maxLength * sizeof(uint32_t));
+	int fd;
+
+	cbRing = fnZmoddAlign(sizeof(ZMODDRingHeader)) + slotCount * slotSize;
+	shm_unlink(name);
+	// the clients map the ring read-only
+	fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+	if(fd < 0)
+	{
+		return ERR_FAIL;
+	}
+	if(ftruncate(fd, cbRing))
+	{
+		close(fd);
+		shm_unlink(name);
+		return ERR_FAIL;
+	}
+	pRing = (uint8_t *)mmap(NULL, cbRing, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if(pRing == MAP_FAILED)
+	{
+		pRing = NULL;
+		shm_unlink(name);
+		return ERR_FAIL;
+	}
+	// the ring is zeroed by ftruncate, the slots are unlocked and empty
+	header = (ZMODDRingHeader *)pRing;
+	header->version = ZMODD_VERSION;
+	header->slotCount = slotCount;
+	header->slotSize = slotSize;
+	header->dataOffset = dataOffset;
+	header->maxLength = maxLength;
+	header->head = 0;
+	__atomic_store_n(&header->magic, ZMODD_RING_MAGIC, __ATOMIC_RELEASE);
+	return ERR_SUCCESS;
+}
+
+/**
+ * Remove the shared memory ring. The clients keep their mappings until they close them.
+ *
+ * @param name the name of the ring
+ */
+static void fnRingDestroy(const char *name)
+{
+	if(pRing)
+	{
+		munmap(pRing, cbRing);
+		pRing = NULL;
+	}
+	shm_unlink(name);
+}
+
+/**
+ * Copy an acquisition into the next slot of the ring, and publish it (ring writer only).
+ *
+ * @param streamBuffer the buffer of the acquisition
+ */
+static void fnRingWrite(const ADCStreamBuffer *streamBuffer)
+{
+	ZMODDRingHeader *header = (ZMODDRingHeader *)pRing;
+	uint64_t sequence = header->head;
+	ZMODDSlot *slot = (ZMODDSlot *)(pRing + fnZmoddAlign(sizeof(ZMODDRingHeader)) +
+			(sequence % header->slotCount) * header->slotSize);
+	uint64_t lock = slot->lock;
+
+	// odd while writing: a reader seeing the same even value before and after its read got a consistent slot
+	__atomic_store_n(&slot->lock, lock + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	slot->sequence = sequence;
+	slot->streamSequence = streamBuffer->sequence;
+	slot->info = streamBuffer->info;
+	memcpy((uint8_t *)slot + header->dataOffset, streamBuffer->buffer, streamBuffer->info.length * sizeof(uint32_t));
+	__atomic_store_n(&slot->lock, lock + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&header->head, sequence + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Acquisition thread: applies the settings and runs the acquisitions of the stream.
+ *
+ * @return NULL
+ */
+static void *fnAcquisitionThread(void *)
+{
+	uint32_t applied = __atomic_load_n(&iSettings, __ATOMIC_ACQUIRE) - 1;
+
+	if(config.rt && fnRtEnter(&config.rtConfig) != ERR_SUCCESS)
+	{
+		fprintf(stderr, "cannot enter the real-time mode, check the privileges\n");
+		fQuit = 1;
+	}
+	while(!__atomic_load_n(&fStop, __ATOMIC_ACQUIRE))
+	{
+		if(__atomic_load_n(&iSettings, __ATOMIC_ACQUIRE) != applied)
+		{
+			AcquisitionInfo next;
+			pthread_mutex_lock(&mtxSettings);
+			next = settings;
+			applied = iSettings;
+			pthread_mutex_unlock(&mtxSettings);
+			for(uint8_t ch = 0; ch < 2; ch++)
+			{
+				pAdc->setGain(ch, next.gain[ch]);
+				pAdc->setCoupling(ch, next.coupling[ch]);
+			}
+			pStream->setTrigger(next.trigChannel, next.trigMode, next.trigLevel, next.trigEdge, next.window);
+			pStream->setAcquisitionLength(next.length);
+		}
+		if(!__atomic_load_n(&fRunning, __ATOMIC_ACQUIRE))
+		{
+			usleep(ZMODD_IDLE_US);
+			continue;
+		}
+		uint64_t overruns = pStream->getOverruns();
+		if(pAdc->acquireStreamPolling(*pStream) != ERR_SUCCESS)
+		{
+			if(pStream->getOverruns() == overruns)
+			{
+				__atomic_fetch_add(&cFailures, 1, __ATOMIC_RELAXED);
+			}
+			// let the ring writer return the buffers
+			usleep(ZMODD_WRITER_POLL_US);
+		}
+	}
+	__atomic_store_n(&fAcquisitionDone, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+/**
+ * Ring writer thread: copies the buffers of the stream into the ring.
+ *
+ * @return NULL
+ */
+static void *fnRingWriterThread(void *)
+{
+	ADCStreamBuffer *received[ZMODD_STREAM_BUFFERS];
+
+	while(!__atomic_load_n(&fStop, __ATOMIC_ACQUIRE))
+	{
+		size_t count = pStream->receive(iConsumer, received, ZMODD_STREAM_BUFFERS);
+		if(!count)
+		{
+			usleep(ZMODD_WRITER_POLL_US);
+			continue;
+		}
+		for(size_t i = 0; i < count; i++)
+		{
+			fnRingWrite(received[i]);
+		}
+		pStream->release(iConsumer, received, count);
+	}
+	return NULL;
+}
+
+/**
+ * Change the settings of the next acquisitions, under the settings lock.
+ *
+ * @param request the request of a ZMODD_CMD_SET_* command
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnChangeSettings(const ZMODDRequest &request)
+{
+	const int32_t *args = request.args;
+	int status = ERR_SUCCESS;
+
+	if(request.command != ZMODD_CMD_SET_LENGTH && request.command != ZMODD_CMD_SET_TRIGGER && (args[0] < 0 || args[0] > 1))
+	{
+		return ERR_FAIL;
+	}
+	pthread_mutex_lock(&mtxSettings);
+	switch(request.command)
+	{
+	case ZMODD_CMD_SET_LENGTH:
+		// the trigger window must stay within the acquisition, as checked by ZMODD_CMD_SET_TRIGGER
+		if(args[0] <= 0 || (size_t)args[0] > pStream->getLength() || (size_t)args[0] < settings.window)
+		{
+			status = ERR_FAIL;
+			break;
+		}
+		settings.length = args[0];
+		break;
+	case ZMODD_CMD_SET_TRIGGER:
+		if(args[0] < 0 || args[0] > 1 || args[4] < 0 || (size_t)args[4] > settings.length)
+		{
+			status = ERR_FAIL;
+			break;
+		}
+		settings.trigChannel = args[0];
+		settings.trigMode = args[1];
+		settings.trigLevel = args[2];
+		settings.trigEdge = args[3];
+		settings.window = args[4];
+		break;
+	case ZMODD_CMD_SET_GAIN:
+		settings.gain[args[0]] = args[1] ? 1 : 0;
+		break;
+	case ZMODD_CMD_SET_COUPLING:
+		settings.coupling[args[0]] = args[1] ? 1 : 0;
+		break;
+	}
+	if(status == ERR_SUCCESS)
+	{
+		__atomic_fetch_add(&iSettings, 1, __ATOMIC_RELEASE);
+	}
+	pthread_mutex_unlock(&mtxSettings);
+	return status;
+}
+
+/**
+ * Load the DAC samples of a ZMODD_CMD_DAC_SET_DATA request, restarting the output if it runs.
+ *
+ * @param request the request
+ * @param payload the signed raw values of channel 1, then of channel 2
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnSetDacData(const ZMODDRequest &request, const int16_t *payload)
+{
+	size_t length = request.args[0];
+
+	if(!length || length > ZmodDAC1411_MAX_BUFFER_LEN || request.length != 2 * length * sizeof(int16_t))
+	{
+		return ERR_FAIL;
+	}
+	pDac->arrangeSignedChannelsData(pDacBuffer, payload, payload + length, length);
+	if(fDacRunning)
+	{
+		pDac->stop();
+	}
+	if(pDac->setData(pDacBuffer, length) != ERR_SUCCESS)
+	{
+		fDacRunning = false;
+		return ERR_FAIL;
+	}
+	cDacSamples = length;
+	if(fDacRunning)
+	{
+		pDac->start();
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Execute a request.
+ *
+ * @param request the request
+ * @param payload the payload of the request
+ * @param response receives the payload of the response
+ * @param responseLength receives the size of the payload of the response
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnExecute(const ZMODDRequest &request, const uint8_t *payload, uint8_t *response, uint32_t &responseLength)
+{
+	const int32_t *args = request.args;
+
+	responseLength = 0;
+	if(request.command != ZMODD_CMD_HELLO && request.command != ZMODD_CMD_GET_STATUS)
+	{
+		bool dacCommand = request.command >= ZMODD_CMD_DAC_SET_GAIN;
+		if((dacCommand && !pDac) || (!dacCommand && !pAdc))
+		{
+			return ERR_FAIL;
+		}
+	}
+	switch(request.command)
+	{
+	case ZMODD_CMD_HELLO:
+	{
+		ZMODDInfo *info = (ZMODDInfo *)response;
+		if(args[0] != ZMODD_VERSION)
+		{
+			return ERR_FAIL;
+		}
+		memset(info, 0, sizeof(ZMODDInfo));
+		info->version = ZMODD_VERSION;
+		strncpy(info->shmName, config.shmName, sizeof(info->shmName) - 1);
+		info->shmSize = pRing ? cbRing : 0;
+		info->hasAdc = pAdc != NULL;
+		info->hasDac = pDac != NULL;
+		responseLength = sizeof(ZMODDInfo);
+		return ERR_SUCCESS;
+	}
+	case ZMODD_CMD_GET_STATUS:
+	{
+		ZMODDStatus *status = (ZMODDStatus *)response;
+		memset(status, 0, sizeof(ZMODDStatus));
+		status->running = __atomic_load_n(&fRunning, __ATOMIC_RELAXED);
+		status->dacRunning = fDacRunning;
+		status->clients = cClients;
+		pthread_mutex_lock(&mtxSettings);
+		status->settings = settings;
+		pthread_mutex_unlock(&mtxSettings);
+		if(pRing)
+		{
+			status->published = __atomic_load_n(&((ZMODDRingHeader *)pRing)->head, __ATOMIC_ACQUIRE);
+			status->overruns = pStream->getOverruns();
+		}
+		status->failures = __atomic_load_n(&cFailures, __ATOMIC_RELAXED);
+		responseLength = sizeof(ZMODDStatus);
+		return ERR_SUCCESS;
+	}
+	case ZMODD_CMD_START:
+		__atomic_store_n(&fRunning, 1, __ATOMIC_RELEASE);
+		return ERR_SUCCESS;
+	case ZMODD_CMD_STOP:
+		__atomic_store_n(&fRunning, 0, __ATOMIC_RELEASE);
+		return ERR_SUCCESS;
+	case ZMODD_CMD_SET_LENGTH:
+	case ZMODD_CMD_SET_TRIGGER:
+	case ZMODD_CMD_SET_GAIN:
+	case ZMODD_CMD_SET_COUPLING:
+		return fnChangeSettings(request);
+	case ZMODD_CMD_DAC_SET_GAIN:
+		if(args[0] < 0 || args[0] > 1)
+		{
+			return ERR_FAIL;
+		}
+		pDac->setGain(args[0], args[1] ? 1 : 0);
+		return ERR_SUCCESS;
+	case ZMODD_CMD_DAC_SET_DIVIDER:
+		pDac->setOutputSampleFrequencyDivider(args[0]);
+		return ERR_SUCCESS;
+	case ZMODD_CMD_DAC_SET_DATA:
+		return fnSetDacData(request, (const int16_t *)payload);
+	case ZMODD_CMD_DAC_START:
+		if(!cDacSamples)
+		{
+			return ERR_FAIL;
+		}
+		pDac->start();
+		fDacRunning = true;
+		return ERR_SUCCESS;
+	case ZMODD_CMD_DAC_STOP:
+		pDac->stop();
+		fDacRunning = false;
+		return ERR_SUCCESS;
+	default:
+		return ERR_FAIL;
+	}
+}
+
+/**
+ * Receive exactly a number of bytes from a client.
+ *
+ * @param fd the socket of the client
+ * @param buf receives the bytes
+ * @param length the number of bytes
+ *
+ * @return 0 on success, any other number on failure or disconnection
+ */
+static int fnReceive(int fd, void *buf, size_t length)
+{
+	size_t received = 0;
+
+	while(received < length)
+	{
+		ssize_t rc = recv(fd, (uint8_t *)buf + received, length - received, 0);
+		if(rc <= 0)
+		{
+			if(rc < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			return ERR_FAIL;
+		}
+		received += rc;
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Serve a request of a client.
+ *
+ * @param fd the socket of the client
+ *
+ * @return 0 on success, any other number if the client must be disconnected
+ */
+static int fnServeClient(int fd)
+{
+	ZMODDRequest request;
+	ZMODDResponse response;
+	uint8_t responsePayload[sizeof(ZMODDInfo) > sizeof(ZMODDStatus) ? sizeof(ZMODDInfo) : sizeof(ZMODDStatus)];
+	uint32_t responseLength;
+
+	if(fnReceive(fd, &request, sizeof(request)) != ERR_SUCCESS || request.length > ZMODD_MAX_PAYLOAD ||
+			fnReceive(fd, rgPayload, request.length) != ERR_SUCCESS)
+	{
+		return ERR_FAIL;
+	}
+	response.status = fnExecute(request, rgPayload, responsePayload, responseLength);
+	response.length = response.status == ERR_SUCCESS ? responseLength : 0;
+	if(send(fd, &response, sizeof(response), MSG_NOSIGNAL) != sizeof(response) ||
+			send(fd, responsePayload, response.length, MSG_NOSIGNAL) != (ssize_t)response.length)
+	{
+		return ERR_FAIL;
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Check whether a socket file is stale, left by a daemon that did not exit cleanly.
+ *
+ * @param addr the address of the socket
+ *
+ * @return true if the file is a socket nobody listens to, false if a daemon serves it,
+ *  if it is not a socket, or if it cannot be checked
+ */
+static bool fnIsStaleSocket(const struct sockaddr_un &addr)
+{
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	bool stale;
+
+	if(fd < 0)
+	{
+		return false;
+	}
+	stale = connect(fd, (const struct sockaddr *)&addr, sizeof(addr)) && errno == ECONNREFUSED;
+	close(fd);
+	return stale;
+}
+
+/**
+ * Open the control socket, replacing a stale socket file. Fails when another daemon
+ * serves the socket, or when the path is not a socket.
+ *
+ * @param path the path of the socket
+ *
+ * @return the socket file descriptor, ERR_FAIL on failure
+ */
+static int fnOpenControlSocket(const char *path)
+{
+	struct sockaddr_un addr;
+	struct stat st;
+	int fd;
+
+	if(strlen(path) >= sizeof(addr.sun_path))
+	{
+		return ERR_FAIL;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	if(!lstat(path, &st))
+	{
+		if(!S_ISSOCK(st.st_mode) || !fnIsStaleSocket(addr))
+		{
+			return ERR_FAIL;
+		}
+		unlink(path);
+	}
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0)
+	{
+		return ERR_FAIL;
+	}
+	if(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(fd, ZMODD_MAX_CLIENTS))
+	{
+		close(fd);
+		return ERR_FAIL;
+	}
+	return fd;
+}
+
+/**
+ * Accept a client on the control socket.
+ *
+ * @param listenFd the control socket
+ */
+static void fnAcceptClient(int listenFd)
+{
+	struct timeval timeout = {ZMODD_CLIENT_TIMEOUT_MS / 1000, (ZMODD_CLIENT_TIMEOUT_MS % 1000) * 1000};
+	int fd = accept(listenFd, NULL, NULL);
+
+	if(fd < 0)
+	{
+		return;
+	}
+	if(cClients == ZMODD_MAX_CLIENTS)
+	{
+		close(fd);
+		return;
+	}
+	// a stalled client must not block the other ones
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	rgClients[cClients++].fd = fd;
+}
+
+/**
+ * Serve the control socket, the clients and the metrics socket until a signal stops the daemon.
+ *
+ * @param listenFd the control socket
+ * @param metricsFd the metrics socket, ERR_FAIL for none
+ */
+static void fnServe(int listenFd, int metricsFd)
+{
+	struct pollfd fds[ZMODD_MAX_CLIENTS + 2];
+
+	while(!fQuit)
+	{
+		uint32_t count = cClients;
+		nfds_t nfds = 0;
+		for(uint32_t i = 0; i < count; i++)
+		{
+			fds[nfds].fd = rgClients[i].fd;
+			fds[nfds++].events = POLLIN;
+		}
+		fds[nfds].fd = listenFd;
+		fds[nfds++].events = POLLIN;
+		if(metricsFd >= 0)
+		{
+			fds[nfds].fd = metricsFd;
+			fds[nfds++].events = POLLIN;
+		}
+		// the signals can be delivered to the other threads, without interrupting poll
+		if(poll(fds, nfds, ZMODD_POLL_MS) < 0)
+		{
+			continue;
+		}
+		// serve the clients, removing the disconnected ones
+		uint32_t kept = 0;
+		for(uint32_t i = 0; i < count; i++)
+		{
+			if((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && fnServeClient(rgClients[i].fd) != ERR_SUCCESS)
+			{
+				close(rgClients[i].fd);
+				continue;
+			}
+			rgClients[kept++] = rgClients[i];
+		}
+		cClients = kept;
+		if(fds[count].revents & POLLIN)
+		{
+			fnAcceptClient(listenFd);
+		}
+		if(metricsFd >= 0 && (fds[count + 1].revents & POLLIN))
+		{
+			const char *names[2];
+			ZMODMetrics metrics[2];
+			uint32_t metricsCount = 0;
+			char text[4096];
+			if(pAdc)
+			{
+				names[metricsCount] = "adc";
+				pAdc->getMetrics(metrics[metricsCount++]);
+			}
+			if(pDac)
+			{
+				names[metricsCount] = "dac";
+				pDac->getMetrics(metrics[metricsCount++]);
+			}
+			int length = fnMetricsFormatPrometheus(text, sizeof(text), names, metrics, metricsCount);
+			if(length >= 0)
+			{
+				fnMetricsServeSocket(metricsFd, text, length);
+			}
+		}
+	}
+}
+
+/**
+ * Print the usage.
+ *
+ * @param name the name of the program
+ */
+static void fnUsage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"      --socket PATH      control socket (default: %s)\n"
+			"      --shm NAME         shared memory ring (default: %s)\n"
+			"      --slots N          acquisitions held by the ring (default: %d)\n"
+			"      --no-adc           do not open the ZmodADC1410\n"
+			"      --no-dac           do not open the ZmodDAC1411\n"
+			"      --adc ADDR,DMA,FLASH,IRQ,DMAIRQ   ZmodADC1410 addresses and interrupts\n"
+			"      --dac ADDR,DMA,FLASH,DMAIRQ       ZmodDAC1411 addresses and interrupt\n"
+			"      --iic ADDR         IIC address of the flashes\n"
+			"      --metrics PATH     serve the metrics of the devices on a Unix socket, in the Prometheus text format\n"
+			"      --rt CPU[,PRIO]    real-time acquisition thread, pinned to CPU (-1 for any), under SCHED_FIFO if PRIO\n",
+			name, ZMODD_DEF_SOCKET, ZMODD_DEF_SHM, ZMODD_DEF_SLOTS);
+}
+
+/**
+ * Parse a comma separated list of numbers.
+ *
+ * @param list the list
+ * @param values receives the numbers
+ * @param maxCount the maximum number of numbers
+ *
+ * @return the number of numbers, 0 on error
+ */
+static uint32_t fnParseList(const char *list, uint64_t *values, uint32_t maxCount)
+{
+	uint32_t count = 0;
+	char *end;
+
+	while(*list && count < maxCount)
+	{
+		values[count++] = strtoull(list, &end, 0);
+		if(end == list || (*end && *end != ','))
+		{
+			return 0;
+		}
+		list = *end ? end + 1 : end;
+	}
+	return *list ? 0 : count;
+}
+
+/**
+ * Parse the command line into the configuration.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnParseArgs(int argc, char **argv)
+{
+	static const struct option options[] = {
+		{"socket", required_argument, NULL, 'S'},
+		{"shm", required_argument, NULL, 'm'},
+		{"slots", required_argument, NULL, 'n'},
+		{"no-adc", no_argument, NULL, 'A'},
+		{"no-dac", no_argument, NULL, 'D'},
+		{"adc", required_argument, NULL, 'a'},
+		{"dac", required_argument, NULL, 'd'},
+		{"iic", required_argument, NULL, 'i'},
+		{"metrics", required_argument, NULL, 'p'},
+		{"rt", required_argument, NULL, 'r'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+	uint64_t values[5];
+	int opt;
+
+	while((opt = getopt_long(argc, argv, "h", options, NULL)) != -1)
+	{
+		switch(opt)
+		{
+		case 'S':
+			config.socketPath = optarg;
+			break;
+		case 'm':
+			if(optarg[0] != '/' || strlen(optarg) >= ZMODD_SHM_NAME_LEN)
+			{
+				return ERR_FAIL;
+			}
+			config.shmName = optarg;
+			break;
+		case 'n':
+			config.slots = strtoul(optarg, NULL, 0);
+			if(config.slots < 2)
+			{
+				return ERR_FAIL;
+			}
+			break;
+		case 'A':
+			config.adc = false;
+			break;
+		case 'D':
+			config.dac = false;
+			break;
+		case 'a':
+			if(fnParseList(optarg, values, 5) != 5)
+			{
+				return ERR_FAIL;
+			}
+			config.adcAddr = values[0];
+			config.adcDmaAddr = values[1];
+			config.adcFlashAddr = values[2];
+			config.adcIrq = (int)values[3];
+			config.adcDmaIrq = (int)values[4];
+			break;
+		case 'd':
+			if(fnParseList(optarg, values, 4) != 4)
+			{
+				return ERR_FAIL;
+			}
+			config.dacAddr = values[0];
+			config.dacDmaAddr = values[1];
+			config.dacFlashAddr = values[2];
+			config.dacDmaIrq = (int)values[3];
+			break;
+		case 'i':
+			config.iicAddr = strtoull(optarg, NULL, 0);
+			break;
+		case 'p':
+			config.metricsPath = optarg;
+			break;
+		case 'r':
+		{
+			char *end;
+			config.rt = true;
+			config.rtConfig.cpu = (int)strtol(optarg, &end, 0);
+			if(end == optarg || (*end && *end != ','))
+			{
+				return ERR_FAIL;
+			}
+			if(*end)
+			{
+				config.rtConfig.priority = (int)strtol(end + 1, NULL, 0);
+			}
+			break;
+		}
+		default:
+			return ERR_FAIL;
+		}
+	}
+	return optind == argc && (config.adc || config.dac) ? ERR_SUCCESS : ERR_FAIL;
+}
+
+/**
+ * Open the ADC, its stream and the ring, and start the acquisition and ring writer threads.
+ *
+ * @param acquisitionThread receives the acquisition thread
+ * @param writerThread receives the ring writer thread
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnStartAdc(pthread_t &acquisitionThread, pthread_t &writerThread)
+{
+	size_t length = ZMODADC1410_MAX_BUFFER_LEN;
+
+	pAdc = new ZMODADC1410(config.adcAddr, config.adcDmaAddr, config.iicAddr, config.adcFlashAddr,
+			config.adcIrq, config.adcDmaIrq);
+	pStream = new ADCStream(pAdc, length, ZMODD_STREAM_BUFFERS);
+	if(!pStream->isValid())
+	{
+		return ERR_FAIL;
+	}
+	iConsumer = pStream->addConsumer(ADC_STREAM_BLOCK, ZMODD_STREAM_BUFFERS);
+	if(iConsumer == ERR_FAIL || fnRingCreate(config.shmName, config.slots, length) != ERR_SUCCESS)
+	{
+		return ERR_FAIL;
+	}
+	// immediate acquisitions of the whole buffer, with the gain and coupling of the ADC
+	memset(&settings, 0, sizeof(settings));
+	for(uint8_t ch = 0; ch < 2; ch++)
+	{
+		settings.gain[ch] = pAdc->getGain(ch);
+		settings.coupling[ch] = pAdc->getCoupling(ch);
+	}
+	settings.trigMode = 1;
+	settings.length = length;
+	if(pthread_create(&writerThread, NULL, fnRingWriterThread, NULL))
+	{
+		return ERR_FAIL;
+	}
+	if(pthread_create(&acquisitionThread, NULL, fnAcquisitionThread, NULL))
+	{
+		__atomic_store_n(&fStop, 1, __ATOMIC_RELEASE);
+		pthread_join(writerThread, NULL);
+		return ERR_FAIL;
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Stop the acquisition and ring writer threads. The acquisition thread can wait for a trigger
+ * forever: it is then abandoned, and so is the ADC.
+ *
+ * @param acquisitionThread the acquisition thread
+ * @param writerThread the ring writer thread
+ *
+ * @return true if the threads stopped, and the ADC can be deleted
+ */
+static bool fnStopAdc(pthread_t acquisitionThread, pthread_t writerThread)
+{
+	__atomic_store_n(&fRunning, 0, __ATOMIC_RELEASE);
+	__atomic_store_n(&fStop, 1, __ATOMIC_RELEASE);
+	for(uint32_t ms = 0; ms < ZMODD_EXIT_TIMEOUT_MS && !__atomic_load_n(&fAcquisitionDone, __ATOMIC_ACQUIRE); ms++)
+	{
+		usleep(1000);
+	}
+	pthread_join(writerThread, NULL);
+	if(!__atomic_load_n(&fAcquisitionDone, __ATOMIC_ACQUIRE))
+	{
+		fprintf(stderr, "the acquisition is waiting for a trigger, abandoned\n");
+		return false;
+	}
+	pthread_join(acquisitionThread, NULL);
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	pthread_t acquisitionThread;
+	pthread_t writerThread;
+	bool adcStarted = false;
+	int listenFd;
+	int metricsFd = ERR_FAIL;
+	int rc = 1;
+
+	if(fnParseArgs(argc, argv) != ERR_SUCCESS)
+	{
+		fnUsage(argv[0]);
+		return 1;
+	}
+	signal(SIGINT, fnOnSignal);
+	signal(SIGTERM, fnOnSignal);
+	signal(SIGPIPE, SIG_IGN);
+
+	listenFd = fnOpenControlSocket(config.socketPath);
+	if(listenFd < 0)
+	{
+		fprintf(stderr, "cannot open the control socket %s, or another zmodd serves it\n", config.socketPath);
+		return 1;
+	}
+	if(config.metricsPath)
+	{
+		metricsFd = fnMetricsOpenSocket(config.metricsPath);
+		if(metricsFd < 0)
+		{
+			fprintf(stderr, "cannot open the metrics socket %s\n", config.metricsPath);
+			goto exit;
+		}
+	}
+	if(config.adc)
+	{
+		if(fnStartAdc(acquisitionThread, writerThread) != ERR_SUCCESS)
+		{
+			fprintf(stderr, "cannot open the ZmodADC1410 and the ring %s\n", config.shmName);
+			goto exit;
+		}
+		adcStarted = true;
+	}
+	if(config.dac)
+	{
+		size_t length = ZmodDAC1411_MAX_BUFFER_LEN;
+		pDac = new ZMODDAC1411(config.dacAddr, config.dacDmaAddr, config.iicAddr, config.dacFlashAddr,
+				config.dacDmaIrq);
+		pDacBuffer = pDac->allocChannelsBuffer(length);
+		if(!pDacBuffer)
+		{
+			fprintf(stderr, "cannot open the ZmodDAC1411\n");
+			goto exit;
+		}
+	}
+
+	fnServe(listenFd, metricsFd);
+	rc = 0;
+
+exit:
+	for(uint32_t i = 0; i < cClients; i++)
+	{
+		close(rgClients[i].fd);
+	}
+	close(listenFd);
+	unlink(config.socketPath);
+	if(metricsFd >= 0)
+	{
+		fnMetricsCloseSocket(metricsFd, config.metricsPath);
+	}
+	if(pDac)
+	{
+		if(fDacRunning)
+		{
+			pDac->stop();
+		}
+		if(pDacBuffer)
+		{
+			pDac->freeChannelsBuffer(pDacBuffer, ZmodDAC1411_MAX_BUFFER_LEN);
+		}
+		delete pDac;
+	}
+	if(adcStarted && !fnStopAdc(acquisitionThread, writerThread))
+	{
+		// the acquisition thread still uses the ADC and its stream
+		fnRingDestroy(config.shmName);
+		return rc;
+	}
+	delete pStream;
+	delete pAdc;
+	fnRingDestroy(config.shmName);
+	return rc;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file zmodd.h
+ * @date 16 Oct 2026
+ * @brief Protocol of the Zmod access daemon: control messages and layout of the shared acquisition ring.
+ *
+ * The daemon (zmodd.cpp) owns the ZMODADC1410 and ZMODDAC1411 instances, whose DMA devices
+ * can only be opened by one process. The clients (see zmodclient.h) send commands on a Unix
+ * stream socket, and read the acquisitions from a POSIX shared memory ring, mapped read-only.
+ *
+ * Control: each request is a ZMODDRequest, followed by its payload (the samples of
+ * ZMODD_CMD_DAC_SET_DATA); each response is a ZMODDResponse, followed by its payload
+ * (ZMODDInfo for ZMODD_CMD_HELLO, ZMODDStatus for ZMODD_CMD_GET_STATUS).
+ *
+ * Data: the ring starts with a ZMODDRingHeader, followed by slotCount slots of slotSize
+ * bytes, each a ZMODDSlot followed, at dataOffset, by the samples of the acquisition.
+ * Acquisition n (counting from 0) is written to slot n % slotCount, and head is n + 1
+ * once it is complete. Each slot is protected by a sequence lock: the daemon makes lock
+ * odd while it writes the slot, and the readers check that lock is even and unchanged
+ * across their read, so the daemon never waits for the clients, and a client reading
+ * too slowly sees its read fail instead of torn data.
+ */
+
+#ifndef ZMODD_H_
+#define ZMODD_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "../ZmodADC1410/acquisitionblock.h"
+#include "../ZmodDAC1411/zmoddac1411.h"
+
+#define ZMODD_VERSION			1				///< version of the protocol
+#define ZMODD_RING_MAGIC		0x5A4D4F44		///< "ZMOD", first word of the ring
+#define ZMODD_CACHE_LINE		64				///< alignment of the ring slots and samples
+#define ZMODD_SHM_NAME_LEN		64				///< maximum length of the shared memory name, including the terminator
+#define ZMODD_DEF_SOCKET		"/tmp/zmodd.sock"	///< default path of the control socket
+#define ZMODD_DEF_SHM			"/zmodd"		///< default name of the shared memory ring
+#define ZMODD_MAX_PAYLOAD		(2 * ZmodDAC1411_MAX_BUFFER_LEN * sizeof(int16_t))	///< maximum size of a request payload
+
+/**
+ * Commands of the control socket. The arguments are in ZMODDRequest::args.
+ */
+enum zmodd_command {
+	ZMODD_CMD_HELLO, ///< check the protocol version (args[0]), get the ZMODDInfo of the ring
+	ZMODD_CMD_GET_STATUS, ///< get the ZMODDStatus
+	ZMODD_CMD_START, ///< start the acquisitions
+	ZMODD_CMD_STOP, ///< stop the acquisitions
+	ZMODD_CMD_SET_LENGTH, ///< set the number of samples of the acquisitions (args[0]), at least the trigger window
+	ZMODD_CMD_SET_TRIGGER, ///< set the trigger (args: channel, mode, level, edge, window)
+	ZMODD_CMD_SET_GAIN, ///< set the gain of an ADC channel (args: channel, gain)
+	ZMODD_CMD_SET_COUPLING, ///< set the coupling of an ADC channel (args: channel, coupling)
+	ZMODD_CMD_DAC_SET_GAIN, ///< set the gain of a DAC channel (args: channel, gain)
+	ZMODD_CMD_DAC_SET_DIVIDER, ///< set the DAC output sample frequency divider (args[0])
+	ZMODD_CMD_DAC_SET_DATA, ///< load the DAC samples: payload of args[0] signed raw values of channel 1, then of channel 2
+	ZMODD_CMD_DAC_START, ///< start the DAC output
+	ZMODD_CMD_DAC_STOP, ///< stop the DAC output
+	ZMODD_CMD_COUNT ///< number of commands
+};
+
+/**
+ * Struct containing a request of the control socket.
+ */
+typedef struct _ZMODDRequest {
+	uint32_t command; ///< zmodd_command
+	uint32_t length; ///< size of the payload following the request, in bytes
+	int32_t args[5]; ///< arguments of the command
+} ZMODDRequest;
+
+/**
+ * Struct containing a response of the control socket.
+ */
+typedef struct _ZMODDResponse {
+	int32_t status; ///< ERR_SUCCESS, or ERR_FAIL if the command failed or is not supported
+	uint32_t length; ///< size of the payload following the response, in bytes
+} ZMODDResponse;
+
+/**
+ * Struct containing the description of the shared memory ring, the response to ZMODD_CMD_HELLO.
+ */
+typedef struct _ZMODDInfo {
+	uint32_t version; ///< ZMODD_VERSION
+	char shmName[ZMODD_SHM_NAME_LEN]; ///< name of the shared memory ring, for shm_open
+	uint64_t shmSize; ///< size of the ring, in bytes
+	uint8_t hasAdc; ///< whether the daemon owns a ZMODADC1410
+	uint8_t hasDac; ///< whether the daemon owns a ZMODDAC1411
+} ZMODDInfo;
+
+/**
+ * Struct containing the state of the daemon, the response to ZMODD_CMD_GET_STATUS.
+ */
+typedef struct _ZMODDStatus {
+	uint8_t running; ///< whether the acquisitions are running
+	uint8_t dacRunning; ///< whether the DAC output is running
+	uint32_t clients; ///< number of connected clients
+	AcquisitionInfo settings; ///< settings of the next acquisitions (gain, coupling, trigger, length)
+	uint64_t published; ///< number of acquisitions published to the ring
+	uint64_t overruns; ///< number of acquisitions not done because the ring writer held all the DMA buffers
+	uint64_t failures; ///< number of failed acquisitions
+} ZMODDStatus;
+
+/**
+ * Struct containing the header of the shared memory ring.
+ */
+typedef struct _ZMODDRingHeader {
+	uint32_t magic; ///< ZMODD_RING_MAGIC
+	uint32_t version; ///< ZMODD_VERSION
+	uint32_t slotCount; ///< number of slots
+	uint32_t slotSize; ///< size of a slot, in bytes, a multiple of ZMODD_CACHE_LINE
+	uint32_t dataOffset; ///< offset of the samples in a slot, in bytes
+	uint32_t maxLength; ///< maximum number of samples of a slot
+	uint64_t head; ///< number of acquisitions published, written by the daemon only
+} ZMODDRingHeader;
+
+/**
+ * Struct containing the header of a slot of the shared memory ring.
+ */
+typedef struct _ZMODDSlot {
+	uint64_t lock; ///< sequence lock, odd while the daemon writes the slot
+	uint64_t sequence; ///< number of the acquisition held by the slot
+	uint64_t streamSequence; ///< number of the acquisition in the daemon stream, gaps show the overruns
+	AcquisitionInfo info; ///< settings and times of the acquisition, info.length is the number of samples
+} ZMODDSlot;
+
+/**
+ * Round a size up to a multiple of the cache line.
+ *
+ * @param size the size
+ *
+ * @return the rounded size
+ */
+static inline size_t fnZmoddAlign(size_t size)
+{
+	return (size + ZMODD_CACHE_LINE - 1) & ~(size_t)(ZMODD_CACHE_LINE - 1);
+}
+
+#endif /* ZMODD_H_ */
@@ -0,0 +1,407 @@
+/**
+ * @file regreplay.cpp
+ * @date 16 Oct 2026
+ * @brief Offline replay and analysis of the device access traces recorded by the driver.
+ *
+ * A trace is recorded by an application built with ZMOD_REGTRACE, between fnRegTraceStart and
+ * fnRegTraceSave (see Zmod/regtrace.h). The tool replays the register accesses, DMA transfers
+ * and flash accesses of the trace against the fake platform, and reports as JSON, for each
+ * high-level call (setTrigger, readUserCalib, sendCommands...) and for the accesses made
+ * outside of any call ("none"):
+ *  - the number of calls and register reads and writes
+ *  - the redundant reads, reading a value already known from the last access to the register
+ *  - the read-modify-writes, a read immediately followed by a write of the same register,
+ *    and how many of them read a known value (the read could be avoided by a shadow register)
+ *  - the redundant writes, writing the value the register already holds
+ *  - the DMA transfers and flash accesses
+ *  - the time spent in the calls when recorded, and when replayed on the fake platform
+ * The accesses are counted for the innermost call they belong to. The volatile registers
+ * (status, FIFOs), whose value can change without a write, are never redundant.
+ *
+ * Built with:
+ *
+ *   g++ -std=c++11 -O2 -DFAKE_APP -o regreplay tools/regreplay.cpp Zmod/regtrace.cpp Zmod/zmod.cpp Zmod/metrics.cpp Zmod/rt.cpp \
+ *       Zmod/fake/reg/reg.c Zmod/fake/dma/dma.c Zmod/fake/flash/flash.c Zmod/fake/timer/timer.c
+ *
+ * Run with: ./regreplay [--volatile LIST] trace.bin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../Zmod/zmod.h"
+#include "../Zmod/reg.h"
+#include "../Zmod/dma.h"
+#include "../Zmod/flash.h"
+#include "../Zmod/timer.h"
+#include "../Zmod/regtrace.h"
+
+#define REPLAY_REG_COUNT		64		///< number of registers of a ZMOD device
+#define REPLAY_MAX_DEPTH		16		///< maximum nesting of high-level calls
+#define REPLAY_NONE				ZMOD_REGTRACE_API_COUNT	///< statistics index of the accesses outside of any call
+#define REPLAY_MAX_TRANSFER		0x4000000	///< maximum DMA transfer or flash access size
+
+/**
+ * Struct containing the state of a device of the trace.
+ */
+typedef struct _replay_device {
+	bool defined; ///< whether the device was introduced by the trace
+	uint8_t kind; ///< zmod_regtrace_device
+	uintptr_t handle; ///< handle of the fake device
+	bool known[REPLAY_REG_COUNT]; ///< [register] whether the value of the register is known
+	uint32_t values[REPLAY_REG_COUNT]; ///< [register] value of the register, when known
+	int lastRead; ///< register read by the last register access, -1 if it was a write
+	bool lastReadKnown; ///< whether the last read was redundant
+} ReplayDevice;
+
+/**
+ * Struct containing the statistics of a high-level call.
+ */
+typedef struct _replay_stats {
+	uint64_t calls; ///< number of calls
+	uint64_t regReads; ///< register reads
+	uint64_t regWrites; ///< register writes
+	uint64_t redundantReads; ///< reads of a known value
+	uint64_t rmw; ///< read-modify-writes
+	uint64_t rmwKnown; ///< read-modify-writes reading a known value
+	uint64_t redundantWrites; ///< writes of the value the register holds
+	uint64_t dmaTransfers; ///< DMA transfers
+	uint64_t flashAccesses; ///< flash reads and writes
+	uint64_t recordedNs; ///< time spent in the calls, when recorded
+	uint64_t replayNs; ///< time spent in the calls, when replayed
+} ReplayStats;
+
+/**
+ * Struct containing a high-level call in progress.
+ */
+typedef struct _replay_call {
+	uint32_t api; ///< zmod_regtrace_api
+	uint64_t recordedStart; ///< recorded time of the begin
+	uint64_t replayStart; ///< replay time of the begin
+} ReplayCall;
+
+static ReplayDevice rgDevices[ZMOD_REGTRACE_MAX_DEVICES]; ///< [device index] devices
+static ReplayStats rgStats[ZMOD_REGTRACE_API_COUNT + 1]; ///< [api] statistics, REPLAY_NONE outside of any call
+static ReplayCall rgCalls[REPLAY_MAX_DEPTH]; ///< stack of the calls in progress
+static uint32_t cCalls = 0; ///< depth of the stack of calls
+static bool rgVolatile[REPLAY_REG_COUNT]; ///< [register] whether the register is volatile
+static uint32_t *pScratch = NULL; ///< buffer of the replayed DMA transfers and flash accesses
+
+/**
+ * Get the statistics the current access is counted for.
+ *
+ * @return the statistics of the innermost call in progress, or of REPLAY_NONE
+ */
+static ReplayStats &fnCurrentStats()
+{
+	return rgStats[cCalls ? rgCalls[cCalls - 1].api : (uint32_t)REPLAY_NONE];
+}
+
+/**
+ * Introduce a device of the trace, creating the matching fake device.
+ *
+ * @param index the index of the device
+ * @param kind the zmod_regtrace_device
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnDefineDevice(uint8_t index, uint8_t kind)
+{
+	ReplayDevice &device = rgDevices[index];
+
+	if(device.defined)
+	{
+		return ERR_SUCCESS;
+	}
+	switch(kind)
+	{
+	case ZMOD_REGTRACE_DEV_ZMOD:
+		device.handle = fnInitZmod(index, 0, NULL, NULL);
+		break;
+	case ZMOD_REGTRACE_DEV_DMA:
+		device.handle = fnInitDMA(index, DMA_DIRECTION_RX, 0);
+		break;
+	case ZMOD_REGTRACE_DEV_FLASH:
+		device.handle = fnInitFlash(index, 0);
+		break;
+	default:
+		return ERR_FAIL;
+	}
+	device.defined = device.handle != 0;
+	device.kind = kind;
+	device.lastRead = -1;
+	return device.defined ? ERR_SUCCESS : ERR_FAIL;
+}
+
+/**
+ * Replay and analyze a register access.
+ *
+ * @param device the ZMOD device
+ * @param write whether the access is a write
+ * @param addr the register offset
+ * @param value the value read or written
+ */
+static void fnReplayRegister(ReplayDevice &device, bool write, uint16_t addr, uint32_t value)
+{
+	ReplayStats &stats = fnCurrentStats();
+	uint32_t reg = addr / 4;
+
+	if(reg >= REPLAY_REG_COUNT)
+	{
+		return;
+	}
+	bool known = !rgVolatile[reg] && device.known[reg] && device.values[reg] == value;
+	if(write)
+	{
+		fnWriteReg(device.handle, addr, value);
+		stats.regWrites++;
+		if(known)
+		{
+			stats.redundantWrites++;
+		}
+		if(device.lastRead == (int)reg)
+		{
+			stats.rmw++;
+			if(device.lastReadKnown)
+			{
+				stats.rmwKnown++;
+			}
+		}
+		device.lastRead = -1;
+	}
+	else
+	{
+		fnReadReg(device.handle, addr);
+		stats.regReads++;
+		if(known)
+		{
+			stats.redundantReads++;
+		}
+		device.lastRead = reg;
+		device.lastReadKnown = known;
+	}
+	device.known[reg] = true;
+	device.values[reg] = value;
+}
+
+/**
+ * Replay and analyze a trace record.
+ *
+ * @param record the record
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnReplayRecord(const ZMODRegTraceRecord &record)
+{
+	if(record.device >= ZMOD_REGTRACE_MAX_DEVICES)
+	{
+		// the recording ran out of device indexes
+		return ERR_SUCCESS;
+	}
+	if(record.type == ZMOD_REGTRACE_DEVICE)
+	{
+		return fnDefineDevice(record.device, record.addr);
+	}
+
+	ReplayDevice &device = rgDevices[record.device];
+	if(!device.defined)
+	{
+		return ERR_FAIL;
+	}
+	switch(record.type)
+	{
+	case ZMOD_REGTRACE_REG_WRITE:
+	case ZMOD_REGTRACE_REG_READ:
+		fnReplayRegister(device, record.type == ZMOD_REGTRACE_REG_WRITE, record.addr, record.value);
+		break;
+	case ZMOD_REGTRACE_DMA_START:
+		fnOneWayDMATransfer(device.handle, pScratch,
+				record.value < REPLAY_MAX_TRANSFER ? record.value : REPLAY_MAX_TRANSFER);
+		fnCurrentStats().dmaTransfers++;
+		break;
+	case ZMOD_REGTRACE_DMA_COMPLETE:
+		while(!fnIsDMATransferComplete(device.handle)) {}
+		break;
+	case ZMOD_REGTRACE_FLASH_READ:
+		if(record.value > REPLAY_MAX_TRANSFER)
+		{
+			// larger than the scratch buffer, not a valid flash access
+			return ERR_FAIL;
+		}
+		fnReadFlash(device.handle, record.addr, (uint8_t *)pScratch, record.value);
+		fnCurrentStats().flashAccesses++;
+		break;
+	case ZMOD_REGTRACE_FLASH_WRITE:
+		if(record.value > REPLAY_MAX_TRANSFER)
+		{
+			return ERR_FAIL;
+		}
+		fnWriteFlash(device.handle, record.addr, (uint8_t *)pScratch, record.value);
+		fnCurrentStats().flashAccesses++;
+		break;
+	case ZMOD_REGTRACE_API_BEGIN:
+		if(record.value >= ZMOD_REGTRACE_API_COUNT || cCalls >= REPLAY_MAX_DEPTH)
+		{
+			return ERR_FAIL;
+		}
+		rgCalls[cCalls].api = record.value;
+		rgCalls[cCalls].recordedStart = record.timeNs;
+		rgCalls[cCalls].replayStart = fnGetTimeNs();
+		cCalls++;
+		rgStats[record.value].calls++;
+		break;
+	case ZMOD_REGTRACE_API_END:
+		if(!cCalls || rgCalls[cCalls - 1].api != record.value)
+		{
+			return ERR_FAIL;
+		}
+		cCalls--;
+		rgStats[record.value].recordedNs += record.timeNs - rgCalls[cCalls].recordedStart;
+		rgStats[record.value].replayNs += fnGetTimeNs() - rgCalls[cCalls].replayStart;
+		break;
+	default:
+		return ERR_FAIL;
+	}
+	return ERR_SUCCESS;
+}
+
+/**
+ * Print the statistics of a high-level call as a JSON object.
+ *
+ * @param name the name of the call
+ * @param stats the statistics
+ * @param first whether it is the first object of the list
+ */
+static void fnPrintStats(const char *name, const ReplayStats &stats, bool first)
+{
+	printf("%s\n    {\"name\":\"%s\",\"calls\":%llu,\"reg_reads\":%llu,\"reg_writes\":%llu,"
+			"\"redundant_reads\":%llu,\"rmw\":%llu,\"rmw_known\":%llu,\"redundant_writes\":%llu,"
+			"\"dma_transfers\":%llu,\"flash_accesses\":%llu,\"recorded_ns\":%llu,\"replay_ns\":%llu}",
+			first ? "" : ",", name, (unsigned long long)stats.calls,
+			(unsigned long long)stats.regReads, (unsigned long long)stats.regWrites,
+			(unsigned long long)stats.redundantReads, (unsigned long long)stats.rmw,
+			(unsigned long long)stats.rmwKnown, (unsigned long long)stats.redundantWrites,
+			(unsigned long long)stats.dmaTransfers, (unsigned long long)stats.flashAccesses,
+			(unsigned long long)stats.recordedNs, (unsigned long long)stats.replayNs);
+}
+
+/**
+ * Parse the comma separated list of the volatile register offsets.
+ *
+ * @param list the list
+ *
+ * @return 0 on success, any other number on failure
+ */
+static int fnParseVolatile(const char *list)
+{
+	char *end;
+
+	memset(rgVolatile, 0, sizeof(rgVolatile));
+	while(*list)
+	{
+		unsigned long addr = strtoul(list, &end, 0);
+		if(end == list || (*end && *end != ',') || addr / 4 >= REPLAY_REG_COUNT)
+		{
+			return ERR_FAIL;
+		}
+		rgVolatile[addr / 4] = true;
+		list = *end ? end + 1 : end;
+	}
+	return ERR_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	ZMODRegTraceHeader header;
+	ZMODRegTraceRecord record;
+	const char *path = NULL;
+	FILE *file;
+	uint32_t errors = 0;
+
+	// status register and command FIFOs
+	rgVolatile[ZMOD_REG_ADDR_SR / 4] = true;
+	rgVolatile[ZMOD_REG_ADDR_CMD_TX / 4] = true;
+	rgVolatile[ZMOD_REG_ADDR_CMD_RX / 4] = true;
+	for(int i = 1; i < argc; i++)
+	{
+		if(!strcmp(argv[i], "--volatile") && i + 1 < argc)
+		{
+			if(fnParseVolatile(argv[++i]) != ERR_SUCCESS)
+			{
+				fprintf(stderr, "invalid register list: %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if(!path && argv[i][0] != '-')
+		{
+			path = argv[i];
+		}
+		else
+		{
+			path = NULL;
+			break;
+		}
+	}
+	if(!path)
+	{
+		fprintf(stderr, "usage: %s [--volatile REG,REG...] trace.bin\n"
+				"  --volatile   offsets of the registers that change without a write (default: 0x04,0x0C,0x10)\n",
+				argv[0]);
+		return 1;
+	}
+
+	file = fopen(path, "rb");
+	if(!file)
+	{
+		fprintf(stderr, "cannot open %s\n", path);
+		return 1;
+	}
+	if(fread(&header, sizeof(header), 1, file) != 1 || header.magic != ZMOD_REGTRACE_MAGIC ||
+			header.version != ZMOD_REGTRACE_VERSION || header.recordSize != sizeof(ZMODRegTraceRecord))
+	{
+		fprintf(stderr, "%s is not a supported trace\n", path);
+		fclose(file);
+		return 1;
+	}
+	pScratch = (uint32_t *)malloc(REPLAY_MAX_TRANSFER);
+	if(!pScratch)
+	{
+		fprintf(stderr, "cannot allocate the replay buffer\n");
+		fclose(file);
+		return 1;
+	}
+
+	uint64_t start = fnGetTimeNs();
+	uint64_t firstTime = 0, lastTime = 0;
+	uint32_t count;
+	for(count = 0; count < header.count && fread(&record, sizeof(record), 1, file) == 1; count++)
+	{
+		if(!count)
+		{
+			firstTime = record.timeNs;
+		}
+		lastTime = record.timeNs;
+		if(fnReplayRecord(record) != ERR_SUCCESS)
+		{
+			errors++;
+		}
+	}
+	uint64_t replayNs = fnGetTimeNs() - start;
+	fclose(file);
+
+	printf("{\"trace\":\"%s\",\"records\":%u,\"truncated\":%s,\"dropped\":%u,\"errors\":%u,"
+			"\"recorded_ns\":%llu,\"replay_ns\":%llu,\"calls\":[",
+			path, count, count < header.count ? "true" : "false", header.dropped, errors,
+			(unsigned long long)(lastTime - firstTime), (unsigned long long)replayNs);
+	for(uint32_t api = 0; api < ZMOD_REGTRACE_API_COUNT; api++)
+	{
+		fnPrintStats(fnRegTraceApiName((enum zmod_regtrace_api)api), rgStats[api], api == 0);
+	}
+	fnPrintStats("none", rgStats[REPLAY_NONE], false);
+	printf("\n]}\n");
+
+	free(pScratch);
+	return 0;
+}